@@ -0,0 +1,398 @@
+/**
+ * \file bench.c
+ * \brief Mesures de performance des chemins critiques (registre, scores, combats)
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#include "bench.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/* Compteurs d'allocations : le bench est lié avec -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc */
+static long nbAllocations = 0;
+static long octetsAlloues = 0;
+
+void *__real_malloc(size_t taille);
+void *__real_calloc(size_t nb, size_t taille);
+void *__real_realloc(void *ancien, size_t taille);
+
+void *__wrap_malloc(size_t taille){
+    __atomic_add_fetch(&nbAllocations, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&octetsAlloues, (long)taille, __ATOMIC_RELAXED);
+    return __real_malloc(taille);
+}
+
+void *__wrap_calloc(size_t nb, size_t taille){
+    __atomic_add_fetch(&nbAllocations, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&octetsAlloues, (long)(nb * taille), __ATOMIC_RELAXED);
+    return __real_calloc(nb, taille);
+}
+
+void *__wrap_realloc(void *ancien, size_t taille){
+    __atomic_add_fetch(&nbAllocations, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&octetsAlloues, (long)taille, __ATOMIC_RELAXED);
+    return __real_realloc(ancien, taille);
+}
+
+/* Descripteur de la sortie standard pendant qu'elle est coupée */
+static int sortieSauvee = -1;
+
+/* Noms des monstres des vagues synthétiques */
+static const char *nomsMonstres[] = {"Chouin-Chouin", "Lutin_Cordial", "Chimere", "Petite_Pustule", "Dragonus"};
+
+// ----------------------------------------------- Partie Mesure -----------------------------------------------
+
+ResultatBench creerResultat(const char *nom, long taille){
+    ResultatBench resultat;
+    memset(&resultat, 0, sizeof(resultat));
+    resultat.nom = nom;
+    resultat.taille = taille;
+    return resultat;
+}
+
+void demarrerMesure(ResultatBench *resultat){
+    resultat->allocationsDebut = __atomic_load_n(&nbAllocations, __ATOMIC_RELAXED);
+    resultat->octetsDebut = __atomic_load_n(&octetsAlloues, __ATOMIC_RELAXED);
+    clock_gettime(CLOCK_MONOTONIC, &resultat->debut);
+}
+
+void arreterMesure(ResultatBench *resultat){
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    resultat->secondes += (fin.tv_sec - resultat->debut.tv_sec) + (fin.tv_nsec - resultat->debut.tv_nsec) / 1e9;
+    resultat->nbAllocations += __atomic_load_n(&nbAllocations, __ATOMIC_RELAXED) - resultat->allocationsDebut;
+    resultat->octetsAlloues += __atomic_load_n(&octetsAlloues, __ATOMIC_RELAXED) - resultat->octetsDebut;
+}
+
+void couperSortie(void){
+    fflush(stdout);
+    sortieSauvee = dup(STDOUT_FILENO);
+    int nul = open("/dev/null", O_WRONLY);
+    if (sortieSauvee == -1 || nul == -1) {
+        perror("Impossible de couper la sortie standard");
+        exit(EXIT_FAILURE);
+    }
+    dup2(nul, STDOUT_FILENO);
+    close(nul);
+}
+
+void retablirSortie(void){
+    fflush(stdout);
+    dup2(sortieSauvee, STDOUT_FILENO);
+    close(sortieSauvee);
+    sortieSauvee = -1;
+}
+
+/* Temps moyen d'une opération en nanosecondes */
+static double nsParOperation(const ResultatBench *resultat){
+    return (resultat->nbOperations > 0) ? resultat->secondes * 1e9 / resultat->nbOperations : 0.0;
+}
+
+void afficherResultat(const ResultatBench *resultat){
+    double ops = (resultat->nbOperations > 0) ? (double)resultat->nbOperations : 1.0;
+    printf("%-28s %10ld %14.1f ns/op %14.0f ops/s %10.2f allocs/op %12.1f octets/op\n", resultat->nom, resultat->taille,
+           nsParOperation(resultat), (resultat->secondes > 0) ? resultat->nbOperations / resultat->secondes : 0.0,
+           resultat->nbAllocations / ops, resultat->octetsAlloues / ops);
+}
+
+void ecrireEnteteResultats(FILE *fichier){
+    fprintf(fichier, "nom,taille,operations,secondes,ns_par_op,ops_par_s,allocations_par_op,octets_par_op\n");
+}
+
+void ecrireResultat(FILE *fichier, const ResultatBench *resultat){
+    double ops = (resultat->nbOperations > 0) ? (double)resultat->nbOperations : 1.0;
+    fprintf(fichier, "%s,%ld,%ld,%.6f,%.2f,%.2f,%.4f,%.2f\n", resultat->nom, resultat->taille, resultat->nbOperations,
+            resultat->secondes, nsParOperation(resultat), (resultat->secondes > 0) ? resultat->nbOperations / resultat->secondes : 0.0,
+            resultat->nbAllocations / ops, resultat->octetsAlloues / ops);
+}
+
+// ----------------------------------------------- Partie Données synthétiques -----------------------------------------------
+
+/* Générateur xorshift32 : les données ne dépendent que de la graine */
+static unsigned int aleatoire(unsigned int *etat){
+    unsigned int x = *etat;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *etat = x;
+    return x;
+}
+
+/* Pseudo distinct pour chaque indice, dans un ordre sans rapport avec l'ordre alphabétique */
+static void pseudoSynthetique(char *pseudo, long i){
+    sprintf(pseudo, "ch%08x", (unsigned int)(i * 2654435761u));
+}
+
+/* Tableau de nbChevaliers chevaliers ayant chacun nbScores scores entre 0 et 9999 */
+static TableauChevaliers *tableauSynthetique(long nbChevaliers, int nbScores, unsigned int *graine){
+    TableauChevaliers *tableau = creerTableauChevaliers((int)nbChevaliers);
+    char pseudo[LONGUEUR_MAX_PSEUDO + 1];
+
+    for (long i = 0; i < nbChevaliers; i++) {
+        pseudoSynthetique(pseudo, i);
+        Chevalier chevalier = creerChevalier(pseudo);
+        for (int j = 0; j < nbScores; j++) {
+            ajouterScore(&chevalier, aleatoire(graine) % 10000);
+        }
+        ajouterChevalier(tableau, chevalier);
+    }
+    return tableau;
+}
+
+/* Libère un tableau synthétique et ses scores */
+static void libererTableauSynthetique(TableauChevaliers *tableau){
+    libererTableauChevaliers(tableau);
+    free(tableau);
+}
+
+/* Choix d'arme d'un combattant sans clavier : Pierre, Feuille ou Ciseaux au hasard */
+static int armeBench(void *etat){
+    return aleatoire((unsigned int *)etat) % 3;
+}
+
+/* Vagues de nbMonstres monstres de niveaux mélangés, la moitié dans chaque vague */
+static void construireVagues(int nbMonstres, unsigned int *graine, PileMonstre *vague1, FileMonstre *vague2){
+    *vague1 = creerPile();
+    *vague2 = creerFileMonstre();
+    for (int i = 0; i < nbMonstres; i++) {
+        Monstre *monstre = creerMonstre(nomsMonstres[aleatoire(graine) % 5], 1 + aleatoire(graine) % 3);
+        if (i < nbMonstres / 2) {
+            *vague1 = pushPile(*vague1, monstre);
+        } else {
+            *vague2 = enfilerMonstre(*vague2, monstre);
+        }
+    }
+}
+
+// ----------------------------------------------- Partie Chevaliers et scores -----------------------------------------------
+
+ResultatBench benchAjouterScore(long nbScores){
+    ResultatBench resultat = creerResultat("ajouterScore", nbScores);
+    unsigned int graine = 12345;
+    long nbChevaliers = (nbScores < 1000) ? nbScores : 1000;
+    TableauChevaliers *tableau = tableauSynthetique(nbChevaliers, 0, &graine);
+
+    demarrerMesure(&resultat);
+    for (long i = 0; i < nbScores; i++) {
+        ajouterScore(&tableau->chevaliers[i % nbChevaliers], aleatoire(&graine) % 10000);
+    }
+    arreterMesure(&resultat);
+    resultat.nbOperations = nbScores;
+
+    libererTableauSynthetique(tableau);
+    return resultat;
+}
+
+ResultatBench benchSauvegarde(long nbChevaliers, const char *chemin){
+    ResultatBench resultat = creerResultat("sauvegarderTableauBinaire", nbChevaliers);
+    unsigned int graine = 23456;
+    TableauChevaliers *tableau = tableauSynthetique(nbChevaliers, 5, &graine);
+
+    for (int rep = 0; rep < 5; rep++) {
+        demarrerMesure(&resultat);
+        sauvegarderTableauBinaire(tableau, chemin);
+        arreterMesure(&resultat);
+        resultat.nbOperations++;
+    }
+
+    libererTableauSynthetique(tableau);
+    return resultat;
+}
+
+ResultatBench benchChargement(long nbChevaliers, const char *chemin){
+    ResultatBench resultat = creerResultat("chargerTableauBinaire", nbChevaliers);
+    unsigned int graine = 34567;
+    TableauChevaliers *tableau = tableauSynthetique(nbChevaliers, 5, &graine);
+    sauvegarderTableauBinaire(tableau, chemin);
+    libererTableauSynthetique(tableau);
+
+    for (int rep = 0; rep < 5; rep++) {
+        int nb;
+        demarrerMesure(&resultat);
+        TableauChevaliers *charge = chargerTableauBinaire(chemin, &nb);
+        arreterMesure(&resultat);
+        resultat.nbOperations++;
+        libererTableauSynthetique(charge);
+    }
+    return resultat;
+}
+
+ResultatBench benchTriNoms(long nbChevaliers){
+    ResultatBench resultat = creerResultat("triBulleTableauChevaliers", nbChevaliers);
+    unsigned int graine = 45678;
+    TableauChevaliers *tableau = tableauSynthetique(nbChevaliers, 1, &graine);
+    Chevalier *original = malloc(nbChevaliers * sizeof(Chevalier));
+    memcpy(original, tableau->chevaliers, nbChevaliers * sizeof(Chevalier));
+
+    // Chaque tri part du même ordre mélangé
+    for (int rep = 0; rep < 5; rep++) {
+        memcpy(tableau->chevaliers, original, nbChevaliers * sizeof(Chevalier));
+        demarrerMesure(&resultat);
+        triBulleTableauChevaliers(tableau);
+        arreterMesure(&resultat);
+        resultat.nbOperations++;
+    }
+
+    free(original);
+    libererTableauSynthetique(tableau);
+    return resultat;
+}
+
+ResultatBench benchTriScores(long nbChevaliers){
+    ResultatBench resultat = creerResultat("triRapideChevaliers", nbChevaliers);
+    unsigned int graine = 56789;
+    TableauChevaliers *tableau = tableauSynthetique(nbChevaliers, 1, &graine);
+    Chevalier *original = malloc(nbChevaliers * sizeof(Chevalier));
+    memcpy(original, tableau->chevaliers, nbChevaliers * sizeof(Chevalier));
+
+    for (int rep = 0; rep < 5; rep++) {
+        memcpy(tableau->chevaliers, original, nbChevaliers * sizeof(Chevalier));
+        demarrerMesure(&resultat);
+        triRapideChevaliers(tableau->chevaliers, 0, tableau->nbChevaliers - 1);
+        arreterMesure(&resultat);
+        resultat.nbOperations++;
+    }
+
+    free(original);
+    libererTableauSynthetique(tableau);
+    return resultat;
+}
+
+ResultatBench benchRechercheDichotomique(long nbChevaliers){
+    ResultatBench resultat = creerResultat("rechDichotomiqueJoueur", nbChevaliers);
+    unsigned int graine = 67890;
+    TableauChevaliers *tableau = tableauSynthetique(nbChevaliers, 0, &graine);
+    triBulleTableauChevaliers(tableau);
+
+    // Une recherche sur deux porte sur un pseudo absent
+    char (*requetes)[LONGUEUR_MAX_PSEUDO + 1] = malloc(1024 * sizeof(*requetes));
+    for (int i = 0; i < 1024; i++) {
+        if (i % 2 == 0) {
+            pseudoSynthetique(requetes[i], aleatoire(&graine) % nbChevaliers);
+        } else {
+            sprintf(requetes[i], "absent%u", aleatoire(&graine));
+        }
+    }
+
+    long nbTrouves = 0;
+    int trouve;
+    demarrerMesure(&resultat);
+    for (long i = 0; i < 1000000; i++) {
+        rechDichotomiqueJoueur(tableau, requetes[i & 1023], &trouve);
+        nbTrouves += trouve;
+    }
+    arreterMesure(&resultat);
+    resultat.nbOperations = 1000000;
+    if (nbTrouves != 500000) {
+        fprintf(stderr, "rechDichotomiqueJoueur : %ld pseudo(s) trouvé(s) au lieu de 500000\n", nbTrouves);
+    }
+
+    free(requetes);
+    libererTableauSynthetique(tableau);
+    return resultat;
+}
+
+// ----------------------------------------------- Partie Monstres et jeu -----------------------------------------------
+
+ResultatBench benchLireMonstres(long nbMonstres, const char *chemin){
+    ResultatBench resultat = creerResultat("lireMonstres", nbMonstres);
+    unsigned int graine = 78901;
+
+    FILE *fichier = fopen(chemin, "w");
+    if (fichier == NULL) {
+        perror("Impossible d'ouvrir le fichier");
+        exit(EXIT_FAILURE);
+    }
+    for (int vague = 0; vague < 2; vague++) {
+        long nb = (vague == 0) ? nbMonstres / 2 : nbMonstres - nbMonstres / 2;
+        fprintf(fichier, "Contexte\n%ld\n", nb);
+        for (long i = 0; i < nb; i++) {
+            fprintf(fichier, "%s %u\n", nomsMonstres[aleatoire(&graine) % 5], 1 + aleatoire(&graine) % 3);
+        }
+    }
+    fclose(fichier);
+
+    couperSortie();
+    for (int rep = 0; rep < 5; rep++) {
+        PileMonstre vague1 = creerPile();
+        FileMonstre vague2 = creerFileMonstre();
+        demarrerMesure(&resultat);
+        lireMonstresFichier(chemin, &vague1, &vague2);
+        arreterMesure(&resultat);
+        resultat.nbOperations++;
+        libererVague1(vague1);
+        libererVague2(vague2);
+    }
+    retablirSortie();
+    return resultat;
+}
+
+ResultatBench benchComparaison(long nbComparaisons){
+    ResultatBench resultat = creerResultat("comparaison", nbComparaisons);
+    unsigned int graine = 89012;
+    int armesMonstre[1024], armesJoueur[1024];
+    for (int i = 0; i < 1024; i++) {
+        armesMonstre[i] = aleatoire(&graine) % 5;
+        armesJoueur[i] = aleatoire(&graine) % 3;
+    }
+
+    long nbVictoires = 0;
+    demarrerMesure(&resultat);
+    for (long i = 0; i < nbComparaisons; i++) {
+        nbVictoires += (comparaison(armesMonstre[i & 1023], armesJoueur[i & 1023]) == victoire);
+    }
+    arreterMesure(&resultat);
+    resultat.nbOperations = nbComparaisons;
+
+    // Le total est utilisé pour que la boucle ne soit pas supprimée
+    if (nbVictoires < 0) printf("%ld\n", nbVictoires);
+    return resultat;
+}
+
+ResultatBench benchParties(long nbParties, int nbMonstres){
+    ResultatBench resultat = creerResultat("jouerPartie", nbMonstres);
+    unsigned int graine = 90123;
+    long scoreTotal = 0;
+
+    couperSortie();
+    for (long i = 0; i < nbParties; i++) {
+        PileMonstre vague1;
+        FileMonstre vague2;
+        construireVagues(nbMonstres, &graine, &vague1, &vague2);
+        Combattant joueur = creerCombattant("bench");
+        joueur.choisirArme = armeBench;
+        joueur.etatArme = &graine;
+
+        demarrerMesure(&resultat);
+        scoreTotal += jouerPartie(&joueur, vague1, vague2);
+        arreterMesure(&resultat);
+        resultat.nbOperations++;
+    }
+    retablirSortie();
+
+    if (scoreTotal < 0) printf("%ld\n", scoreTotal);
+    return resultat;
+}
+
+// ----------------------------------------------- Partie Instrumentation -----------------------------------------------
+
+ResultatBench benchEnregistrerMesure(long nbMesures){
+    ResultatBench resultat = creerResultat("enregistrerMesure", nbMesures);
+    unsigned int graine = 91234;
+    long long durees[1024];
+    // Des durées de 1 ns à 1 ms : toutes les puissances de 2 de l'histogramme sont parcourues
+    for (int i = 0; i < 1024; i++) {
+        durees[i] = 1 + aleatoire(&graine) % (1u << (1 + i % 20));
+    }
+
+    demarrerMesure(&resultat);
+    for (long i = 0; i < nbMesures; i++) {
+        enregistrerMesure(MESURE_TRI, 0, durees[i & 1023]);
+    }
+    arreterMesure(&resultat);
+    resultat.nbOperations = nbMesures;
+    reinitialiserMesures();
+    return resultat;
+}
@@ -0,0 +1,76 @@
+/**
+ * \file bench.h
+ * \brief En-tête pour les mesures de performance
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "../chevalier.h"
+#include "../monstres.h"
+#include "../jeu.h"
+#include "../instrumentation.h"
+
+/**
+ * \struct ResultatBench
+ * \brief Résultat d'une mesure : temps et allocations de la partie mesurée seulement.
+ */
+typedef struct {
+    const char *nom;
+    long taille;              // Taille des données d'entrée (chevaliers, monstres...)
+    long nbOperations;
+    double secondes;
+    long nbAllocations;       // Appels à malloc, calloc et realloc
+    long octetsAlloues;
+    struct timespec debut;    // Début de la mesure en cours
+    long allocationsDebut;
+    long octetsDebut;
+} ResultatBench;
+
+// Mesure
+
+ResultatBench creerResultat(const char *nom, long taille);
+
+void demarrerMesure(ResultatBench *resultat);
+
+void arreterMesure(ResultatBench *resultat);
+
+void couperSortie(void);
+
+void retablirSortie(void);
+
+void afficherResultat(const ResultatBench *resultat);
+
+void ecrireEnteteResultats(FILE *fichier);
+
+void ecrireResultat(FILE *fichier, const ResultatBench *resultat);
+
+// Chevaliers et scores
+
+ResultatBench benchAjouterScore(long nbScores);
+
+ResultatBench benchSauvegarde(long nbChevaliers, const char *chemin);
+
+ResultatBench benchChargement(long nbChevaliers, const char *chemin);
+
+ResultatBench benchTriNoms(long nbChevaliers);
+
+ResultatBench benchTriScores(long nbChevaliers);
+
+ResultatBench benchRechercheDichotomique(long nbChevaliers);
+
+// Monstres et jeu
+
+ResultatBench benchLireMonstres(long nbMonstres, const char *chemin);
+
+ResultatBench benchComparaison(long nbComparaisons);
+
+ResultatBench benchParties(long nbParties, int nbMonstres);
+
+// Instrumentation
+
+ResultatBench benchEnregistrerMesure(long nbMesures);
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * \file generer.c
+ * \brief Programme qui écrit des fichiers des scores et de monstres synthétiques
+ * \author Delinac Inès
+ * \date 18/10/2026
+ *
+ * Utilisation :
+ *   ./generer scores <fichier> [chevaliers=N] [longueur=MIN-MAX] [parties=MIN-MAX] [asymetrie=K]
+ *                              [scoremax=S] [valeurs=V] [graine=G]
+ *   ./generer vagues <fichier> [vague1=N] [vague2=N] [niveaux=P1,P2,P3] [graine=G]
+ *
+ * Exemple : ./generer scores /tmp/10M.txt chevaliers=10000000 parties=1-500 asymetrie=3 valeurs=50
+ */
+
+#include "../generateur.h"
+
+/* Affiche l'utilisation et termine */
+static void usage(const char *programme){
+    fprintf(stderr, "Utilisation :\n");
+    fprintf(stderr, "  %s scores <fichier> [chevaliers=N] [longueur=MIN-MAX] [parties=MIN-MAX] [asymetrie=K] [scoremax=S] [valeurs=V] [graine=G]\n", programme);
+    fprintf(stderr, "  %s vagues <fichier> [vague1=N] [vague2=N] [niveaux=P1,P2,P3] [graine=G]\n", programme);
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[]){
+    if (argc < 3) usage(argv[0]);
+
+    if (strcmp(argv[1], "scores") == 0) {
+        ParametresScores parametres;
+        parametresScoresDefaut(&parametres);
+        for (int i = 3; i < argc; i++) {
+            Bool lu = sscanf(argv[i], "chevaliers=%ld", &parametres.nbChevaliers) == 1
+                   || sscanf(argv[i], "longueur=%d-%d", &parametres.longueurMin, &parametres.longueurMax) == 2
+                   || sscanf(argv[i], "parties=%d-%d", &parametres.nbPartiesMin, &parametres.nbPartiesMax) == 2
+                   || sscanf(argv[i], "asymetrie=%d", &parametres.asymetrie) == 1
+                   || sscanf(argv[i], "scoremax=%d", &parametres.scoreMax) == 1
+                   || sscanf(argv[i], "valeurs=%d", &parametres.nbValeursScores) == 1
+                   || sscanf(argv[i], "graine=%llu", &parametres.graine) == 1;
+            if (!lu) usage(argv[0]);
+        }
+        genererFichierScores(argv[2], &parametres);
+        printf("%ld chevalier(s) écrit(s) dans %s\n", parametres.nbChevaliers, argv[2]);
+    } else if (strcmp(argv[1], "vagues") == 0) {
+        ParametresVagues parametres;
+        parametresVaguesDefaut(&parametres);
+        for (int i = 3; i < argc; i++) {
+            Bool lu = sscanf(argv[i], "vague1=%d", &parametres.nbMonstresVague1) == 1
+                   || sscanf(argv[i], "vague2=%d", &parametres.nbMonstresVague2) == 1
+                   || sscanf(argv[i], "niveaux=%d,%d,%d", &parametres.poidsNiveaux[0], &parametres.poidsNiveaux[1], &parametres.poidsNiveaux[2]) == 3
+                   || sscanf(argv[i], "graine=%llu", &parametres.graine) == 1;
+            if (!lu) usage(argv[0]);
+        }
+        genererFichierVagues(argv[2], &parametres);
+        printf("%d monstre(s) écrit(s) dans %s\n", parametres.nbMonstresVague1 + parametres.nbMonstresVague2, argv[2]);
+    } else {
+        usage(argv[0]);
+    }
+
+    libererChaines();
+    return 0;
+}
@@ -0,0 +1,70 @@
+/**
+ * \file main.c
+ * \brief fonction principale pour les mesures de performance
+ * \author Delinac Inès
+ * \date 18/10/2026
+ *
+ * Utilisation : ./bench [taille] [fichier de résultats]
+ * La taille (100000 par défaut) fixe le nombre de chevaliers des tableaux
+ * synthétiques ; les résultats sont aussi écrits au format CSV dans le
+ * fichier donné (bench.csv par défaut) pour comparer deux versions.
+ */
+
+#include "bench.h"
+
+#include <unistd.h>
+
+/* Crée un fichier temporaire vide et garde son chemin dans modele */
+static void creerFichierTemporaire(char *modele){
+    int fd = mkstemp(modele);
+    if (fd == -1) {
+        perror("Impossible de créer un fichier temporaire");
+        exit(EXIT_FAILURE);
+    }
+    close(fd);
+}
+
+int main(int argc, char *argv[]){
+    long taille = (argc > 1) ? atol(argv[1]) : 100000;
+    const char *fichierResultats = (argc > 2) ? argv[2] : "bench.csv";
+    if (taille <= 0) {
+        fprintf(stderr, "Utilisation : %s [taille] [fichier de résultats]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char cheminScores[] = "/tmp/bench_scoresXXXXXX";
+    char cheminMonstres[] = "/tmp/bench_monstresXXXXXX";
+    creerFichierTemporaire(cheminScores);
+    creerFichierTemporaire(cheminMonstres);
+
+    ResultatBench resultats[10];
+    int nb = 0;
+    resultats[nb++] = benchAjouterScore(10 * taille);
+    resultats[nb++] = benchSauvegarde(taille, cheminScores);
+    resultats[nb++] = benchChargement(taille, cheminScores);
+    resultats[nb++] = benchTriNoms(taille);
+    resultats[nb++] = benchTriScores(taille);
+    resultats[nb++] = benchRechercheDichotomique(taille);
+    resultats[nb++] = benchLireMonstres(taille, cheminMonstres);
+    resultats[nb++] = benchComparaison(100 * taille);
+    resultats[nb++] = benchParties((taille < 100) ? 100 : taille / 10, 10);
+    resultats[nb++] = benchEnregistrerMesure(100 * taille);
+
+    FILE *fichier = fopen(fichierResultats, "w");
+    if (fichier == NULL) {
+        perror("Impossible d'ouvrir le fichier de résultats");
+        exit(EXIT_FAILURE);
+    }
+    ecrireEnteteResultats(fichier);
+    for (int i = 0; i < nb; i++) {
+        afficherResultat(&resultats[i]);
+        ecrireResultat(fichier, &resultats[i]);
+    }
+    fclose(fichier);
+    printf("Résultats écrits dans %s\n", fichierResultats);
+
+    remove(cheminScores);
+    remove(cheminMonstres);
+    libererChaines();
+    return 0;
+}
@@ -0,0 +1,376 @@
+/**
+ * \file sessions.c
+ * \brief Programme qui mesure le jeu complet sur des sessions écrites d'avance
+ * \author Delinac Inès
+ * \date 18/10/2026
+ *
+ * Utilisation :
+ *   ./sessions [sessions=N] [parties=N] [chevaliers=N] [graine=G] [sae=CHEMIN] [resultats=FICHIER]
+ *
+ * Chaque session lance le vrai programme (./sae par défaut) sur un script :
+ * des parties avec des pseudos et des fichiers de monstres tirés au hasard,
+ * entrecoupées de classements, de statistiques et de recherches, puis
+ * "Quitter". La sortie du jeu va dans /dev/null. Les données (fichier des
+ * scores de départ, fichiers de monstres, scripts) et les armes ne dépendent
+ * que de la graine : deux versions du jeu mesurées avec les mêmes options
+ * jouent exactement les mêmes sessions.
+ *
+ * Sont affichés, et écrits au format CSV (sessions.csv par défaut) : le
+ * nombre de sessions par seconde, les centiles 50 et 99 de la durée d'une
+ * session et de chaque opération (actions du menu et points de mesure, lus
+ * dans la trace de chaque session), et le pic de mémoire résidente du jeu.
+ * Les durées par opération demandent un jeu compilé avec INSTRUMENTATION.
+ *
+ * Exemple : ./sessions sessions=200 parties=10 chevaliers=100000
+ */
+
+#include "../generateur.h"
+
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+/**
+ * \def NB_FICHIERS_VAGUES
+ * \brief Nombre de fichiers de monstres différents parmi lesquels les parties sont tirées.
+ */
+#define NB_FICHIERS_VAGUES 4
+
+/**
+ * \def NB_OPERATIONS_MAX
+ * \brief Nombre maximal de noms d'opérations différents lus dans les traces.
+ */
+#define NB_OPERATIONS_MAX 32
+
+/* Durées en microsecondes d'une opération, sur toutes les sessions */
+typedef struct {
+    char nom[32];
+    double *durees;
+    long nb;
+    long capacite;
+} Operation;
+
+/* Opérations vues dans les traces, dans l'ordre de leur première apparition */
+static Operation operations[NB_OPERATIONS_MAX];
+static int nbOperations = 0;
+
+/* Affiche l'utilisation et termine */
+static void usage(const char *programme){
+    fprintf(stderr, "Utilisation : %s [sessions=N] [parties=N] [chevaliers=N] [graine=G] [sae=CHEMIN] [resultats=FICHIER]\n", programme);
+    exit(EXIT_FAILURE);
+}
+
+/* Ajoute une durée à une liste qui grandit au besoin */
+static void ajouterDuree(Operation *operation, double duree){
+    if (operation->nb == operation->capacite) {
+        operation->capacite = (operation->capacite == 0) ? 256 : 2 * operation->capacite;
+        operation->durees = realloc(operation->durees, operation->capacite * sizeof(double));
+        if (operation->durees == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+    }
+    operation->durees[operation->nb++] = duree;
+}
+
+/* Donne l'opération d'un nom, créée à sa première apparition */
+static Operation *trouverOperation(const char *nom){
+    for (int i = 0; i < nbOperations; i++) {
+        if (strcmp(operations[i].nom, nom) == 0) return &operations[i];
+    }
+    if (nbOperations == NB_OPERATIONS_MAX) {
+        fprintf(stderr, "Trop d'opérations différentes dans les traces (%d au plus)\n", NB_OPERATIONS_MAX);
+        exit(EXIT_FAILURE);
+    }
+    Operation *operation = &operations[nbOperations++];
+    memset(operation, 0, sizeof(Operation));
+    snprintf(operation->nom, sizeof(operation->nom), "%s", nom);
+    return operation;
+}
+
+/* Compare deux durées pour qsort */
+static int comparerDurees(const void *a, const void *b){
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* Centile (1 à 100) d'une liste triée, au rang le plus proche */
+static double centile(const double *durees, long nb, int p){
+    long rang = (p * nb + 99) / 100;
+    return durees[(rang < 1) ? 0 : rang - 1];
+}
+
+/* Construit le chemin d'un fichier du dossier de travail */
+static void cheminTravail(char *chemin, size_t taille, const char *dossier, const char *nom){
+    if ((size_t)snprintf(chemin, taille, "%s/%s", dossier, nom) >= taille) {
+        fprintf(stderr, "Chemin trop long : %s/%s\n", dossier, nom);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Copie un fichier, pour que chaque session parte du même fichier des scores */
+static void copierFichier(const char *source, const char *destination){
+    FILE *fs = fopen(source, "rb");
+    FILE *fd = fopen(destination, "wb");
+    if (fs == NULL || fd == NULL) {
+        perror("Impossible de copier le fichier des scores");
+        exit(EXIT_FAILURE);
+    }
+    char tampon[65536];
+    size_t lus;
+    while ((lus = fread(tampon, 1, sizeof(tampon), fs)) > 0) {
+        fwrite(tampon, 1, lus, fd);
+    }
+    fclose(fs);
+    if (fclose(fd) != 0) {
+        perror("Impossible de copier le fichier des scores");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Tire un pseudo de 4 à 10 lettres minuscules */
+static void tirerPseudo(Aleatoire *aleatoire, char *pseudo){
+    int longueur = 4 + tirerEntier(aleatoire, 7);
+    for (int i = 0; i < longueur; i++) {
+        pseudo[i] = 'a' + tirerEntier(aleatoire, 26);
+    }
+    pseudo[longueur] = '\0';
+}
+
+/* Écrit une requête du menu (options 3 à 8) dans le script */
+static void ecrireRequete(FILE *script, Aleatoire *aleatoire, int option, const char *pseudo){
+    switch (option) {
+        case 3:
+        case 4:
+            fprintf(script, "%d\n", option);
+            break;
+        case 5:
+            fprintf(script, "5\n%s\n", pseudo);
+            break;
+        case 6:
+            fprintf(script, "6\n20\n%u\n", 1 + tirerEntier(aleatoire, 5));
+            break;
+        case 7:
+            fprintf(script, "7\n%c%c\n20\n1\n", 'a' + tirerEntier(aleatoire, 26), 'a' + tirerEntier(aleatoire, 26));
+            break;
+        default:
+            fprintf(script, "8\n%u\n", tirerEntier(aleatoire, SCORE_MAX));
+            break;
+    }
+}
+
+/* Écrit le script d'une session : chaque partie est suivie d'une requête tirée au hasard, puis toutes les requêtes sont faites une fois */
+static void ecrireScript(const char *chemin, unsigned long long graine, int nbParties){
+    FILE *script = fopen(chemin, "w");
+    if (script == NULL) {
+        perror("Impossible d'écrire le script de la session");
+        exit(EXIT_FAILURE);
+    }
+    Aleatoire aleatoire;
+    initialiserAleatoire(&aleatoire, graine);
+    char pseudo[16] = "inconnu";
+
+    for (int i = 0; i < nbParties; i++) {
+        tirerPseudo(&aleatoire, pseudo);
+        fprintf(script, "1\nvagues%u.txt\n%s\n", tirerEntier(&aleatoire, NB_FICHIERS_VAGUES), pseudo);
+        ecrireRequete(script, &aleatoire, 3 + tirerEntier(&aleatoire, 6), pseudo);
+    }
+    for (int option = 3; option <= 8; option++) {
+        ecrireRequete(script, &aleatoire, option, pseudo);
+    }
+    fprintf(script, "9\n");
+    fclose(script);
+}
+
+/* Lance le jeu sur un script et attend sa fin ; renvoie la durée de la session en microsecondes et son pic de mémoire en Ko */
+static double lancerSession(const char *sae, const char *dossier, const char *script, unsigned long long graine, long *picKo){
+    char cheminTrace[4096], graineArmes[32];
+    cheminTravail(cheminTrace, sizeof(cheminTrace), dossier, "trace.json");
+    snprintf(graineArmes, sizeof(graineArmes), "%llu", graine);
+    remove(cheminTrace);
+
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("Impossible de lancer le jeu");
+        exit(EXIT_FAILURE);
+    }
+    if (pid == 0) {
+        int entree = open(script, O_RDONLY);
+        int nul = open("/dev/null", O_WRONLY);
+        if (entree == -1 || nul == -1) {
+            perror("Impossible de préparer les entrées-sorties du jeu");
+            _exit(EXIT_FAILURE);
+        }
+        dup2(entree, STDIN_FILENO);
+        dup2(nul, STDOUT_FILENO);
+        close(entree);
+        close(nul);
+        setenv("SAE_DONNEES", dossier, 1);
+        setenv("SAE_ARMES", graineArmes, 1);
+        setenv("SAE_TRACE", cheminTrace, 1);
+        unsetenv("SAE_MESURES");
+        execl(sae, sae, (char *)NULL);
+        perror("Impossible de lancer le jeu");
+        _exit(EXIT_FAILURE);
+    }
+
+    int statut;
+    struct rusage ressources;
+    if (wait4(pid, &statut, 0, &ressources) == -1) {
+        perror("Impossible d'attendre la fin du jeu");
+        exit(EXIT_FAILURE);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    if (!WIFEXITED(statut) || WEXITSTATUS(statut) != 0) {
+        fprintf(stderr, "Le jeu s'est mal terminé sur le script %s\n", script);
+        exit(EXIT_FAILURE);
+    }
+    *picKo = ressources.ru_maxrss;
+    return (fin.tv_sec - debut.tv_sec) * 1e6 + (fin.tv_nsec - debut.tv_nsec) / 1e3;
+}
+
+/* Ajoute les événements de la trace d'une session aux durées des opérations */
+static void lireTrace(const char *dossier){
+    char chemin[4096], ligne[512], nom[32];
+    cheminTravail(chemin, sizeof(chemin), dossier, "trace.json");
+    FILE *trace = fopen(chemin, "r");
+    if (trace == NULL) return;
+
+    while (fgets(ligne, sizeof(ligne), trace) != NULL) {
+        char *duree = strstr(ligne, "\"dur\":");
+        if (duree != NULL && sscanf(ligne, "{\"name\":\"%31[^\"]\",\"ph\":\"X\"", nom) == 1) {
+            ajouterDuree(trouverOperation(nom), strtod(duree + 6, NULL));
+        }
+    }
+    fclose(trace);
+}
+
+/* Affiche et écrit au format CSV les centiles d'une liste de durées, triée au passage */
+static void ecrireLigne(FILE *resultats, Operation *operation, double secondes, long picKo){
+    qsort(operation->durees, operation->nb, sizeof(double), comparerDurees);
+    double p50 = centile(operation->durees, operation->nb, 50);
+    double p99 = centile(operation->durees, operation->nb, 99);
+    double max = operation->durees[operation->nb - 1];
+    printf("%-24s %10ld %12.1f /s %12.1f us %12.1f us %12.1f us\n", operation->nom, operation->nb,
+           operation->nb / secondes, p50, p99, max);
+    fprintf(resultats, "%s,%ld,%.2f,%.2f,%.2f,%.2f,", operation->nom, operation->nb, operation->nb / secondes, p50, p99, max);
+    if (picKo >= 0) fprintf(resultats, "%ld", picKo);
+    fprintf(resultats, "\n");
+}
+
+int main(int argc, char *argv[]){
+    int nbSessions = 50, nbParties = 5;
+    ParametresScores parametresScores;
+    parametresScoresDefaut(&parametresScores);
+    parametresScores.nbChevaliers = 10000;
+    unsigned long long graine = 1;
+    const char *sae = "./sae";
+    const char *fichierResultats = "sessions.csv";
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "sae=", 4) == 0) {
+            sae = argv[i] + 4;
+        } else if (strncmp(argv[i], "resultats=", 10) == 0) {
+            fichierResultats = argv[i] + 10;
+        } else {
+            Bool lu = sscanf(argv[i], "sessions=%d", &nbSessions) == 1
+                   || sscanf(argv[i], "parties=%d", &nbParties) == 1
+                   || sscanf(argv[i], "chevaliers=%ld", &parametresScores.nbChevaliers) == 1
+                   || sscanf(argv[i], "graine=%llu", &graine) == 1;
+            if (!lu) usage(argv[0]);
+        }
+    }
+    if (nbSessions <= 0 || nbParties < 0 || parametresScores.nbChevaliers < 0) usage(argv[0]);
+    if (access(sae, X_OK) != 0) {
+        fprintf(stderr, "Programme du jeu introuvable : %s\n", sae);
+        exit(EXIT_FAILURE);
+    }
+
+    // Dossier de travail : le jeu y lit et y écrit ses fichiers à la place de src/fichier/
+    char dossier[] = "/tmp/sessionsXXXXXX";
+    if (mkdtemp(dossier) == NULL) {
+        perror("Impossible de créer le dossier de travail");
+        exit(EXIT_FAILURE);
+    }
+    char cheminInitial[4096], cheminScores[4096], cheminBinaire[4096], cheminScript[4096], cheminVagues[4096], nom[32];
+    cheminTravail(cheminInitial, sizeof(cheminInitial), dossier, "initial.txt");
+    cheminTravail(cheminScores, sizeof(cheminScores), dossier, FICHIER_SCORES);
+    cheminTravail(cheminBinaire, sizeof(cheminBinaire), dossier, FICHIER_SCORES_BINAIRE);
+    cheminTravail(cheminScript, sizeof(cheminScript), dossier, "script.txt");
+
+    parametresScores.graine = graine;
+    genererFichierScores(cheminInitial, &parametresScores);
+    for (int i = 0; i < NB_FICHIERS_VAGUES; i++) {
+        ParametresVagues parametresVagues;
+        parametresVaguesDefaut(&parametresVagues);
+        parametresVagues.graine = graine + i;
+        snprintf(nom, sizeof(nom), "vagues%d.txt", i);
+        cheminTravail(cheminVagues, sizeof(cheminVagues), dossier, nom);
+        genererFichierVagues(cheminVagues, &parametresVagues);
+    }
+
+    // La première session, qui remplit les caches du système, n'est pas comptée
+    Operation sessions;
+    memset(&sessions, 0, sizeof(sessions));
+    snprintf(sessions.nom, sizeof(sessions.nom), "session");
+    long picKo = 0, picSession;
+    double total = 0.0;
+    for (int s = -1; s < nbSessions; s++) {
+        unsigned long long graineSession = graine + 1000 + (s < 0 ? 0 : s);
+        // Sans fichier binaire, chaque session importe le même fichier texte
+        copierFichier(cheminInitial, cheminScores);
+        remove(cheminBinaire);
+        ecrireScript(cheminScript, graineSession, nbParties);
+        double duree = lancerSession(sae, dossier, cheminScript, graineSession, &picSession);
+        if (s < 0) continue;
+
+        ajouterDuree(&sessions, duree);
+        total += duree;
+        if (picSession > picKo) picKo = picSession;
+        lireTrace(dossier);
+    }
+
+    double secondes = total / 1e6;
+    printf("%d session(s) de %d partie(s) sur %ld chevalier(s) en %.3f s : %.2f sessions/s, pic de mémoire %ld Ko\n\n",
+           nbSessions, nbParties, parametresScores.nbChevaliers, secondes, nbSessions / secondes, picKo);
+    printf("%-24s %10s %15s %15s %15s %15s\n", "operation", "nombre", "debit", "p50", "p99", "max");
+
+    FILE *resultats = fopen(fichierResultats, "w");
+    if (resultats == NULL) {
+        perror("Impossible d'ouvrir le fichier de résultats");
+        exit(EXIT_FAILURE);
+    }
+    fprintf(resultats, "nom,nombre,par_seconde,p50_us,p99_us,max_us,pic_rss_ko\n");
+    ecrireLigne(resultats, &sessions, secondes, picKo);
+    for (int i = 0; i < nbOperations; i++) {
+        ecrireLigne(resultats, &operations[i], secondes, -1);
+        free(operations[i].durees);
+    }
+    fclose(resultats);
+    free(sessions.durees);
+    if (nbOperations == 0) {
+        printf("\nTraces vides : le jeu est compilé sans INSTRUMENTATION, seules les sessions sont mesurées\n");
+    }
+
+    remove(cheminInitial);
+    remove(cheminScores);
+    remove(cheminBinaire);
+    remove(cheminScript);
+    cheminTravail(cheminScript, sizeof(cheminScript), dossier, "trace.json");
+    remove(cheminScript);
+    for (int i = 0; i < NB_FICHIERS_VAGUES; i++) {
+        snprintf(nom, sizeof(nom), "vagues%d.txt", i);
+        cheminTravail(cheminVagues, sizeof(cheminVagues), dossier, nom);
+        remove(cheminVagues);
+    }
+    if (rmdir(dossier) != 0) {
+        perror("Impossible de supprimer le dossier de travail");
+    }
+
+    libererChaines();
+    return 0;
+}
@@ -0,0 +1,316 @@
+/**
+ * \file simuler.c
+ * \brief Programme qui évalue des fichiers de monstres et des stratégies par simulation
+ * \author Delinac Inès
+ * \date 18/10/2026
+ *
+ * Utilisation :
+ *   ./simuler <fichier>[:strategie] [<fichier>[:strategie]] [victoires=P] [score=S] [lot=N]
+ *             [min=N] [max=N] [z=Z] [graine=G] [fils=N]
+ *   ./simuler tournoi [parties=N] [travail=N] [generees=N] [z=Z] [graine=G] [fils=N]
+ *
+ * Avec une configuration (un fichier de monstres et une stratégie,
+ * "aleatoire" par défaut), les parties sont simulées jusqu'à connaître le
+ * taux de victoires à P près (0.01 : à 1 point près) et le score moyen à
+ * S points près. Avec deux configurations, elles sont jouées sur les mêmes
+ * graines jusqu'à ce que l'écart de leurs scores moyens soit montré, ou
+ * connu à S points près.
+ *
+ * Le tournoi joue N parties de chaque stratégie contre chaque fichier de
+ * monstres du dossier des données et contre des fichiers générés de plus
+ * en plus longs (8, 16, 32... monstres par vague), par travaux de N
+ * parties répartis par vol de travail, puis classe les stratégies.
+ *
+ * Exemples : ./simuler facile.txt victoires=0.005
+ *            ./simuler moyen.txt:aleatoire moyen.txt:pierre
+ *            ./simuler tournoi parties=50000 generees=6
+ */
+
+#include "../tournoi.h"
+#include "../pool.h"
+#include "../instrumentation.h"
+
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+/**
+ * \def NB_FICHIERS_TOURNOI
+ * \brief Nombre maximal de fichiers de monstres d'un tournoi.
+ */
+#define NB_FICHIERS_TOURNOI 64
+
+/* Affiche l'utilisation et termine */
+static void usage(const char *programme){
+    fprintf(stderr, "Utilisation :\n");
+    fprintf(stderr, "  %s <fichier>[:strategie] [<fichier>[:strategie]] [victoires=P] [score=S] [lot=N] [min=N] [max=N] [z=Z] [graine=G] [fils=N]\n", programme);
+    fprintf(stderr, "  %s tournoi [parties=N] [travail=N] [generees=N] [z=Z] [graine=G] [fils=N]\n", programme);
+    fprintf(stderr, "Stratégies : aleatoire, frequence, motif, pierre, feuille, ciseaux\n");
+    exit(EXIT_FAILURE);
+}
+
+/* Découpe "fichier:strategie" et lit la configuration ; termine si la stratégie est inconnue */
+static void lireConfiguration(ConfigurationSimulation *config, char *argument, const char *programme){
+    const char *nomStrategie = "aleatoire";
+    char *separateur = strrchr(argument, ':');
+    if (separateur != NULL) {
+        *separateur = '\0';
+        nomStrategie = separateur + 1;
+    }
+    const StrategieSimulation *strategie = trouverStrategie(nomStrategie);
+    if (strategie == NULL) {
+        fprintf(stderr, "Stratégie inconnue : %s\n", nomStrategie);
+        usage(programme);
+    }
+    chargerConfiguration(config, argument, strategie);
+}
+
+/* Affiche le taux de victoires et le score moyen d'une configuration avec leurs intervalles */
+static void afficherResultat(const ConfigurationSimulation *config, const ResultatSimulation *resultat, double z){
+    double bas, haut;
+    intervalleVictoires(resultat->nbVictoires, resultat->scores.nb, z, &bas, &haut);
+    printf("%s (%s) : %ld partie(s)\n", config->fichier, config->strategie->nom, resultat->scores.nb);
+    printf("  victoires   : %6.2f %%  [%.2f ; %.2f]\n",
+           100.0 * resultat->nbVictoires / resultat->scores.nb, 100.0 * bas, 100.0 * haut);
+    printf("  score moyen : %8.2f ± %.2f\n", moyenneEchantillon(&resultat->scores), demiLargeurMoyenne(&resultat->scores, z));
+}
+
+/* Ordre des noms de fichiers */
+static int comparerNoms(const void *a, const void *b){
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/* Vrai si le fichier commence par "Contexte", comme les fichiers de monstres */
+static Bool estFichierMonstres(const char *chemin){
+    char mot[16] = "";
+    FILE *fichier = fopen(chemin, "r");
+    if (fichier == NULL) return false;
+    Bool monstres = fscanf(fichier, "%15s", mot) == 1 && strcmp(mot, "Contexte") == 0;
+    fclose(fichier);
+    return monstres;
+}
+
+/* Range dans noms les fichiers de monstres du dossier des données, triés ; renvoie leur nombre */
+static int listerFichiersMonstres(char *noms[], int nbMax){
+    char *dossier = cheminDonnees("");
+    DIR *repertoire = opendir(dossier);
+    if (repertoire == NULL) {
+        perror("Erreur lors de l'ouverture du dossier des données");
+        exit(EXIT_FAILURE);
+    }
+    int nbNoms = 0;
+    struct dirent *entree;
+    while ((entree = readdir(repertoire)) != NULL && nbNoms < nbMax) {
+        size_t longueur = strlen(entree->d_name);
+        if (longueur < 4 || strcmp(entree->d_name + longueur - 4, ".txt") != 0) continue;
+        char chemin[4096];
+        snprintf(chemin, sizeof(chemin), "%s%s", dossier, entree->d_name);
+        if (estFichierMonstres(chemin)) {
+            noms[nbNoms++] = strdup(entree->d_name);
+        }
+    }
+    closedir(repertoire);
+    libererMemoire(MEMOIRE_TAMPONS, dossier);
+    qsort(noms, nbNoms, sizeof(char *), comparerNoms);
+    return nbNoms;
+}
+
+/* Nom affiché d'un fichier : sans son dossier */
+static const char *nomCourt(const char *fichier){
+    const char *separateur = strrchr(fichier, '/');
+    return (separateur != NULL) ? separateur + 1 : fichier;
+}
+
+/* Durée écoulée depuis debut, en secondes */
+static double secondesDepuis(const struct timespec *debut){
+    struct timespec fin;
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    return (fin.tv_sec - debut->tv_sec) + (fin.tv_nsec - debut->tv_nsec) / 1e9;
+}
+
+/* Temps processeur consommé par le programme, en secondes */
+static double secondesProcesseur(void){
+    struct rusage ressources;
+    getrusage(RUSAGE_SELF, &ressources);
+    return ressources.ru_utime.tv_sec + ressources.ru_utime.tv_usec / 1e6
+         + ressources.ru_stime.tv_sec + ressources.ru_stime.tv_usec / 1e6;
+}
+
+/* Mode tournoi : toutes les stratégies contre tous les fichiers de monstres, puis le classement */
+static void jouerModeTournoi(int argc, char *argv[]){
+    long parties = 20000, partiesParTravail = 250;
+    int nbGenerees = 4, nbFils = 0;
+    double z = 1.96;
+    unsigned long long graine = 1;
+    for (int i = 2; i < argc; i++) {
+        Bool lu = sscanf(argv[i], "parties=%ld", &parties) == 1
+               || sscanf(argv[i], "travail=%ld", &partiesParTravail) == 1
+               || sscanf(argv[i], "generees=%d", &nbGenerees) == 1
+               || sscanf(argv[i], "z=%lf", &z) == 1
+               || sscanf(argv[i], "graine=%llu", &graine) == 1
+               || sscanf(argv[i], "fils=%d", &nbFils) == 1;
+        if (!lu) usage(argv[0]);
+    }
+    if (parties <= 0 || partiesParTravail <= 0 || nbGenerees < 0 || nbGenerees > 16) usage(argv[0]);
+    if (nbFils <= 0) nbFils = nombreCoeurs();
+
+    // Fichiers du dossier des données, puis fichiers générés de plus en plus longs
+    char *fichiers[NB_FICHIERS_TOURNOI];
+    int nbFichiers = listerFichiersMonstres(fichiers, NB_FICHIERS_TOURNOI - nbGenerees);
+    int nbDonnees = nbFichiers;
+    char dossier[] = "/tmp/tournoiXXXXXX";
+    if (nbGenerees > 0 && mkdtemp(dossier) == NULL) {
+        perror("Impossible de créer le dossier des vagues générées");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nbGenerees; i++) {
+        ParametresVagues parametresVagues;
+        parametresVaguesDefaut(&parametresVagues);
+        parametresVagues.nbMonstresVague1 = 8 << i;
+        parametresVagues.nbMonstresVague2 = 8 << i;
+        parametresVagues.graine = graine + i;
+        char chemin[64];
+        snprintf(chemin, sizeof(chemin), "%s/genere%d.txt", dossier, 8 << i);
+        genererFichierVagues(chemin, &parametresVagues);
+        fichiers[nbFichiers++] = strdup(chemin);
+    }
+    if (nbFichiers == 0) {
+        fprintf(stderr, "Aucun fichier de monstres\n");
+        exit(EXIT_FAILURE);
+    }
+
+    ConfigurationSimulation vagues[NB_FICHIERS_TOURNOI];
+    for (int f = 0; f < nbFichiers; f++) {
+        chargerConfiguration(&vagues[f], fichiers[f], NULL);
+    }
+
+    Tournoi tournoi;
+    initialiserTournoi(&tournoi, vagues, nbFichiers, parties);
+    tournoi.partiesParTravail = partiesParTravail;
+    tournoi.graine = graine;
+    tournoi.nbFils = nbFils;
+    long *travauxParFil = (long *)calloc(nbFils, sizeof(long));
+    if (travauxParFil == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    struct timespec debut;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    double processeurAvant = secondesProcesseur();
+    jouerTournoi(&tournoi, travauxParFil);
+    double duree = secondesDepuis(&debut);
+    double processeur = secondesProcesseur() - processeurAvant;
+
+    ClassementStrategie classement[16];
+    classerStrategies(&tournoi, z, classement);
+
+    printf("\nTournoi : %d stratégie(s) x %d fichier(s), %ld partie(s) par case\n\n", tournoi.nbStrategies, nbFichiers, parties);
+    printf("%-4s %-10s %22s %26s\n", "rang", "strategie", "score moyen", "victoires");
+    for (int i = 0; i < tournoi.nbStrategies; i++) {
+        double bas, haut;
+        intervalleVictoires(classement[i].nbVictoires, classement[i].nbParties, z, &bas, &haut);
+        printf("%-4d %-10s %12.2f ± %-7.2f %8.2f %% [%5.2f ; %5.2f]\n", i + 1, classement[i].strategie->nom,
+               classement[i].scoreMoyen, classement[i].demiLargeurScore,
+               100.0 * classement[i].nbVictoires / classement[i].nbParties, 100.0 * bas, 100.0 * haut);
+    }
+
+    printf("\nScore moyen par fichier\n%-10s", "strategie");
+    for (int f = 0; f < nbFichiers; f++) {
+        printf(" %14.14s", nomCourt(fichiers[f]));
+    }
+    printf("\n");
+    for (int i = 0; i < tournoi.nbStrategies; i++) {
+        int s = (int)(classement[i].strategie - tournoi.strategies);
+        printf("%-10s", classement[i].strategie->nom);
+        for (int f = 0; f < nbFichiers; f++) {
+            printf(" %14.2f", moyenneEchantillon(&tournoi.cases[s * nbFichiers + f].scores));
+        }
+        printf("\n");
+    }
+
+    long minimum = travauxParFil[0], maximum = travauxParFil[0];
+    for (int i = 1; i < nbFils; i++) {
+        if (travauxParFil[i] < minimum) minimum = travauxParFil[i];
+        if (travauxParFil[i] > maximum) maximum = travauxParFil[i];
+    }
+    printf("\n%ld travaux sur %d fil(s) (%ld à %ld par fil), %ld vol(s)\n", tournoi.nbTravaux, nbFils, minimum, maximum, tournoi.nbVols);
+    printf("durée : %.3f s, %.0f parties/s, cœurs occupés à %.0f %%\n", duree,
+           (double)tournoi.nbStrategies * nbFichiers * parties / duree, 100.0 * processeur / (duree * nbFils));
+
+    libererTournoi(&tournoi);
+    free(travauxParFil);
+    for (int f = 0; f < nbFichiers; f++) {
+        libererConfiguration(&vagues[f]);
+        if (f >= nbDonnees) remove(fichiers[f]);
+        free(fichiers[f]);
+    }
+    if (nbGenerees > 0) rmdir(dossier);
+}
+
+int main(int argc, char *argv[]){
+    if (argc >= 2 && strcmp(argv[1], "tournoi") == 0) {
+        jouerModeTournoi(argc, argv);
+        libererChaines();
+        viderPools();
+        return 0;
+    }
+
+    ParametresSimulation parametres;
+    parametresSimulationDefaut(&parametres);
+    ConfigurationSimulation configs[2];
+    int nbConfigs = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strchr(argv[i], '=') == NULL) {
+            if (nbConfigs == 2) usage(argv[0]);
+            lireConfiguration(&configs[nbConfigs++], argv[i], argv[0]);
+            continue;
+        }
+        Bool lu = sscanf(argv[i], "victoires=%lf", &parametres.precisionVictoires) == 1
+               || sscanf(argv[i], "score=%lf", &parametres.precisionScore) == 1
+               || sscanf(argv[i], "lot=%d", &parametres.tailleLot) == 1
+               || sscanf(argv[i], "min=%ld", &parametres.nbPartiesMin) == 1
+               || sscanf(argv[i], "max=%ld", &parametres.nbPartiesMax) == 1
+               || sscanf(argv[i], "z=%lf", &parametres.z) == 1
+               || sscanf(argv[i], "graine=%llu", &parametres.graine) == 1
+               || sscanf(argv[i], "fils=%d", &parametres.nbFils) == 1;
+        if (!lu) usage(argv[0]);
+    }
+    if (nbConfigs == 0 || parametres.tailleLot <= 0 || parametres.nbPartiesMax <= 0) usage(argv[0]);
+
+    struct timespec debut, fin;
+    clock_gettime(CLOCK_MONOTONIC, &debut);
+    printf("\n");
+    if (nbConfigs == 1) {
+        ResultatSimulation resultat;
+        simulerConfiguration(&configs[0], &parametres, &resultat);
+        afficherResultat(&configs[0], &resultat, parametres.z);
+        printf("arrêt : %s\n", (resultat.scores.nb < parametres.nbPartiesMax) ? "précision atteinte" : "nombre maximal de parties");
+    } else {
+        ComparaisonSimulation comparaison;
+        comparerConfigurations(&configs[0], &configs[1], &parametres, &comparaison);
+        afficherResultat(&configs[0], &comparaison.a, parametres.z);
+        afficherResultat(&configs[1], &comparaison.b, parametres.z);
+        printf("écart moyen : %.2f ± %.2f point(s) sur les mêmes parties\n",
+               moyenneEchantillon(&comparaison.ecarts), demiLargeurMoyenne(&comparaison.ecarts, parametres.z));
+        if (comparaison.verdict != 0) {
+            const ConfigurationSimulation *meilleure = &configs[(comparaison.verdict > 0) ? 0 : 1];
+            printf("verdict : %s (%s) marque plus\n", meilleure->fichier, meilleure->strategie->nom);
+        } else if (comparaison.ecarts.nb < parametres.nbPartiesMax) {
+            printf("verdict : pas d'écart de plus de %.2f point(s)\n", parametres.precisionScore);
+        } else {
+            printf("verdict : indécis après %ld partie(s)\n", comparaison.ecarts.nb);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &fin);
+    printf("durée : %.3f s\n", (fin.tv_sec - debut.tv_sec) + (fin.tv_nsec - debut.tv_nsec) / 1e9);
+
+    for (int i = 0; i < nbConfigs; i++) {
+        libererConfiguration(&configs[i]);
+    }
+    libererChaines();
+    viderPools();
+    return 0;
+}
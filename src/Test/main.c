@@ -10,10 +10,35 @@
 int main(void){
     testCreerChevalierEtScore();
     testTriBulle();
+    testTriRapide();
     testRechercheDicho();
     testChargementEtSauvegardeChevaliers();
+    testRegistreConcurrent();
+    testClassementFige();
+    testTriEtStatistiquesParalleles();
+    testPageMeilleurs();
+    testRecherchePrefixe();
+    testRangScores();
+    testResumeScores();
+    testRetentionScores();
+    testCompressionScores();
+    testSeparationChevalier();
+    testChainesInternees();
+    testTableauCroissant();
+    testPoolsMaillons();
+    testGenerateur();
+    testInstrumentation();
+    testTrace();
+    testMemoireSousSystemes();
+    testSessionsSansEntree();
+    testHistogrammes();
+    testMetriques();
+    testSimulation();
+    testTournoi();
     testArmesAleatoire();
     testChargement();
     testLireMonstres();
+    libererChaines();
+    viderPools();
     return 0;
 }
\ No newline at end of file
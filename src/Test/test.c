@@ -7,10 +7,16 @@
 
 #include "test.h"
 
+#include <limits.h>
+#include <math.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
 // ----------------------------------------------- Partie Chevalier -----------------------------------------------
 
 void afficherScore(Chevalier chevalier){
-    printf("\nNom : %s\n", chevalier.pseudo);
+    printf("\nNom : %s\n", texteChaine(chevalier.pseudo));
     for (int i = 0; i < chevalier.nbParties; i++) {
         printf("Score %d : %d\n", i + 1, chevalier.firstScore->score);
         chevalier.firstScore = chevalier.firstScore->next;
@@ -58,6 +64,35 @@ void testTriBulle(void){
     libererTableauChevaliers(tableau);
 }
 
+void testTriRapide(void){
+    int nbChevaliers = 0;
+
+    TableauChevaliers *tableau ;
+    tableau = chargerTableauChevaliers(&nbChevaliers);
+
+    printf("\nTest de la fonction triRapide (meilleur score décroissant)\n");
+    triRapideChevaliers(tableau->chevaliers, 0, tableau->nbChevaliers - 1);
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        Chevalier *c = &tableau->chevaliers[i];
+        printf("%s : %d\n", texteChaine(c->pseudo), c->firstScore ? c->firstScore->score : 0);
+    }
+
+    printf("\nTri par nom\n");
+    triBulleTableauChevaliers(tableau);
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        printf("%s\n", texteChaine(tableau->chevaliers[i].pseudo));
+    }
+
+    printf("\nTri par base (égalités dans l'ordre alphabétique)\n");
+    triRadixChevaliers(tableau->chevaliers, tableau->nbChevaliers);
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        Chevalier *c = &tableau->chevaliers[i];
+        printf("%s : %d\n", texteChaine(c->pseudo), c->firstScore ? c->firstScore->score : 0);
+    }
+
+    libererTableauChevaliers(tableau);
+}
+
 void testRechercheDicho(void){
     int nbChevaliers = 0, index, trouve=0 ;
 
@@ -84,7 +119,17 @@ void testChargementEtSauvegardeChevaliers(){
     TableauChevaliers *tableau ;
     tableau = chargerTableauChevaliers(&nbChevaliers);
 
+    // La sauvegarde écrit le fichier binaire, relu à la place du fichier texte importé
+    char *cheminBinaire = cheminDonnees(FICHIER_SCORES_BINAIRE);
+    Bool binaireExistait = access(cheminBinaire, F_OK) == 0;
     sauvegarderTableauChevaliers(tableau);
+    int nbRelus;
+    TableauChevaliers *relu = chargerTableauChevaliers(&nbRelus);
+    printf("Fichier binaire écrit : %s, %d chevalier(s) relu(s) sur %d\n", access(cheminBinaire, F_OK) == 0 ? "oui" : "non", nbRelus, nbChevaliers);
+    libererTableauChevaliers(relu);
+    free(relu);
+    if (!binaireExistait) remove(cheminBinaire);
+    libererMemoire(MEMOIRE_TAMPONS, cheminBinaire);
     printf("\nAffichage du tableau chargé de %d Chevaliers\n", nbChevaliers);
     // Test de la fonction libererListeChevaliers
     for (int i = 0; i < tableau->nbChevaliers; i++) {
@@ -96,6 +141,1254 @@ void testChargementEtSauvegardeChevaliers(){
 
 }
 
+#define NB_FILS_TEST 8
+#define NB_SCORES_PAR_FIL 2000
+
+static void *enregistrerScoresFil(void *arg){
+    RegistreChevaliers *registre = (RegistreChevaliers *)arg;
+    char pseudo[20];
+    for (int i = 0; i < NB_SCORES_PAR_FIL; i++) {
+        sprintf(pseudo, "joueur%d", i % 100);
+        enregistrerScore(registre, pseudo, i % 500);
+    }
+    return NULL;
+}
+
+void testRegistreConcurrent(void){
+    printf("\nTest du registre fragmenté avec %d fils\n", NB_FILS_TEST);
+    RegistreChevaliers *registre = creerRegistre();
+    pthread_t fils[NB_FILS_TEST];
+    StatistiquesChevalier stats;
+    int total = 0;
+
+    for (int i = 0; i < NB_FILS_TEST; i++) {
+        pthread_create(&fils[i], NULL, enregistrerScoresFil, registre);
+    }
+    for (int i = 0; i < NB_FILS_TEST; i++) {
+        pthread_join(fils[i], NULL);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        char pseudo[20];
+        sprintf(pseudo, "joueur%d", i);
+        if (lireStatistiquesRegistre(registre, pseudo, &stats)) {
+            total += stats.nbScores;
+        }
+    }
+    printf("%d chevaliers, %d scores (attendu : 100 chevaliers, %d scores)\n",
+        nombreChevaliersRegistre(registre), total, NB_FILS_TEST * NB_SCORES_PAR_FIL);
+
+    libererRegistre(registre);
+}
+
+void testClassementFige(void){
+    printf("\nTest du classement figé\n");
+    int nbChevaliers = 0;
+    TableauChevaliers *tableau = chargerTableauChevaliers(&nbChevaliers);
+    PublicationClassement publication;
+
+    initialiserPublication(&publication);
+    int lecteur = inscrireLecteur(&publication);
+    publierClassement(&publication, construireClassement(tableau));
+
+    // Le lecteur garde la version 1 pendant qu'une version 2 est publiée
+    const Classement *lu = debutLecture(&publication, lecteur);
+    ajouterScore(&tableau->chevaliers[0], 1000);
+    publierClassement(&publication, construireClassement(tableau));
+    printf("Version lue : %lu, premier par score : %s\n", lu->version, texteChaine(lu->entrees[lu->ordreScores[0]].pseudo));
+    finLecture(&publication, lecteur);
+
+    lu = debutLecture(&publication, lecteur);
+    afficherClassementScores(lu, true, tableau);
+    finLecture(&publication, lecteur);
+
+    desinscrireLecteur(&publication, lecteur);
+    libererPublication(&publication);
+    libererTableauChevaliers(tableau);
+}
+
+void testTriEtStatistiquesParalleles(void){
+    printf("\nTest du tri et des statistiques en parallèle\n");
+    TableauChevaliers *serie = creerTableauChevaliers(0);
+    TableauChevaliers *parallele = creerTableauChevaliers(0);
+    PoolThreads *pool = creerPool(4);
+    char pseudo[20];
+    int differences = 0;
+
+    srand(42);
+    for (int i = 0; i < 50000; i++) {
+        sprintf(pseudo, "j%d", rand() % 100000);
+        Chevalier a = creerChevalier(pseudo), b = creerChevalier(pseudo);
+        for (int j = rand() % 4; j > 0; j--) {
+            int score = (rand() % 50) * 10;
+            ajouterScore(&a, score);
+            ajouterScore(&b, score);
+        }
+        ajouterChevalier(serie, a);
+        ajouterChevalier(parallele, b);
+    }
+
+    triRadixChevaliers(serie->chevaliers, serie->nbChevaliers);
+    triParalleleChevaliers(pool, parallele);
+    for (int i = 0; i < serie->nbChevaliers; i++) {
+        if (serie->chevaliers[i].pseudo != parallele->chevaliers[i].pseudo) differences++;
+    }
+    printf("Tri par score : %d différence(s)\n", differences);
+
+    StatistiquesChevalier *stats = malloc(parallele->nbChevaliers * sizeof(StatistiquesChevalier));
+    StatistiquesChevalier attendu;
+    differences = 0;
+    calculerStatistiquesParalleles(pool, parallele, stats);
+    for (int i = 0; i < parallele->nbChevaliers; i++) {
+        calculerStatistiques(&parallele->chevaliers[i], &attendu);
+        if (memcmp(&attendu, &stats[i], sizeof(attendu)) != 0) differences++;
+    }
+    printf("Statistiques : %d différence(s)\n", differences);
+
+    free(stats);
+    detruirePool(pool);
+    libererTableauChevaliers(serie);
+    libererTableauChevaliers(parallele);
+    free(serie);
+    free(parallele);
+}
+
+void testPageMeilleurs(void){
+    printf("\nTest de la sélection des meilleurs par tas\n");
+    TableauChevaliers *tableau = creerTableauChevaliers(0);
+    CleTri page[20];
+    char pseudo[20];
+    int differences = 0;
+
+    srand(7);
+    for (int i = 0; i < 100000; i++) {
+        sprintf(pseudo, "j%d", i);
+        Chevalier chevalier = creerChevalier(pseudo);
+        ajouterScore(&chevalier, (rand() % 100) * 10);
+        ajouterChevalier(tableau, chevalier);
+    }
+
+    // La page 3 (20 par page) doit correspondre aux rangs 41 à 60 du tri complet
+    int nb = selectionnerMeilleurs(tableau, 20, 40, page);
+    CleTri *cles = malloc(tableau->nbChevaliers * sizeof(CleTri));
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        cles[i].cle = cleScore(&tableau->chevaliers[i]);
+        cles[i].index = i;
+    }
+    triRadixCles(cles, tableau->nbChevaliers);
+    for (int i = 0; i < nb; i++) {
+        if (cles[40 + i].index != page[i].index) differences++;
+    }
+    printf("%d ligne(s), %d différence(s) avec le tri complet\n", nb, differences);
+    afficherPageMeilleurs(tableau, 5, 0);
+
+    free(cles);
+    libererTableauChevaliers(tableau);
+    free(tableau);
+}
+
+void testRecherchePrefixe(void){
+    printf("\nTest de la recherche par préfixe\n");
+    TableauChevaliers *tableau = creerTableauChevaliers(0);
+    char pseudo[20];
+    int resultats[10];
+    int erreurs = 0;
+
+    for (int i = 0; i < 50000; i++) {
+        sprintf(pseudo, "j%d", i);
+        Chevalier chevalier = creerChevalier(pseudo);
+        ajouterScore(&chevalier, i % 1000);
+        ajouterChevalier(tableau, chevalier);
+    }
+    IndexPseudos *index = indexerTableau(tableau);
+
+    // Recherche exacte
+    if (chercherPseudo(index, "j4242") != 4242) erreurs++;
+    if (chercherPseudo(index, "j424242") != -1) erreurs++;
+    if (chercherPseudo(index, "j") != -1) erreurs++;
+
+    // "j12", "j120" à "j129", "j1200" à "j1299" et "j12000" à "j12999" : 1111 pseudos
+    int total = compterPrefixe(index, "j12");
+    int nb = chercherPrefixe(index, "j12", 10, 0, resultats);
+    if (total != 1111 || nb != 10 || tableau->chevaliers[resultats[0]].pseudo != chercherChaine("j12")
+        || tableau->chevaliers[resultats[1]].pseudo != chercherChaine("j120")) erreurs++;
+
+    // La dernière page doit finir sur le plus grand pseudo dans l'ordre alphabétique
+    nb = chercherPrefixe(index, "j12", 10, 1110, resultats);
+    if (nb != 1 || tableau->chevaliers[resultats[0]].pseudo != chercherChaine("j12999")) erreurs++;
+
+    printf("%d pseudo(s) commencent par j12, %d erreur(s)\n", total, erreurs);
+    afficherRecherchePrefixe(index, tableau, "j4999", 5, 0);
+
+    libererIndexPseudos(index);
+    libererTableauChevaliers(tableau);
+    free(tableau);
+}
+
+/* Nombre de scores de l'arbre inférieurs ou égaux à un score */
+static int compterScoresInferieursOuEgaux(int score){
+    return nombreScores() - compterScoresSuperieurs(score + 1);
+}
+
+/* Vérifie qu'un centile est le plus petit score qui couvre au moins centile % des scores */
+static Bool centileValide(double centile){
+    int score = scoreCentile(centile);
+    double cible = centile * nombreScores() / 100.0;
+    if (cible < 1) cible = 1;
+    return compterScoresInferieursOuEgaux(score) >= cible && (score == 0 || compterScoresInferieursOuEgaux(score - 1) < cible);
+}
+
+void testRangScores(void){
+    printf("\nTest du rang et des centiles des scores\n");
+    TableauChevaliers *tableau = creerTableauChevaliers(0);
+    char pseudo[20];
+    int erreurs = 0;
+
+    // Les scores laissés par les tests précédents sont comptés à part
+    int avant = nombreScores();
+    int superieurs900 = compterScoresSuperieurs(900), rang999 = rangScore(999), rang998 = rangScore(998);
+
+    // 10 000 scores : chaque valeur de 0 à 999 jouée 10 fois
+    for (int i = 0; i < 1000; i++) {
+        sprintf(pseudo, "r%d", i);
+        Chevalier chevalier = creerChevalier(pseudo);
+        for (int j = 0; j < 10; j++) {
+            ajouterScore(&chevalier, i);
+        }
+        ajouterChevalier(tableau, chevalier);
+    }
+
+    if (nombreScores() - avant != 10000) erreurs++;
+    if (compterScoresSuperieurs(900) - superieurs900 != 1000) erreurs++;
+    if (rangScore(999) - rang999 != 0 || rangScore(998) - rang998 != 10) erreurs++;
+    if (!centileValide(0) || !centileValide(50) || !centileValide(90) || !centileValide(100)) erreurs++;
+    if (avant == 0 && (scoreCentile(50) != 499 || scoreCentile(100) != 999 || scoreCentile(0) != 0)) erreurs++;
+    printf("Médiane : %d, 90e centile : %d, rang de 500 : %d, %d erreur(s)\n", scoreCentile(50), scoreCentile(90), rangScore(500), erreurs);
+    afficherRangChevalier(&tableau->chevaliers[750]);
+    libererTableauChevaliers(tableau);
+    if (nombreScores() != avant) erreurs++;
+
+    // 30 scores par chevalier : la rétention en compacte jusqu'à 10, qui restent comptés au milieu de leur classe.
+    // Les classes de l'histogramme s'arrêtent aux puissances de 2 : le compte au-dessus de 512 reste exact
+    int superieurs512 = compterScoresSuperieurs(512), rang511 = rangScore(511);
+    int vraisSuperieurs = 0;
+    for (int i = 0; i < 200; i++) {
+        sprintf(pseudo, "s%d", i);
+        Chevalier chevalier = creerChevalier(pseudo);
+        for (int j = 0; j < 30; j++) {
+            int score = (j * 37 + i * 11) % 1000;
+            if (score >= 512) vraisSuperieurs++;
+            ajouterScore(&chevalier, score);
+        }
+        ajouterChevalier(tableau, chevalier);
+    }
+    int nbCompactes = 0;
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        int nbMaillons = 0;
+        for (MaillonScore *m = tableau->chevaliers[i].firstScore; m != NULL; m = m->next) nbMaillons++;
+        if (nbMaillons > RETENTION_MEILLEURS + RETENTION_DERNIERS) erreurs++;
+        nbCompactes += tableau->chevaliers[i].historique->compactes.nbScores;
+    }
+    if (nbCompactes == 0) erreurs++;
+    if (nombreScores() - avant != 6000) erreurs++;
+    if (rangScore(511) - rang511 != vraisSuperieurs) erreurs++;
+    if (compterScoresSuperieurs(512) - superieurs512 != vraisSuperieurs) erreurs++;
+    if (!centileValide(50) || !centileValide(99)) erreurs++;
+    printf("%d scores pour 200 chevaliers de 30 parties (%d compactés), rang de 511 : %d, %d erreur(s)\n", nombreScores() - avant, nbCompactes, rangScore(511), erreurs);
+
+    // Les scores libérés sortent de l'arbre, compactés compris
+    libererTableauChevaliers(tableau);
+    if (nombreScores() != avant) erreurs++;
+    printf("Scores restants après libération : %d, %d erreur(s)\n", nombreScores() - avant, erreurs);
+    free(tableau);
+}
+
+static int comparerEntiers(const void *a, const void *b){
+    return *(const int *)a - *(const int *)b;
+}
+
+void testResumeScores(void){
+    printf("\nTest du résumé des scores (quantiles)\n");
+    Chevalier petit = creerChevalier("Petit");
+    Chevalier grand = creerChevalier("Grand");
+    StatistiquesChevalier stats;
+    int *scores = malloc(20000 * sizeof(int));
+    int erreurs = 0;
+
+    // Peu de scores distincts : les quantiles sont exacts
+    int valeurs[] = {5, 1, 9, 3, 7, 3, 8, 2, 6, 4};
+    for (int i = 0; i < 10; i++) {
+        ajouterScore(&petit, valeurs[i]);
+    }
+    calculerStatistiques(&petit, &stats);
+    if (stats.mediane != 4 || stats.centile90 != 8 || stats.centile99 != 9 || stats.moinsBonScore != 1) erreurs++;
+    printf("Petit : médiane %.1f, 90e centile %.1f, %d erreur(s)\n", stats.mediane, stats.centile90, erreurs);
+
+    // Beaucoup de scores : on compare l'estimation aux vrais quantiles
+    srand(11);
+    for (int i = 0; i < 20000; i++) {
+        scores[i] = rand() % 10000;
+        ajouterScore(&grand, scores[i]);
+    }
+    qsort(scores, 20000, sizeof(int), comparerEntiers);
+    calculerStatistiques(&grand, &stats);
+    printf("Grand : %d centroïdes, médiane %.0f (exacte %d), 90e %.0f (exact %d), 99e %.0f (exact %d)\n",
+           grand.historique->resume.nbCentroides, stats.mediane, scores[9999], stats.centile90, scores[17999], stats.centile99, scores[19799]);
+    afficherStatistiques(&petit);
+
+    free(scores);
+    libererScores(&petit);
+    libererScores(&grand);
+}
+
+void testRetentionScores(void){
+    printf("\nTest de la politique de rétention des scores\n");
+    Chevalier chevalier = creerChevalier("Assidu");
+    StatistiquesChevalier stats;
+    int scores[1000];
+    long long somme = 0;
+    int min = INT_MAX, max = 0, nbMaillons = 0, erreurs = 0;
+    int avant = nombreScores(), superieursAvant = compterScoresSuperieurs(2048), superieurs = 0;
+    StatistiquesMemoire memoire, memoireApres;
+
+    definirRetention(3, 2);
+    srand(5);
+    for (int i = 0; i < 1000; i++) {
+        scores[i] = rand() % 5000;
+        somme += scores[i];
+        if (scores[i] < min) min = scores[i];
+        if (scores[i] > max) max = scores[i];
+        if (scores[i] >= 2048) superieurs++;
+        ajouterScore(&chevalier, scores[i]);
+    }
+
+    // Au plus 3 meilleurs + 2 derniers maillons, les 2 derniers scores sont dedans
+    Bool avantDernier = false, dernier = false;
+    for (MaillonScore *m = chevalier.firstScore; m != NULL; m = m->next) {
+        nbMaillons++;
+        if (m->numero == 999) avantDernier = (m->score == scores[998]);
+        if (m->numero == 1000) dernier = (m->score == scores[999]);
+    }
+    if (nbMaillons > 5 || !avantDernier || !dernier) erreurs++;
+    if (chevalier.historique->compactes.nbScores + nbMaillons != 1000) erreurs++;
+
+    // Les scores compactés restent comptés dans l'arbre au milieu de leur classe : exact aux puissances de 2
+    if (nombreScores() - avant != 1000 || compterScoresSuperieurs(2048) - superieursAvant != superieurs) erreurs++;
+
+    // Les statistiques restent exactes
+    calculerStatistiques(&chevalier, &stats);
+    if (stats.nbScores != 1000 || stats.meilleurScore != max || stats.moinsBonScore != min
+        || stats.scoreMoyen != (float)somme / 1000) erreurs++;
+    printf("%d maillon(s), %d score(s) compacté(s), %d erreur(s)\n", nbMaillons, chevalier.historique->compactes.nbScores, erreurs);
+    afficherStatistiques(&chevalier);
+
+    // 9000 parties de plus : la mémoire du chevalier ne grandit pas (au plus un maillon d'écart)
+    lireMemoire(MEMOIRE_SCORES, &memoire);
+    for (int i = 0; i < 9000; i++) {
+        int score = rand() % 5000;
+        if (score >= 2048) superieurs++;
+        ajouterScore(&chevalier, score);
+    }
+    lireMemoire(MEMOIRE_SCORES, &memoireApres);
+    if (memoireApres.octetsVivants - memoire.octetsVivants > (long long)sizeof(MaillonScore)) erreurs++;
+    if (nombreScores() - avant != 10000 || compterScoresSuperieurs(2048) - superieursAvant != superieurs) erreurs++;
+    printf("Mémoire des scores après 10000 parties : %+lld octet(s), %d erreur(s)\n", memoireApres.octetsVivants - memoire.octetsVivants, erreurs);
+
+    definirRetention(RETENTION_MEILLEURS, RETENTION_DERNIERS);
+    libererScores(&chevalier);
+    if (nombreScores() != avant) erreurs++;
+    printf("Scores restants après libération : %d, %d erreur(s)\n", nombreScores() - avant, erreurs);
+}
+
+void testCompressionScores(void){
+    printf("\nTest de la compression des scores\n");
+    TableauChevaliers *tableau = creerTableauChevaliers(0);
+    char pseudo[20];
+    long nbMaillons = 0, octets = 0;
+    int differences = 0, nbRelus;
+
+    srand(3);
+    for (int i = 0; i < 20000; i++) {
+        sprintf(pseudo, "c%d", i);
+        Chevalier chevalier = creerChevalier(pseudo);
+        for (int j = rand() % 40; j > 0; j--) {
+            ajouterScore(&chevalier, rand() % 3000);
+        }
+        ajouterChevalier(tableau, chevalier);
+    }
+
+    // Mémoire des maillons (avec l'en-tête de malloc) comparée aux blocs compressés
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        for (MaillonScore *m = tableau->chevaliers[i].firstScore; m != NULL; m = m->next) nbMaillons++;
+    }
+    StatistiquesChevalier *avant = malloc(tableau->nbChevaliers * sizeof(StatistiquesChevalier));
+    int *meilleurs = malloc(tableau->nbChevaliers * sizeof(int));
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        calculerStatistiques(&tableau->chevaliers[i], &avant[i]);
+        meilleurs[i] = meilleurScoreChevalier(&tableau->chevaliers[i]);
+    }
+    compresserTableau(tableau);
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        octets += tableau->chevaliers[i].tailleCompresses;
+    }
+    printf("%ld scores : %ld octets en maillons, %ld octets compressés\n", nbMaillons, nbMaillons * (long)(sizeof(MaillonScore) + 16), octets);
+
+    // Aller-retour par le fichier binaire
+    sauvegarderTableauBinaire(tableau, "src/fichier/scores_test.bin");
+    TableauChevaliers *relu = chargerTableauBinaire("src/fichier/scores_test.bin", &nbRelus);
+    remove("src/fichier/scores_test.bin");
+    for (int i = 0; i < nbRelus; i++) {
+        StatistiquesChevalier apres;
+        Chevalier *chevalier = &relu->chevaliers[i];
+        calculerStatistiques(chevalier, &apres);
+        if (memcmp(&apres, &avant[i], sizeof(apres)) != 0 || meilleurScoreChevalier(chevalier) != meilleurs[i]) differences++;
+
+        // Une nouvelle partie décompresse le chevalier
+        ajouterScore(chevalier, 1);
+        if (chevalier->scoresCompresses != NULL || chevalier->nbParties != avant[i].nbScores + 1) differences++;
+    }
+    printf("%d chevalier(s) relu(s), %d différence(s)\n", nbRelus, differences);
+
+    free(avant);
+    free(meilleurs);
+    libererTableauChevaliers(tableau);
+    libererTableauChevaliers(relu);
+    free(tableau);
+    free(relu);
+}
+
+void testSeparationChevalier(void){
+    printf("\nTest de la séparation des données d'un chevalier\n");
+    TableauChevaliers *tableau = creerTableauChevaliers(0);
+    char pseudo[20];
+    int erreurs = 0;
+
+    srand(5);
+    for (int i = 0; i < 10000; i++) {
+        sprintf(pseudo, "s%d", i);
+        Chevalier chevalier = creerChevalier(pseudo);
+        int meilleur = 0;
+        for (int j = (i % 2 == 0) ? 0 : 1 + rand() % 30; j > 0; j--) {
+            int score = rand() % 5000;
+            if (score > meilleur || chevalier.nbParties == 0) meilleur = score;
+            ajouterScore(&chevalier, score);
+        }
+        if (chevalier.meilleurScore != meilleur) erreurs++;
+        ajouterChevalier(tableau, chevalier);
+    }
+
+    // Seuls les chevaliers qui ont joué ont un historique, le meilleur score reste lisible une fois compressés
+    compresserTableau(tableau);
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        Chevalier *chevalier = &tableau->chevaliers[i];
+        if ((chevalier->historique == NULL) != (chevalier->nbParties == 0)) erreurs++;
+        if (chevalier->nbParties > 0 && chevalier->historique->resume.max != meilleurScoreChevalier(chevalier)) erreurs++;
+    }
+    printf("Chevalier : %zu octets, historique à part : %zu octets, combattant : %zu octets\n", sizeof(Chevalier), sizeof(HistoriqueScores),
+           sizeof(Combattant));
+
+    printf("%d erreur(s)\n", erreurs);
+
+    libererTableauChevaliers(tableau);
+    free(tableau);
+}
+
+void testChainesInternees(void){
+    printf("\nTest de la table des chaînes internées\n");
+    char texte[20];
+    int erreurs = 0;
+    int avant = nombreChaines();
+
+    // Chaque pseudo est interné deux fois : le second appel rend le même identifiant
+    for (int i = 0; i < 5000; i++) {
+        sprintf(texte, "interne%d", i);
+        IdChaine id = internerChaine(texte);
+        if (internerChaine(texte) != id || strcmp(texteChaine(id), texte) != 0) erreurs++;
+        if (hachageChaine(id) != hacherChaine(texte)) erreurs++;
+    }
+    if (nombreChaines() - avant != 5000) erreurs++;
+    if (chercherChaine("jamais interné") != CHAINE_INCONNUE || internerChaine("") != CHAINE_VIDE) erreurs++;
+
+    // Deux chevaliers au pseudo trop long partagent le même pseudo raccourci
+    Chevalier a = creerChevalier("abcdefghijabcdefghijabcdefghijabcdefghijXYZ");
+    Chevalier b = creerChevalier("abcdefghijabcdefghijabcdefghijabcdefghij");
+    if (a.pseudo != b.pseudo) erreurs++;
+
+    // Les monstres du même nom partagent leur nom
+    Monstre *m1 = creerMonstre("Dragonus", 1), *m2 = creerMonstre("Dragonus", 3);
+    if (m1->nom != m2->nom || strcmp(texteChaine(m1->nom), "Dragonus") != 0) erreurs++;
+    libererMonstre(m1);
+    libererMonstre(m2);
+
+    printf("%d chaîne(s), %zu octet(s) de texte, %d erreur(s)\n", nombreChaines(), tailleAreneChaines(), erreurs);
+}
+
+void testTableauCroissant(void){
+    printf("\nTest des ajouts et suppressions groupés dans un tableau de chevaliers\n");
+    TableauChevaliers *tableau = creerTableauChevaliers(0);
+    Chevalier *lot = malloc(1000 * sizeof(Chevalier));
+    int *indices = malloc(1000 * sizeof(int));
+    char pseudo[20];
+    int erreurs = 0, nbReallocations = 0;
+
+    // Un ajout à la fois : la capacité double, le nombre de réallocations reste logarithmique
+    for (int i = 0; i < 100000; i++) {
+        int capacite = tableau->capacite;
+        sprintf(pseudo, "g%d", i);
+        ajouterChevalier(tableau, creerChevalier(pseudo));
+        if (tableau->capacite != capacite) nbReallocations++;
+    }
+    if (nbReallocations > 20) erreurs++;
+
+    // Un lot de 1000 d'un coup, puis un indice sur trois retiré (avec doublons et dans le désordre)
+    for (int i = 0; i < 1000; i++) {
+        sprintf(pseudo, "lot%d", i);
+        lot[i] = creerChevalier(pseudo);
+    }
+    ajouterChevaliers(tableau, lot, 1000);
+    int nb = 0;
+    for (int i = tableau->nbChevaliers - 1; i >= 0 && nb < 1000; i -= 3) {
+        indices[nb++] = i;
+    }
+    indices[nb - 1] = indices[0];
+    int supprimes = supprimerChevaliers(tableau, indices, nb);
+    if (supprimes != nb - 1 || tableau->nbChevaliers != 101000 - supprimes) erreurs++;
+    for (int i = 1; i < tableau->nbChevaliers; i++) {
+        // Les « g » restent dans l'ordre d'ajout et précèdent les « lot »
+        if (texteChaine(tableau->chevaliers[i - 1].pseudo)[0] == 'l' && texteChaine(tableau->chevaliers[i].pseudo)[0] == 'g') erreurs++;
+    }
+
+    // La réserve annoncée évite toute réallocation
+    TableauChevaliers *reserve = creerTableauChevaliers(5000);
+    Chevalier *debut = reserve->chevaliers;
+    for (int i = 0; i < 5000; i++) {
+        ajouterChevalier(reserve, lot[i % 1000]);
+    }
+    if (reserve->chevaliers != debut || reserve->capacite != 5000) erreurs++;
+
+    printf("%d réallocation(s) pour 100000 ajouts, %d supprimé(s), %d erreur(s)\n", nbReallocations, supprimes, erreurs);
+
+    // Les chevaliers sans score n'ont rien à libérer
+    free(lot);
+    free(indices);
+    libererTableauChevaliers(tableau);
+    libererTableauChevaliers(reserve);
+    free(tableau);
+    free(reserve);
+}
+
+/* Fil du test des pools : alloue et rend des maillons, dont la moitié allouée par le fil voisin */
+static void *echangerMaillonsFil(void *arg){
+    void **objets = (void **)arg;
+    for (int tour = 0; tour < 10; tour++) {
+        for (int i = 0; i < 10000; i++) {
+            objets[i] = allouerDansPool(sizeof(MaillonScore));
+        }
+        for (int i = 9999; i >= 0; i--) {
+            libererDansPool(objets[i], sizeof(MaillonScore));
+        }
+    }
+    for (int i = 0; i < 10000; i++) {
+        objets[i] = allouerDansPool(sizeof(MaillonScore));
+    }
+    return NULL;
+}
+
+static void *rendreMaillonsFil(void *arg){
+    void **objets = (void **)arg;
+    for (int i = 0; i < 10000; i++) {
+        libererDansPool(objets[i], sizeof(MaillonScore));
+    }
+    return NULL;
+}
+
+/* Fil du test des pools : rend quelques maillons, trop peu pour remplir son cache */
+static void *rendreQuelquesMaillonsFil(void *arg){
+    void **objets = (void **)arg;
+    for (int i = 0; i < 10; i++) {
+        libererDansPool(objets[i], sizeof(MaillonScore));
+    }
+    return NULL;
+}
+
+void testPoolsMaillons(void){
+    printf("\nTest des pools de maillons\n");
+    int classe = (int)((sizeof(MaillonScore) - 1) / PAS_CLASSES_POOL);
+    Chevalier *chevaliers = malloc(2000 * sizeof(Chevalier));
+    char pseudo[20];
+    StatistiquesPool avant, pendant, apres;
+    int erreurs = 0;
+
+    // 2000 chevaliers de 5 scores : 10000 maillons, rendus à la libération
+    statistiquesPool(classe, &avant);
+    for (int i = 0; i < 2000; i++) {
+        sprintf(pseudo, "pool%d", i);
+        chevaliers[i] = creerChevalier(pseudo);
+        for (int j = 0; j < 5; j++) {
+            ajouterScore(&chevaliers[i], (i * 7 + j * 13) % 500);
+        }
+    }
+    statistiquesPool(classe, &pendant);
+    if (pendant.nbUtilises - avant.nbUtilises != 10000) erreurs++;
+    for (int i = 0; i < 2000; i++) {
+        libererScores(&chevaliers[i]);
+    }
+    statistiquesPool(classe, &apres);
+    if (apres.nbUtilises != avant.nbUtilises) erreurs++;
+
+    // Les maillons sont recyclés : le même travail ne demande aucun nouveau bloc
+    for (int i = 0; i < 2000; i++) {
+        for (int j = 0; j < 5; j++) {
+            ajouterScore(&chevaliers[i], j);
+        }
+        libererScores(&chevaliers[i]);
+    }
+    statistiquesPool(classe, &apres);
+    if (apres.nbBlocs != pendant.nbBlocs) erreurs++;
+    afficherStatistiquesPools();
+
+    // Les maillons de monstres partagent la même classe de taille
+    PileMonstre pile = creerPile();
+    for (int i = 0; i < 1000; i++) {
+        pile = pushPile(pile, creerMonstre("Gobelin", 1));
+    }
+    statistiquesPool(classe, &pendant);
+    if ((int)((sizeof(MaillonMonstre) - 1) / PAS_CLASSES_POOL) == classe && pendant.nbUtilises - apres.nbUtilises != 1000) erreurs++;
+    libererVague1(pile);
+
+    // Deux fils s'échangent des maillons : tout revient aux classes à la fin des fils
+    void **objets = malloc(2 * 10000 * sizeof(void *));
+    pthread_t fils[2];
+    for (int i = 0; i < 2; i++) {
+        pthread_create(&fils[i], NULL, echangerMaillonsFil, objets + i * 10000);
+    }
+    for (int i = 0; i < 2; i++) {
+        pthread_join(fils[i], NULL);
+    }
+    for (int i = 0; i < 2; i++) {
+        pthread_create(&fils[i], NULL, rendreMaillonsFil, objets + (1 - i) * 10000);
+    }
+    for (int i = 0; i < 2; i++) {
+        pthread_join(fils[i], NULL);
+    }
+    statistiquesPool(classe, &pendant);
+    if (pendant.nbUtilises != avant.nbUtilises) erreurs++;
+    if (pendant.nbLibres + pendant.nbEnCache + pendant.nbUtilises != pendant.nbObjets) erreurs++;
+
+    // Un fil qui ne fait que rendre quelques maillons les rend aussi à la classe en se terminant
+    for (int i = 0; i < 10; i++) {
+        objets[i] = allouerDansPool(sizeof(MaillonScore));
+    }
+    pthread_create(&fils[0], NULL, rendreQuelquesMaillonsFil, objets);
+    pthread_join(fils[0], NULL);
+    statistiquesPool(classe, &pendant);
+    if (pendant.nbUtilises != avant.nbUtilises) erreurs++;
+    if (pendant.nbLibres + pendant.nbEnCache + pendant.nbUtilises != pendant.nbObjets) erreurs++;
+
+    printf("%ld bloc(s), %ld maillon(s) utilisé(s) à la fin, %d erreur(s)\n", pendant.nbBlocs, pendant.nbUtilises, erreurs);
+
+    free(objets);
+    free(chevaliers);
+}
+
+void testGenerateur(void){
+    printf("\nTest du générateur de fichiers synthétiques\n");
+    ParametresScores parametres;
+    parametresScoresDefaut(&parametres);
+    parametres.nbChevaliers = 3000;
+    parametres.longueurMin = 1;
+    parametres.longueurMax = 6;
+    parametres.nbPartiesMin = 0;
+    parametres.nbPartiesMax = 40;
+    parametres.asymetrie = 2;
+    parametres.nbValeursScores = 5;
+    parametres.graine = 42;
+    int erreurs = 0, nb, nbParties = 0;
+
+    // Le fichier généré est lisible par le jeu et respecte les bornes demandées
+    genererFichierScores("/tmp/test_generateur.txt", &parametres);
+    TableauChevaliers *tableau = chargerTableauTexte("/tmp/test_generateur.txt", &nb);
+    if (nb != 3000 || tableau->nbChevaliers != 3000) erreurs++;
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        Chevalier *chevalier = &tableau->chevaliers[i];
+        int longueur = (int)strlen(texteChaine(chevalier->pseudo));
+        // 3000 numéros demandent 3 chiffres en base 36 : les pseudos plus courts sont allongés
+        if (longueur < 3 || longueur > 6 || chevalier->nbParties > 40) erreurs++;
+        if (chevalier->meilleurScore % 500 != 0) erreurs++;
+        nbParties += chevalier->nbParties;
+    }
+
+    // Pseudos tous différents
+    triBulleTableauChevaliers(tableau);
+    for (int i = 1; i < tableau->nbChevaliers; i++) {
+        if (tableau->chevaliers[i].pseudo == tableau->chevaliers[i - 1].pseudo) erreurs++;
+    }
+
+    // L'asymétrie resserre les nombres de parties vers le minimum (moyenne 40 / 4 au lieu de 20)
+    if (nbParties / 3000 < 7 || nbParties / 3000 > 13) erreurs++;
+
+    // La même graine redonne le même fichier, une autre graine un autre
+    genererFichierScores("/tmp/test_generateur2.txt", &parametres);
+    parametres.graine = 43;
+    genererFichierScores("/tmp/test_generateur3.txt", &parametres);
+    FILE *a = fopen("/tmp/test_generateur.txt", "r"), *b = fopen("/tmp/test_generateur2.txt", "r"), *c = fopen("/tmp/test_generateur3.txt", "r");
+    int ca, cb, cc, memes = 1, differents = 0;
+    do {
+        ca = fgetc(a);
+        cb = fgetc(b);
+        cc = fgetc(c);
+        if (ca != cb) memes = 0;
+        if (ca != cc) differents = 1;
+    } while (ca != EOF && cb != EOF);
+    fclose(a);
+    fclose(b);
+    fclose(c);
+    if (!memes || !differents) erreurs++;
+
+    // Vagues : les nombres de monstres et les poids des niveaux sont respectés
+    ParametresVagues vagues;
+    parametresVaguesDefaut(&vagues);
+    vagues.nbMonstresVague1 = 7;
+    vagues.nbMonstresVague2 = 500;
+    vagues.poidsNiveaux[0] = 0;
+    vagues.poidsNiveaux[2] = 0;
+    genererFichierVagues("/tmp/test_generateur_vagues.txt", &vagues);
+    PileMonstre vague1 = creerPile();
+    FileMonstre vague2 = creerFileMonstre();
+    lireMonstresFichier("/tmp/test_generateur_vagues.txt", &vague1, &vague2);
+    int nb1 = 0, nb2 = 0;
+    for (MaillonMonstre *m = vague1; m != NULL; m = m->suiv) {
+        if (m->monstre->niveau != 2) erreurs++;
+        nb1++;
+    }
+    for (MaillonMonstre *m = vague2.tete; m != NULL; m = m->suiv) {
+        if (m->monstre->niveau != 2) erreurs++;
+        nb2++;
+    }
+    if (nb1 != 7 || nb2 != 500) erreurs++;
+
+    printf("%d chevalier(s), %d partie(s), %d + %d monstre(s), %d erreur(s)\n", nb, nbParties, nb1, nb2, erreurs);
+
+    libererVague1(vague1);
+    libererVague2(vague2);
+    libererTableauChevaliers(tableau);
+    free(tableau);
+    remove("/tmp/test_generateur.txt");
+    remove("/tmp/test_generateur2.txt");
+    remove("/tmp/test_generateur3.txt");
+    remove("/tmp/test_generateur_vagues.txt");
+}
+
+void testInstrumentation(void){
+    printf("\nTest des mesures des chemins critiques\n");
+    int erreurs = 0, nb, trouve;
+    StatistiquesMesure stats;
+
+    ParametresScores parametres;
+    parametresScoresDefaut(&parametres);
+    parametres.nbChevaliers = 500;
+    genererFichierScores("/tmp/test_instrumentation.txt", &parametres);
+
+    reinitialiserMesures();
+    TableauChevaliers *tableau = chargerTableauTexte("/tmp/test_instrumentation.txt", &nb);
+    triBulleTableauChevaliers(tableau);
+    triRadixChevaliers(tableau->chevaliers, tableau->nbChevaliers);
+    triBulleTableauChevaliers(tableau);
+    char pseudo[LONGUEUR_MAX_PSEUDO + 1];
+    strcpy(pseudo, texteChaine(tableau->chevaliers[10].pseudo));
+    rechDichotomiqueJoueur(tableau, pseudo, &trouve);
+    if (!trouve) erreurs++;
+    rechDichotomiqueJoueur(tableau, "pseudo-absent", &trouve);
+    if (trouve) erreurs++;
+    IndexPseudos *index = indexerTableau(tableau);
+    if (chercherPseudo(index, texteChaine(tableau->chevaliers[20].pseudo)) != 20) erreurs++;
+    Classement *classement = construireClassement(tableau);
+    sauvegarderTableauTexte(tableau, "/tmp/test_instrumentation.txt");
+
+#ifdef INSTRUMENTATION
+    // Chaque appel compte une fois, les tris vides ou d'un seul élément ne comptent pas
+    int attendus[NB_POINTS_MESURE] = {1, 1, 3, 1, 3, 0, 0, 0, 0, 0};
+    for (int i = 0; i < NB_POINTS_MESURE; i++) {
+        lireMesure(i, &stats);
+        if (stats.nb != attendus[i] || stats.maxNs > stats.totalNs || (stats.nb > 0 && stats.totalNs <= 0)) erreurs++;
+    }
+    triRadixChevaliers(tableau->chevaliers, 1);
+    lireMesure(MESURE_TRI, &stats);
+    if (stats.nb != 3) erreurs++;
+#else
+    // Sans instrumentation, les macros ne laissent aucun compteur
+    for (int i = 0; i < NB_POINTS_MESURE; i++) {
+        lireMesure(i, &stats);
+        if (stats.nb != 0) erreurs++;
+    }
+#endif
+    afficherMesures(stdout);
+
+    reinitialiserMesures();
+    lireMesure(MESURE_TRI, &stats);
+    if (stats.nb != 0 || stats.totalNs != 0 || stats.maxNs != 0) erreurs++;
+    printf("%d erreur(s)\n", erreurs);
+
+    libererClassement(classement);
+    libererIndexPseudos(index);
+    libererTableauChevaliers(tableau);
+    free(tableau);
+    remove("/tmp/test_instrumentation.txt");
+}
+
+void testTrace(void){
+    printf("\nTest de la trace d'une session\n");
+    int erreurs = 0, nbTaches = 0, nbTest = 0, nbLignes = 0, filsTaches = 0;
+    char ligne[256];
+
+    ParametresScores parametres;
+    parametresScoresDefaut(&parametres);
+    parametres.nbChevaliers = 5000;
+    genererFichierScores("/tmp/test_trace.txt", &parametres);
+    int nb;
+    TableauChevaliers *tableau = chargerTableauTexte("/tmp/test_trace.txt", &nb);
+    PoolThreads *pool = creerPool(3);
+
+    if (terminerTrace() != -1) erreurs++;
+    demarrerTrace("/tmp/test_trace.json");
+    triParalleleChevaliers(pool, tableau);
+    detruirePool(pool);
+
+    // L'anneau du fil principal ne garde que les derniers événements
+    for (int i = 0; i < TAILLE_ANNEAU_TRACE + 5; i++) {
+        long long t = horlogeMesure();
+        tracerEvenement("test", t, t + 1000);
+    }
+    long nbEvenements = terminerTrace();
+    if (terminerTrace() != -1) erreurs++;
+
+    FILE *fichier = fopen("/tmp/test_trace.json", "r");
+    if (fgets(ligne, sizeof(ligne), fichier) == NULL || strcmp(ligne, "{\"traceEvents\":[\n") != 0) erreurs++;
+    while (fgets(ligne, sizeof(ligne), fichier) != NULL) {
+        int tid;
+        if (strstr(ligne, "\"ph\":\"X\"") == NULL) continue;
+        nbLignes++;
+        if (strstr(ligne, "\"name\":\"tache\"") != NULL) {
+            nbTaches++;
+            if (sscanf(strstr(ligne, "\"tid\":"), "\"tid\":%d", &tid) == 1 && tid != 1) filsTaches |= 1 << tid;
+        }
+        if (strstr(ligne, "\"name\":\"test\"") != NULL) nbTest++;
+    }
+    fclose(fichier);
+
+    if (nbLignes != nbEvenements || nbTest != TAILLE_ANNEAU_TRACE) erreurs++;
+#ifdef INSTRUMENTATION
+    // Les tâches du tri sont tracées dans les fils du pool, pas dans le fil principal
+    if (nbTaches < 3 || filsTaches == 0) erreurs++;
+#else
+    if (nbTaches != 0) erreurs++;
+#endif
+    printf("%ld événement(s), %d tâche(s), %d erreur(s)\n", nbEvenements, nbTaches, erreurs);
+
+    libererTableauChevaliers(tableau);
+    free(tableau);
+    remove("/tmp/test_trace.txt");
+    remove("/tmp/test_trace.json");
+}
+
+/* Choix d'arme sans clavier pour les parties des tests */
+static int armeTest(void *etat){
+    return rand_r((unsigned int *)etat) % 3;
+}
+
+void testMemoireSousSystemes(void){
+    printf("\nTest de la mémoire par sous-système\n");
+    int erreurs = 0, nb;
+    StatistiquesMemoire avant[NB_SOUS_SYSTEMES], apres, pendant, pendantRegistre;
+
+    ParametresScores parametres;
+    parametresScoresDefaut(&parametres);
+    parametres.nbChevaliers = 2000;
+    genererFichierScores("/tmp/test_memoire.txt", &parametres);
+    ParametresVagues vagues;
+    parametresVaguesDefaut(&vagues);
+    vagues.nbMonstresVague1 = 4;
+    vagues.nbMonstresVague2 = 4;
+    genererFichierVagues("/tmp/test_memoire_vagues.txt", &vagues);
+
+    // Les noms sont internés une fois pour toutes avant la mesure
+    TableauChevaliers *tableau = chargerTableauTexte("/tmp/test_memoire.txt", &nb);
+    libererTableauChevaliers(tableau);
+    free(tableau);
+    PileMonstre vague1 = creerPile();
+    FileMonstre vague2 = creerFileMonstre();
+    lireMonstresFichier("/tmp/test_memoire_vagues.txt", &vague1, &vague2);
+    libererVague1(vague1);
+    libererVague2(vague2);
+    for (int i = 0; i < NB_SOUS_SYSTEMES; i++) {
+        lireMemoire(i, &avant[i]);
+    }
+
+    // Scores, index, classement et tampons : tout est rendu à la fin
+    tableau = chargerTableauTexte("/tmp/test_memoire.txt", &nb);
+    compresserTableau(tableau);
+    IndexPseudos *index = indexerTableau(tableau);
+    Classement *classement = construireClassement(tableau);
+    // Les tampons d'un tri sont comptés dans les tampons puis rendus
+    StatistiquesMemoire tamponsAvant, tamponsApres;
+    lireMemoire(MEMOIRE_TAMPONS, &tamponsAvant);
+    triRadixChevaliers(tableau->chevaliers, tableau->nbChevaliers);
+    lireMemoire(MEMOIRE_TAMPONS, &tamponsApres);
+#ifdef INSTRUMENTATION
+    if (tamponsApres.nbAllocations - tamponsAvant.nbAllocations < 4) erreurs++;
+#endif
+    if (tamponsApres.octetsVivants != tamponsAvant.octetsVivants) erreurs++;
+    sauvegarderTableauBinaire(tableau, "/tmp/test_memoire.bin");
+    lireMemoire(MEMOIRE_SCORES, &pendant);
+    lireMemoire(MEMOIRE_REGISTRE, &pendantRegistre);
+#ifdef INSTRUMENTATION
+    if (pendant.octetsVivants <= avant[MEMOIRE_SCORES].octetsVivants) erreurs++;
+    if (pendant.picOctets < pendant.octetsVivants) erreurs++;
+    // Le tableau des chevaliers et le classement sont comptés dans le registre
+    if (pendantRegistre.octetsVivants - avant[MEMOIRE_REGISTRE].octetsVivants < (long long)nb * (long long)sizeof(Chevalier)) erreurs++;
+#endif
+    libererClassement(classement);
+    libererIndexPseudos(index);
+    libererTableauChevaliers(tableau);
+    free(tableau);
+    tableau = chargerTableauBinaire("/tmp/test_memoire.bin", &nb);
+    libererTableauChevaliers(tableau);
+    free(tableau);
+
+    // La même partie rejouée : les vagues ne gardent rien et leur pic ne monte plus.
+    // L'arrondi de malloc dépend de l'état du tas : le pic peut varier de quelques octets d'une partie à l'autre
+    long long picVagues = -1;
+    for (int partie = 0; partie < 20; partie++) {
+        unsigned int graine = 7;
+        fixerGraineMonstres(graine);
+        vague1 = creerPile();
+        vague2 = creerFileMonstre();
+        lireMonstresFichier("/tmp/test_memoire_vagues.txt", &vague1, &vague2);
+        Combattant joueur = creerCombattant("memoire");
+        joueur.choisirArme = armeTest;
+        joueur.etatArme = &graine;
+        jouerPartie(&joueur, vague1, vague2);
+
+        lireMemoire(MEMOIRE_VAGUES, &apres);
+        if (apres.octetsVivants != avant[MEMOIRE_VAGUES].octetsVivants) erreurs++;
+        if (partie > 0 && apres.picOctets > picVagues + picVagues / 4) erreurs++;
+        if (partie == 0) picVagues = apres.picOctets;
+    }
+
+    for (int i = 0; i < NB_SOUS_SYSTEMES; i++) {
+        lireMemoire(i, &apres);
+        if (apres.octetsVivants != avant[i].octetsVivants) erreurs++;
+#ifdef INSTRUMENTATION
+        if (apres.nbAllocations - apres.nbLiberations != avant[i].nbAllocations - avant[i].nbLiberations) erreurs++;
+        if (i != MEMOIRE_REGISTRE && apres.nbAllocations == avant[i].nbAllocations) erreurs++;
+#else
+        if (apres.nbAllocations != 0 || apres.octetsVivants != 0) erreurs++;
+#endif
+    }
+    afficherMesures(stdout);
+    printf("%d erreur(s)\n", erreurs);
+
+    remove("/tmp/test_memoire.txt");
+    remove("/tmp/test_memoire.bin");
+    remove("/tmp/test_memoire_vagues.txt");
+}
+
+/* Fil du test des histogrammes : enregistre les durées 1 à 10000 ns multipliées par son numéro */
+static void *enregistrerDureesFil(void *arg){
+    long numero = (long)arg;
+    for (long duree = 1; duree <= 10000; duree++) {
+        enregistrerMesure(MESURE_PARTIE, 0, duree * numero);
+    }
+    return NULL;
+}
+
+void testHistogrammes(void){
+    printf("\nTest des histogrammes de durées\n");
+    int erreurs = 0;
+    HistogrammeLatences histogramme, copie;
+
+    // Chaque case couvre au plus 1/32 de ses durées, les cases se suivent sans trou
+    for (int i = 0; i < NB_CASES_HISTOGRAMME; i++) {
+        long long debut = debutCaseHistogramme(i), largeur = debutCaseHistogramme(i + 1) - debut;
+        if (largeur < 1 || (debut >= 32 && largeur * 32 > debut)) erreurs++;
+    }
+    if (debutCaseHistogramme(NB_CASES_HISTOGRAMME) != 1LL << BITS_DUREE_MAX) erreurs++;
+
+    // 1 à 10000 ns : les centiles sont exacts à 3 % près
+    reinitialiserMesures();
+    for (long long duree = 1; duree <= 10000; duree++) {
+        enregistrerMesure(MESURE_PARTIE, 0, duree);
+    }
+    lireHistogramme(MESURE_PARTIE, &histogramme);
+    double centiles[] = {50, 90, 99, 99.9};
+    for (int i = 0; i < 4; i++) {
+        double attendu = centiles[i] * 100, lu = centileHistogramme(&histogramme, centiles[i]);
+        if (lu < attendu || lu > attendu * 1.03) erreurs++;
+    }
+    if (histogramme.nb != 10000 || histogramme.maxNs != 10000 || centileHistogramme(&histogramme, 100) != 10000) erreurs++;
+    if (histogramme.totalNs != 10000LL * 10001 / 2) erreurs++;
+
+    // Quatre fils : leurs histogrammes se fusionnent à la lecture
+    reinitialiserMesures();
+    pthread_t fils[4];
+    for (long i = 0; i < 4; i++) {
+        pthread_create(&fils[i], NULL, enregistrerDureesFil, (void *)(i + 1));
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(fils[i], NULL);
+    }
+    lireHistogramme(MESURE_PARTIE, &histogramme);
+    if (histogramme.nb != 40000 || histogramme.maxNs != 40000) erreurs++;
+    memset(&copie, 0, sizeof(copie));
+    fusionnerHistogrammes(&copie, &histogramme);
+    fusionnerHistogrammes(&copie, &histogramme);
+    if (copie.nb != 80000 || copie.maxNs != 40000 || centileHistogramme(&copie, 50) != centileHistogramme(&histogramme, 50)) erreurs++;
+
+    // Le texte écrit redonne les cases de l'histogramme
+    FILE *fichier = fopen("/tmp/test_histogrammes.txt", "w+");
+    ecrireHistogrammes(fichier);
+    rewind(fichier);
+    char ligne[256], nom[32];
+    long nb = 0, nbLu = -1, debut, fin, compte;
+    while (fgets(ligne, sizeof(ligne), fichier) != NULL) {
+        if (sscanf(ligne, "histogramme %31s nb=%ld", nom, &compte) == 2 && strcmp(nom, "partie") == 0) nbLu = compte;
+        else if (sscanf(ligne, "%ld %ld %ld", &debut, &fin, &compte) == 3) nb += compte;
+    }
+    fclose(fichier);
+    if (nbLu != 40000 || nb != 40000) erreurs++;
+    printf("p50 %lld ns, p99 %lld ns, p99.9 %lld ns, max %lld ns sur %ld durée(s)\n", centileHistogramme(&histogramme, 50),
+           centileHistogramme(&histogramme, 99), centileHistogramme(&histogramme, 99.9), histogramme.maxNs, histogramme.nb);
+
+    reinitialiserMesures();
+    lireHistogramme(MESURE_PARTIE, &histogramme);
+    if (histogramme.nb != 0 || centileHistogramme(&histogramme, 99) != 0) erreurs++;
+    printf("%d erreur(s)\n", erreurs);
+    remove("/tmp/test_histogrammes.txt");
+}
+
+void testSessionsSansEntree(void){
+    printf("\nTest du dossier des données et des parties sans entrée\n");
+    int erreurs = 0;
+    const char *ancien = getenv("SAE_DONNEES");
+    char *sauve = (ancien != NULL) ? strdup(ancien) : NULL;
+
+    unsetenv("SAE_DONNEES");
+    char *chemin = cheminDonnees(FICHIER_SCORES);
+    if (strcmp(chemin, DOSSIER_DONNEES FICHIER_SCORES) != 0) erreurs++;
+    libererMemoire(MEMOIRE_TAMPONS, chemin);
+    setenv("SAE_DONNEES", "/tmp/donnees", 1);
+    chemin = cheminDonnees("facile.txt");
+    if (strcmp(chemin, "/tmp/donnees/facile.txt") != 0) erreurs++;
+    libererMemoire(MEMOIRE_TAMPONS, chemin);
+    setenv("SAE_DONNEES", "/tmp/donnees/", 1);
+    chemin = cheminDonnees("facile.txt");
+    if (strcmp(chemin, "/tmp/donnees/facile.txt") != 0) erreurs++;
+    libererMemoire(MEMOIRE_TAMPONS, chemin);
+    if (sauve != NULL) setenv("SAE_DONNEES", sauve, 1); else unsetenv("SAE_DONNEES");
+    free(sauve);
+
+    // Mêmes graines, même partie : une session écrite d'avance se rejoue à l'identique
+    int scores[2];
+    for (int i = 0; i < 2; i++) {
+        unsigned int graine = 42;
+        PileMonstre vague1 = creerPile();
+        FileMonstre vague2 = creerFileMonstre();
+        lireMonstres("facile.txt", &vague1, &vague2);
+        fixerGraineMonstres(graine);
+        Combattant joueur = creerCombattant("rejoue");
+        joueur.choisirArme = armeAleatoire;
+        joueur.etatArme = &graine;
+        scores[i] = jouerPartie(&joueur, vague1, vague2);
+    }
+    if (scores[0] != scores[1]) erreurs++;
+    printf("Score rejoué : %d puis %d\n", scores[0], scores[1]);
+    printf("%d erreur(s)\n", erreurs);
+}
+
+void testMetriques(void){
+    printf("\nTest des métriques au format Prometheus\n");
+    int erreurs = 0;
+    compterPartie("facile.txt", true);
+    compterPartie("facile.txt", false);
+    compterPartie("moyen.txt", true);
+    fixerNombreChevaliers(12);
+
+    char *texte = NULL;
+    size_t taille = 0;
+    FILE *flux = open_memstream(&texte, &taille);
+    ecrireMetriques(flux);
+    fclose(flux);
+    if (strstr(texte, "# TYPE sae_parties_total counter\nsae_parties_total 3\n") == NULL) erreurs++;
+    if (strstr(texte, "sae_parties_fichier_total{fichier=\"facile.txt\",resultat=\"victoire\"} 1\n") == NULL) erreurs++;
+    if (strstr(texte, "sae_parties_fichier_total{fichier=\"facile.txt\",resultat=\"defaite\"} 1\n") == NULL) erreurs++;
+    if (strstr(texte, "sae_chevaliers 12\n") == NULL) erreurs++;
+    if (strstr(texte, "# TYPE sae_duree_secondes histogram\n") == NULL) erreurs++;
+    if (strstr(texte, "sae_duree_secondes_bucket{mesure=\"partie\",le=\"+Inf\"}") == NULL) erreurs++;
+    free(texte);
+
+    // Le fil répond à une vraie requête HTTP sur un socket Unix
+    const char *chemin = "/tmp/sae_test_metriques.sock";
+    if (demarrerMetriques("unix:/tmp/sae_test_metriques.sock") != 0) erreurs++;
+    int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un adresse = {0};
+    adresse.sun_family = AF_UNIX;
+    strcpy(adresse.sun_path, chemin);
+    char reponse[65536];
+    size_t lus = 0;
+    if (connect(client, (struct sockaddr *)&adresse, sizeof(adresse)) == 0) {
+        const char *requete = "GET /metrics HTTP/1.0\r\n\r\n";
+        if (write(client, requete, strlen(requete)) < 0) erreurs++;
+        ssize_t n;
+        while (lus < sizeof(reponse) - 1 && (n = read(client, reponse + lus, sizeof(reponse) - 1 - lus)) > 0) lus += n;
+    } else {
+        erreurs++;
+    }
+    reponse[lus] = '\0';
+    close(client);
+    if (strncmp(reponse, "HTTP/1.0 200", 12) != 0) erreurs++;
+    if (strstr(reponse, "sae_parties_total 3\n") == NULL) erreurs++;
+    arreterMetriques();
+    if (access(chemin, F_OK) == 0) erreurs++;
+    printf("Réponse de %zu octets\n", lus);
+    printf("%d erreur(s)\n", erreurs);
+}
+
+void testSimulation(void){
+    printf("\nTest des simulations arrêtées à la précision demandée\n");
+    int erreurs = 0;
+    ConfigurationSimulation aleatoire, pierre;
+    chargerConfiguration(&aleatoire, "facile.txt", trouverStrategie("aleatoire"));
+    chargerConfiguration(&pierre, "facile.txt", trouverStrategie("pierre"));
+    if (trouverStrategie("inconnue") != NULL) erreurs++;
+
+    // Une partie ne dépend que de la graine et de son numéro, et les modèles ne sont pas touchés
+    Bool victoires[2];
+    int scores[2];
+    scores[0] = jouerPartieSimulee(&aleatoire, 3, 17, &victoires[0]);
+    scores[1] = jouerPartieSimulee(&aleatoire, 3, 17, &victoires[1]);
+    if (scores[0] != scores[1] || victoires[0] != victoires[1]) erreurs++;
+    if (aleatoire.vague1 == NULL || aleatoire.vague1->monstre->pv <= 0) erreurs++;
+
+    double bas, haut;
+    intervalleVictoires(50, 100, 1.96, &bas, &haut);
+    if (fabs(bas - 0.4038) > 0.0005 || fabs(haut - 0.5962) > 0.0005) erreurs++;
+    intervalleVictoires(0, 10, 1.96, &bas, &haut);
+    if (bas != 0.0 || haut <= 0.0) erreurs++;
+    Echantillon echantillon = {0};
+    for (int i = 1; i <= 4; i++) ajouterValeur(&echantillon, i);
+    if (moyenneEchantillon(&echantillon) != 2.5) erreurs++;
+    if (fabs(demiLargeurMoyenne(&echantillon, 2.0) - 2.0 * sqrt(5.0 / 12.0)) > 1e-9) erreurs++;
+
+    // Le nombre de parties et les sommes ne dépendent pas du nombre de fils
+    ParametresSimulation parametres;
+    parametresSimulationDefaut(&parametres);
+    parametres.tailleLot = 500;
+    parametres.nbPartiesMin = 1000;
+    parametres.nbPartiesMax = 50000;
+    parametres.precisionVictoires = 0.02;
+    parametres.precisionScore = 10.0;
+    ResultatSimulation resultats[2];
+    for (int i = 0; i < 2; i++) {
+        parametres.nbFils = 1 + 3 * i;
+        simulerConfiguration(&aleatoire, &parametres, &resultats[i]);
+    }
+    if (memcmp(&resultats[0], &resultats[1], sizeof(ResultatSimulation)) != 0) erreurs++;
+    if (resultats[0].scores.nb % parametres.tailleLot != 0 || resultats[0].scores.nb >= parametres.nbPartiesMax) erreurs++;
+    intervalleVictoires(resultats[0].nbVictoires, resultats[0].scores.nb, parametres.z, &bas, &haut);
+    if ((haut - bas) / 2 > parametres.precisionVictoires) erreurs++;
+    if (demiLargeurMoyenne(&resultats[0].scores, parametres.z) > parametres.precisionScore) erreurs++;
+    printf("Précision atteinte en %ld partie(s)\n", resultats[0].scores.nb);
+
+    // Mêmes graines : une configuration comparée à elle-même s'arrête au minimum sans aucun écart
+    ComparaisonSimulation comparaison;
+    comparerConfigurations(&aleatoire, &aleatoire, &parametres, &comparaison);
+    if (comparaison.ecarts.nb != parametres.nbPartiesMin || comparaison.ecarts.sommeCarres != 0 || comparaison.verdict != 0) erreurs++;
+    comparerConfigurations(&aleatoire, &pierre, &parametres, &comparaison);
+    if (comparaison.a.scores.nb != comparaison.b.scores.nb || comparaison.ecarts.nb != comparaison.a.scores.nb) erreurs++;
+    if (comparaison.ecarts.somme != comparaison.a.scores.somme - comparaison.b.scores.somme) erreurs++;
+    printf("Écart aléatoire - pierre : %.2f ± %.2f en %ld partie(s)\n", moyenneEchantillon(&comparaison.ecarts),
+           demiLargeurMoyenne(&comparaison.ecarts, parametres.z), comparaison.ecarts.nb);
+
+    libererConfiguration(&aleatoire);
+    libererConfiguration(&pierre);
+    printf("%d erreur(s)\n", erreurs);
+}
+
+/* Travail du test du vol de travail : compte son exécution, et dure d'autant plus que son indice est grand */
+static void compterTravail(long indice, int fil, void *contexte){
+    int *executions = (int *)contexte;
+    volatile long attente = 0;
+    for (long i = 0; i < indice * 100; i++) attente += i;
+    __atomic_add_fetch(&executions[indice], 1, __ATOMIC_RELAXED);
+}
+
+void testTournoi(void){
+    printf("\nTest du vol de travail et du tournoi des stratégies\n");
+    int erreurs = 0;
+
+    // Chaque travail est exécuté une seule fois, quel que soit le nombre de fils
+    int executions[2000];
+    long travauxParFil[8];
+    memset(executions, 0, sizeof(executions));
+    long nbVols = executerTravaux(8, 2000, compterTravail, executions, travauxParFil);
+    long total = 0;
+    for (int i = 0; i < 2000; i++) {
+        if (executions[i] != 1) erreurs++;
+    }
+    for (int i = 0; i < 8; i++) total += travauxParFil[i];
+    if (total != 2000) erreurs++;
+    printf("2000 travaux, %ld vol(s)\n", nbVols);
+    if (executerTravaux(3, 0, compterTravail, executions, NULL) != 0) erreurs++;
+
+    // Les stratégies qui observent contrent l'arme la plus jouée, ou celle qui suit le plus souvent
+    EtatStrategie etat = {0};
+    etat.derniereArme = -1;
+    const StrategieSimulation *frequence = trouverStrategie("frequence");
+    const StrategieSimulation *motif = trouverStrategie("motif");
+    int armes[] = {0, 2, 0, 2, 0, 4};
+    for (int i = 0; i < 6; i++) frequence->observerArme(&etat, armes[i]);
+    if (frequence->choisirArme(&etat) != 1) erreurs++;
+    if (etat.derniereArme != -1 || etat.suites[0][2] != 2 || etat.suites[2][0] != 2) erreurs++;
+    motif->observerArme(&etat, 0);
+    if (motif->choisirArme(&etat) != 0) erreurs++;
+
+    // Le tournoi donne les mêmes cases avec 1 et 4 fils, et son classement est trié
+    ConfigurationSimulation vagues[2];
+    chargerConfiguration(&vagues[0], "facile.txt", NULL);
+    chargerConfiguration(&vagues[1], "difficile.txt", NULL);
+    Tournoi tournois[2];
+    for (int i = 0; i < 2; i++) {
+        initialiserTournoi(&tournois[i], vagues, 2, 600);
+        tournois[i].partiesParTravail = 100;
+        tournois[i].nbFils = 1 + 3 * i;
+        jouerTournoi(&tournois[i], NULL);
+    }
+    int nbCases = tournois[0].nbStrategies * 2;
+    if (tournois[0].nbTravaux != nbCases * 6) erreurs++;
+    if (memcmp(tournois[0].cases, tournois[1].cases, nbCases * sizeof(ResultatSimulation)) != 0) erreurs++;
+    for (int c = 0; c < nbCases; c++) {
+        if (tournois[0].cases[c].scores.nb != 600) erreurs++;
+    }
+    // Avec les mêmes graines, deux stratégies fixes différentes ne jouent pas les mêmes parties
+    if (tournois[0].cases[6].scores.somme == tournois[0].cases[8].scores.somme) erreurs++;
+
+    ClassementStrategie classement[16];
+    classerStrategies(&tournois[0], 1.96, classement);
+    for (int i = 1; i < tournois[0].nbStrategies; i++) {
+        if (classement[i].scoreMoyen > classement[i - 1].scoreMoyen) erreurs++;
+    }
+    for (int i = 0; i < tournois[0].nbStrategies; i++) {
+        if (classement[i].nbParties != 1200 || classement[i].demiLargeurScore <= 0) erreurs++;
+    }
+    printf("Premier : %s (%.2f ± %.2f)\n", classement[0].strategie->nom, classement[0].scoreMoyen, classement[0].demiLargeurScore);
+
+    for (int i = 0; i < 2; i++) {
+        libererTournoi(&tournois[i]);
+        libererConfiguration(&vagues[i]);
+    }
+    printf("%d erreur(s)\n", erreurs);
+}
+
 // ----------------------------------------------- Partie Monstres -----------------------------------------------
 
 void testArmesAleatoire(){
@@ -135,11 +1428,13 @@ void testChargement(){ //Test la fonction creerMonstres puis l'affiche
     // Test de la fonction creerMonstres
     Monstre *monstre = creerMonstre("Chouin-Chouin", 1);
     afficherMonstre(monstre);
+    libererMonstre(monstre);
     monstre = creerMonstre("Lutin Cordial", 2);
     afficherMonstre(monstre);
+    libererMonstre(monstre);
     monstre = creerMonstre("Chimere", 3);
     afficherMonstre(monstre);
-    free(monstre);
+    libererMonstre(monstre);
 }
 
 void testLireMonstres(){
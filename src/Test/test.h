@@ -11,6 +11,16 @@
 #include "../chevalier.h"
 #include "../monstres.h"
 #include "../jeu.h"
+#include "../registre.h"
+#include "../classement.h"
+#include "../parallele.h"
+#include "../recherche.h"
+#include "../compression.h"
+#include "../pool.h"
+#include "../generateur.h"
+#include "../instrumentation.h"
+#include "../metriques.h"
+#include "../tournoi.h"
 
 //Partie Chevalier
 
@@ -20,11 +30,57 @@ void testCreerChevalierEtScore();
 
 void testTriBulle(void);
 
+void testTriRapide(void);
+
 void testRechercheDicho(void);
 
 
 void testChargementEtSauvegardeChevaliers();
 
+void testRegistreConcurrent(void);
+
+void testClassementFige(void);
+
+void testTriEtStatistiquesParalleles(void);
+
+void testPageMeilleurs(void);
+
+void testRecherchePrefixe(void);
+
+void testRangScores(void);
+
+void testResumeScores(void);
+
+void testRetentionScores(void);
+
+void testCompressionScores(void);
+
+void testSeparationChevalier(void);
+
+void testChainesInternees(void);
+
+void testTableauCroissant(void);
+
+void testPoolsMaillons(void);
+
+void testGenerateur(void);
+
+void testInstrumentation(void);
+
+void testTrace(void);
+
+void testMemoireSousSystemes(void);
+
+void testSessionsSansEntree(void);
+
+void testHistogrammes(void);
+
+void testMetriques(void);
+
+void testSimulation(void);
+
+void testTournoi(void);
+
 // ----------------------------------------------- Partie Monstres -----------------------------------------------
 
 void testArmesAleatoire();
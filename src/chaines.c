@@ -0,0 +1,293 @@
+/**
+ * \file chaines.c
+ * \brief Table globale des chaînes internées (pseudos, noms de monstres)
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "chaines.h"
+#include "instrumentation.h"
+
+#include <pthread.h>
+
+/* Bloc de l'arène : les chaînes n'y sont jamais déplacées */
+typedef struct BlocChaines {
+    struct BlocChaines *precedent;
+    size_t utilise;
+    size_t taille;
+    char octets[];
+} BlocChaines;
+
+/* Chaîne internée : son texte dans l'arène et son hachage */
+typedef struct {
+    const char *texte;
+    unsigned int hachage;
+} EntreeChaine;
+
+/* Les pages ne sont jamais réallouées : texteChaine peut les lire sans verrou */
+static EntreeChaine *pagesChaines[NB_PAGES_CHAINES];
+static IdChaine nbIds = 1;              // L'identifiant 0 est celui de la chaîne vide
+static IdChaine *alveoles = NULL;       // Table de hachage des identifiants, CHAINE_INCONNUE si libre
+static unsigned int nbAlveoles = 0;
+static BlocChaines *blocCourant = NULL;
+static size_t tailleArene = 0;
+static pthread_rwlock_t verrouChaines = PTHREAD_RWLOCK_INITIALIZER;
+
+/**
+ * \brief Calcule le hachage d'une chaîne
+ *
+ * Utilise l'algorithme FNV-1a sur 32 bits.
+ *
+ * \param[in] chaine La chaîne à hacher
+ * \return La valeur de hachage de la chaîne
+ */
+unsigned int hacherChaine(const char *chaine){
+    unsigned int h = 2166136261u;
+    while (*chaine != '\0') {
+        h ^= (unsigned char)*chaine++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Entrée d'un identifiant déjà attribué */
+static const EntreeChaine *entreeChaine(IdChaine id){
+    const EntreeChaine *page = __atomic_load_n(&pagesChaines[id / TAILLE_PAGE_CHAINES], __ATOMIC_ACQUIRE);
+    return &page[id % TAILLE_PAGE_CHAINES];
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Cherche une chaîne dans la table de hachage (verrou déjà pris) */
+static IdChaine chercherSansVerrou(const char *chaine, unsigned int h){
+    if (nbAlveoles == 0) {
+        return CHAINE_INCONNUE;
+    }
+
+    unsigned int masque = nbAlveoles - 1;
+    for (unsigned int i = h & masque; alveoles[i] != CHAINE_INCONNUE; i = (i + 1) & masque) {
+        const EntreeChaine *entree = entreeChaine(alveoles[i]);
+        if (entree->hachage == h && strcmp(entree->texte, chaine) == 0) {
+            return alveoles[i];
+        }
+    }
+    return CHAINE_INCONNUE;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Place un identifiant dans la table de hachage (verrou d'écriture pris) */
+static void placerChaine(IdChaine id){
+    unsigned int masque = nbAlveoles - 1;
+    unsigned int i = entreeChaine(id)->hachage & masque;
+    while (alveoles[i] != CHAINE_INCONNUE) {
+        i = (i + 1) & masque;
+    }
+    alveoles[i] = id;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Copie un texte dans l'arène, en ouvrant un nouveau bloc si le courant est plein */
+static const char *copierDansArene(const char *chaine, size_t longueur){
+    if (blocCourant == NULL || blocCourant->utilise + longueur + 1 > blocCourant->taille) {
+        size_t taille = (longueur + 1 > TAILLE_BLOC_CHAINES) ? longueur + 1 : TAILLE_BLOC_CHAINES;
+        BlocChaines *bloc = (BlocChaines *)allouerMemoire(MEMOIRE_NOMS, sizeof(BlocChaines) + taille);
+        if (bloc == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        bloc->precedent = blocCourant;
+        bloc->utilise = 0;
+        bloc->taille = taille;
+        blocCourant = bloc;
+    }
+
+    char *copie = blocCourant->octets + blocCourant->utilise;
+    memcpy(copie, chaine, longueur + 1);
+    blocCourant->utilise += longueur + 1;
+    tailleArene += longueur + 1;
+    return copie;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Attribue un identifiant à une nouvelle chaîne (verrou d'écriture pris) */
+static IdChaine ajouterChaine(const char *chaine, unsigned int h){
+    IdChaine id = nbIds;
+    if (id / TAILLE_PAGE_CHAINES >= NB_PAGES_CHAINES) {
+        fprintf(stderr, "Erreur : table des chaînes pleine.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    EntreeChaine *page = pagesChaines[id / TAILLE_PAGE_CHAINES];
+    if (page == NULL) {
+        page = (EntreeChaine *)allouerMemoire(MEMOIRE_NOMS, TAILLE_PAGE_CHAINES * sizeof(EntreeChaine));
+        if (page == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        __atomic_store_n(&pagesChaines[id / TAILLE_PAGE_CHAINES], page, __ATOMIC_RELEASE);
+    }
+    page[id % TAILLE_PAGE_CHAINES].texte = copierDansArene(chaine, strlen(chaine));
+    page[id % TAILLE_PAGE_CHAINES].hachage = h;
+    nbIds++;
+
+    // La table reste à moitié vide au plus
+    if (2 * (nbIds - 1) > nbAlveoles) {
+        unsigned int nouvelles = (nbAlveoles == 0) ? 1024 : 2 * nbAlveoles;
+        IdChaine *table = (IdChaine *)allouerMemoire(MEMOIRE_NOMS, nouvelles * sizeof(IdChaine));
+        if (table == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        memset(table, 0xFF, nouvelles * sizeof(IdChaine));
+        libererMemoire(MEMOIRE_NOMS, alveoles);
+        alveoles = table;
+        nbAlveoles = nouvelles;
+        for (IdChaine i = 1; i < nbIds; i++) {
+            placerChaine(i);
+        }
+    } else {
+        placerChaine(id);
+    }
+    return id;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Interne une chaîne
+ *
+ * La chaîne est copiée une seule fois dans l'arène ; les appels suivants
+ * avec le même texte rendent le même identifiant. Utilisable par
+ * plusieurs threads en même temps.
+ *
+ * \param[in] chaine La chaîne à interner
+ * \return L'identifiant de la chaîne
+ * \note Si l'allocation échoue ou si la table est pleine, le programme termine avec un message d'erreur.
+ */
+IdChaine internerChaine(const char *chaine){
+    if (chaine[0] == '\0') {
+        return CHAINE_VIDE;
+    }
+
+    // Cas le plus fréquent : la chaîne existe déjà, un verrou de lecture suffit
+    unsigned int h = hacherChaine(chaine);
+    pthread_rwlock_rdlock(&verrouChaines);
+    IdChaine id = chercherSansVerrou(chaine, h);
+    pthread_rwlock_unlock(&verrouChaines);
+    if (id != CHAINE_INCONNUE) {
+        return id;
+    }
+
+    // Un autre thread a pu l'ajouter entre les deux verrous
+    pthread_rwlock_wrlock(&verrouChaines);
+    id = chercherSansVerrou(chaine, h);
+    if (id == CHAINE_INCONNUE) {
+        id = ajouterChaine(chaine, h);
+    }
+    pthread_rwlock_unlock(&verrouChaines);
+    return id;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Cherche une chaîne sans l'interner
+ *
+ * \param[in] chaine La chaîne à chercher
+ * \return Son identifiant, \c CHAINE_INCONNUE si elle n'a jamais été internée
+ */
+IdChaine chercherChaine(const char *chaine){
+    if (chaine[0] == '\0') {
+        return CHAINE_VIDE;
+    }
+
+    unsigned int h = hacherChaine(chaine);
+    pthread_rwlock_rdlock(&verrouChaines);
+    IdChaine id = chercherSansVerrou(chaine, h);
+    pthread_rwlock_unlock(&verrouChaines);
+    return id;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le texte d'une chaîne internée
+ *
+ * Ne prend aucun verrou. Le texte reste valide jusqu'à \c libererChaines.
+ *
+ * \param[in] id L'identifiant de la chaîne
+ * \return Le texte de la chaîne
+ */
+const char *texteChaine(IdChaine id){
+    return (id == CHAINE_VIDE) ? "" : entreeChaine(id)->texte;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le hachage d'une chaîne internée sans la relire
+ *
+ * \param[in] id L'identifiant de la chaîne
+ * \return La même valeur que \c hacherChaine sur son texte
+ */
+unsigned int hachageChaine(IdChaine id){
+    return (id == CHAINE_VIDE) ? hacherChaine("") : entreeChaine(id)->hachage;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compte les chaînes internées
+ *
+ * \return Le nombre de chaînes distinctes (sans la chaîne vide)
+ */
+int nombreChaines(void){
+    pthread_rwlock_rdlock(&verrouChaines);
+    int nb = (int)nbIds - 1;
+    pthread_rwlock_unlock(&verrouChaines);
+    return nb;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne la place occupée par les textes des chaînes
+ *
+ * \return Le nombre d'octets utilisés dans l'arène
+ */
+size_t tailleAreneChaines(void){
+    pthread_rwlock_rdlock(&verrouChaines);
+    size_t taille = tailleArene;
+    pthread_rwlock_unlock(&verrouChaines);
+    return taille;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère toutes les chaînes internées
+ *
+ * Plus aucun identifiant ne doit être utilisé ensuite.
+ */
+void libererChaines(void){
+    pthread_rwlock_wrlock(&verrouChaines);
+    while (blocCourant != NULL) {
+        BlocChaines *precedent = blocCourant->precedent;
+        libererMemoire(MEMOIRE_NOMS, blocCourant);
+        blocCourant = precedent;
+    }
+    for (int i = 0; i < NB_PAGES_CHAINES; i++) {
+        libererMemoire(MEMOIRE_NOMS, pagesChaines[i]);
+        pagesChaines[i] = NULL;
+    }
+    libererMemoire(MEMOIRE_NOMS, alveoles);
+    alveoles = NULL;
+    nbAlveoles = 0;
+    nbIds = 1;
+    tailleArene = 0;
+    pthread_rwlock_unlock(&verrouChaines);
+}
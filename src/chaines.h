@@ -0,0 +1,151 @@
+/**
+ * \file chaines.h
+ * \brief En-tête pour le fichier chaines.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef CHAINES_H
+#define CHAINES_H
+
+    #include <stdio.h>
+    #include <stdlib.h>
+    #include <string.h>
+
+    /**
+     * \def TAILLE_BLOC_CHAINES
+     * \brief Taille en octets d'un bloc de l'arène où sont rangées les chaînes.
+     */
+    #define TAILLE_BLOC_CHAINES 65536
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def TAILLE_PAGE_CHAINES
+     * \brief Nombre d'identifiants par page de la table des chaînes.
+     */
+    #define TAILLE_PAGE_CHAINES 4096
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def NB_PAGES_CHAINES
+     * \brief Nombre maximum de pages de la table des chaînes.
+     */
+    #define NB_PAGES_CHAINES 4096
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def CHAINE_VIDE
+     * \brief Identifiant de la chaîne vide, valable sans rien interner.
+     */
+    #define CHAINE_VIDE 0u
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def CHAINE_INCONNUE
+     * \brief Identifiant rendu par \c chercherChaine pour une chaîne jamais internée.
+     */
+    #define CHAINE_INCONNUE 0xFFFFFFFFu
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \typedef IdChaine
+     * \brief Identifiant d'une chaîne internée.
+     *
+     * Deux chaînes internées sont égales si et seulement si leurs
+     * identifiants le sont. L'ordre des identifiants n'est pas celui des
+     * chaînes : les tris comparent toujours les textes.
+     */
+    typedef unsigned int IdChaine;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Calcule le hachage d'une chaîne
+     *
+     * Utilise l'algorithme FNV-1a sur 32 bits.
+     *
+     * \param[in] chaine La chaîne à hacher
+     * \return La valeur de hachage de la chaîne
+     */
+    unsigned int hacherChaine(const char *chaine);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Interne une chaîne
+     *
+     * La chaîne est copiée une seule fois dans l'arène ; les appels suivants
+     * avec le même texte rendent le même identifiant. Utilisable par
+     * plusieurs threads en même temps.
+     *
+     * \param[in] chaine La chaîne à interner
+     * \return L'identifiant de la chaîne
+     * \note Si l'allocation échoue ou si la table est pleine, le programme termine avec un message d'erreur.
+     */
+    IdChaine internerChaine(const char *chaine);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Cherche une chaîne sans l'interner
+     *
+     * \param[in] chaine La chaîne à chercher
+     * \return Son identifiant, \c CHAINE_INCONNUE si elle n'a jamais été internée
+     */
+    IdChaine chercherChaine(const char *chaine);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le texte d'une chaîne internée
+     *
+     * Ne prend aucun verrou. Le texte reste valide jusqu'à \c libererChaines.
+     *
+     * \param[in] id L'identifiant de la chaîne
+     * \return Le texte de la chaîne
+     */
+    const char *texteChaine(IdChaine id);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le hachage d'une chaîne internée sans la relire
+     *
+     * \param[in] id L'identifiant de la chaîne
+     * \return La même valeur que \c hacherChaine sur son texte
+     */
+    unsigned int hachageChaine(IdChaine id);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compte les chaînes internées
+     *
+     * \return Le nombre de chaînes distinctes (sans la chaîne vide)
+     */
+    int nombreChaines(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne la place occupée par les textes des chaînes
+     *
+     * \return Le nombre d'octets utilisés dans l'arène
+     */
+    size_t tailleAreneChaines(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère toutes les chaînes internées
+     *
+     * Plus aucun identifiant ne doit être utilisé ensuite.
+     */
+    void libererChaines(void);
+
+#endif
@@ -5,6 +5,74 @@
  * \date 15/12/2024 au 10/01/2025
  */
 #include "chevalier.h"
+#include "compression.h"
+#include "pool.h"
+#include "instrumentation.h"
+
+#include <limits.h>
+#include <unistd.h>
+
+/**
+ * \def TAILLE_ARBRE_SCORES
+ * \brief Nombre de scores distincts comptés par l'arbre de Fenwick (une puissance de 2).
+ */
+#define TAILLE_ARBRE_SCORES (SCORE_MAX + 1)
+
+/* Arbre de Fenwick des scores en mémoire : la case i couvre les scores de i - (i & -i) à i - 1 */
+static int arbreScores[TAILLE_ARBRE_SCORES + 1];
+static int totalScores = 0;
+
+/* Maillons de scores pris et pas encore rendus, lus par les métriques */
+static long nbMaillonsScores = 0;
+
+/* Politique de rétention des scores, voir definirRetention */
+static int retentionMeilleurs = RETENTION_MEILLEURS;
+static int retentionDerniers = RETENTION_DERNIERS;
+
+static void compterScore(int score, int delta);
+static void insererMaillon(Chevalier *chevalier, int score, int numero);
+static void appliquerRetention(Chevalier *chevalier);
+static void compterCompactes(const ScoresCompactes *compactes, int delta);
+
+/* Prend un maillon de score dans le pool, compté dans la mémoire des scores */
+static MaillonScore *prendreMaillonScore(void){
+    __atomic_add_fetch(&nbMaillonsScores, 1, __ATOMIC_RELAXED);
+    compterMemoire(MEMOIRE_SCORES, sizeof(MaillonScore));
+    return (MaillonScore *)allouerDansPool(sizeof(MaillonScore));
+}
+
+/* Rend un maillon de score au pool */
+static void rendreMaillonScore(MaillonScore *maillon){
+    __atomic_sub_fetch(&nbMaillonsScores, 1, __ATOMIC_RELAXED);
+    compterMemoire(MEMOIRE_SCORES, -(long)sizeof(MaillonScore));
+    libererDansPool(maillon, sizeof(MaillonScore));
+}
+
+/* Historique d'un chevalier qui n'a encore aucun score */
+static const HistoriqueScores historiqueVide;
+
+/* Historique d'un chevalier en lecture seule, jamais NULL */
+static const HistoriqueScores *lireHistorique(const Chevalier *chevalier){
+    return (chevalier->historique != NULL) ? chevalier->historique : &historiqueVide;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Historique d'un chevalier, alloué à son premier score */
+static HistoriqueScores *historiqueChevalier(Chevalier *chevalier){
+    if (chevalier->historique == NULL) {
+        chevalier->historique = (HistoriqueScores *)allouerMemoire(MEMOIRE_SCORES, sizeof(HistoriqueScores));
+        if (chevalier->historique == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        initialiserResume(&chevalier->historique->resume);
+        memset(&chevalier->historique->compactes, 0, sizeof(ScoresCompactes));
+    }
+    return chevalier->historique;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
 
 /**
  * \brief Crée un nouveau chevalier
@@ -12,41 +80,69 @@
  * \param[in] pseudo pseudo du chevalier
  * \return un chevalier avec : 
  *                      - un pseudo, 
- *                      - 20 points de vie, 
- *                      - 1 point de dégât,
  *                      - 0 partie jouée 
  *                      - et une liste de scores vide
  */
-Chevalier creerChevalier(char *pseudo){
+Chevalier creerChevalier(const char *pseudo){
     Chevalier chevalier;
 
-    if (strlen(pseudo) >= sizeof(chevalier.pseudo)) { // chaîne trop grande -> raccourcir
-        strncpy(chevalier.pseudo, pseudo, sizeof(chevalier.pseudo) - 1);
-        chevalier.pseudo[sizeof(chevalier.pseudo) - 1] = '\0';
+    if (strlen(pseudo) > LONGUEUR_MAX_PSEUDO) { // chaîne trop grande -> raccourcir
+        char court[LONGUEUR_MAX_PSEUDO + 1];
+        strncpy(court, pseudo, LONGUEUR_MAX_PSEUDO);
+        court[LONGUEUR_MAX_PSEUDO] = '\0';
+        chevalier.pseudo = internerChaine(court);
     } else {
-        strcpy(chevalier.pseudo, pseudo);
+        chevalier.pseudo = internerChaine(pseudo);
     }
 
-    chevalier.pv = PV_MIN;
-    chevalier.dmg = DMG_MIN;
     chevalier.nbParties = 0;
+    chevalier.meilleurScore = 0;
+    chevalier.tailleCompresses = 0;
     chevalier.firstScore = NULL;
     chevalier.lastScore = NULL;
+    chevalier.scoresCompresses = NULL;
+    chevalier.historique = NULL;
 
     return chevalier;
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * \brief Crée le combattant d'une nouvelle partie
+ *
+ * \param[in] pseudo pseudo du joueur
+ * \return un combattant avec 20 points de vie et 1 point de dégât, qui
+ * choisit ses armes au clavier et affiche la partie
+ */
+Combattant creerCombattant(const char *pseudo){
+    Combattant combattant;
+
+    strncpy(combattant.pseudo, pseudo, sizeof(combattant.pseudo) - 1);
+    combattant.pseudo[sizeof(combattant.pseudo) - 1] = '\0';
+    combattant.pv = PV_MIN;
+    combattant.dmg = DMG_MIN;
+    combattant.choisirArme = NULL;
+    combattant.etatArme = NULL;
+    combattant.observerArme = NULL;
+    combattant.graineMonstres = NULL;
+    combattant.muet = false;
+
+    return combattant;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
 /**
  * \brief Crée un nouveau tableau de chevaliers
  *
- * Alloue dynamiquement un tableau de chevaliers et l'initialise avec
- * une taille de 0 et un pointeur de chevaliers NULL.
+ * Alloue dynamiquement un tableau de chevaliers vide, avec de la place
+ * pour \c capacite chevaliers (aucune si elle vaut 0).
  *
+ * \param[in] capacite Le nombre de chevaliers attendus
  * \return Un pointeur vers le tableau de chevaliers crée
  */
-TableauChevaliers *creerTableauChevaliers() {
+TableauChevaliers *creerTableauChevaliers(int capacite) {
     // Allouer dynamiquement la structure
     TableauChevaliers *tableau = (TableauChevaliers *)malloc(sizeof(TableauChevaliers));
     if (tableau == NULL) {
@@ -57,66 +153,337 @@ TableauChevaliers *creerTableauChevaliers() {
     // Initialiser les champs
     tableau->chevaliers = NULL; // Pas de chevaliers au départ
     tableau->nbChevaliers = 0;        // Taille initiale de 0
+    tableau->capacite = 0;
+    reserverChevaliers(tableau, capacite);
 
     return tableau;
 }
 
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Réserve de la place pour au moins \c capacite chevaliers
+ *
+ * Ne réduit jamais le tableau.
+ *
+ * \param[in,out] tableau Le tableau de chevaliers
+ * \param[in] capacite Le nombre de chevaliers à pouvoir contenir
+ * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+ */
+void reserverChevaliers(TableauChevaliers *tableau, int capacite){
+    if (capacite <= tableau->capacite) return;
+
+    Chevalier *chevaliers = (Chevalier *)reallouerMemoire(MEMOIRE_REGISTRE, tableau->chevaliers, (size_t)capacite * sizeof(Chevalier));
+    if (chevaliers == NULL) {
+        perror("Erreur de réallocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    tableau->chevaliers = chevaliers;
+    tableau->capacite = capacite;
+}
+
 /*--------------------------------------------------------------------------------------------------------------------------------*/
-/* Fonction d'échange */
-void echangerChevaliers(Chevalier *a, Chevalier *b) {
-    Chevalier temp = *a;
+/**
+ * \brief Clé de tri d'un chevalier par meilleur score
+ *
+ * Les meilleurs scores donnent les plus petites clés.
+ *
+ * \param[in] chevalier Le chevalier
+ * \return La clé de tri
+ */
+unsigned long long cleScore(Chevalier *chevalier){
+    return (unsigned long long)((long long)INT_MAX - meilleurScoreChevalier(chevalier));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Clé de collation du pseudo d'un chevalier
+ *
+ * Les 8 premiers octets du pseudo lus en gros-boutiste : l'ordre des clés
+ * est celui de strcmp sur ces 8 octets.
+ *
+ * \param[in] chevalier Le chevalier
+ * \return La clé de tri
+ */
+unsigned long long cleNom(Chevalier *chevalier){
+    const char *pseudo = texteChaine(chevalier->pseudo);
+    unsigned long long cle = 0;
+    int i = 0;
+    for (; i < 8 && pseudo[i] != '\0'; i++) {
+        cle = (cle << 8) | (unsigned char)pseudo[i];
+    }
+    return cle << (8 * (8 - i));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compare deux clés de tri
+ *
+ * À clé égale, on départage par le pseudo complet si \c chevaliers est donné,
+ * puis par l'indice : deux clés distinctes ne sont jamais égales.
+ *
+ * \param[in] a La première clé
+ * \param[in] b La deuxième clé
+ * \param[in] chevaliers Les chevaliers indexés par les clés, ou NULL
+ * \return Un entier négatif, nul ou positif comme strcmp
+ */
+int comparerCles(const CleTri *a, const CleTri *b, const Chevalier *chevaliers){
+    if (a->cle != b->cle) {
+        return (a->cle < b->cle) ? -1 : 1;
+    }
+    // Pseudos égaux si et seulement si leurs identifiants le sont
+    if (chevaliers != NULL && chevaliers[a->index].pseudo != chevaliers[b->index].pseudo) {
+        return strcmp(texteChaine(chevaliers[a->index].pseudo), texteChaine(chevaliers[b->index].pseudo));
+    }
+    return a->index - b->index;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Échange deux clés */
+static void echangerCles(CleTri *a, CleTri *b) {
+    CleTri temp = *a;
     *a = *b;
     *b = temp;
 }
 
-/* Partition pour le tri rapide */
-int partition(Chevalier *chevaliers, int gauche, int droite) {
-    int pivotScore = (chevaliers[droite].lastScore) ? chevaliers[droite].lastScore->score : 0;
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Partition pour le tri rapide des clés
+ *
+ * Le pivot est la médiane de la première, du milieu et de la dernière clé,
+ * ce qui évite le pire cas sur un tableau déjà trié.
+ *
+ * \param[in,out] cles Les clés à partitionner
+ * \param[in] gauche Indice de la première clé
+ * \param[in] droite Indice de la dernière clé
+ * \param[in] chevaliers Les chevaliers pour départager les clés égales par pseudo, NULL pour départager par indice
+ * \return L'indice final du pivot
+ */
+int partition(CleTri *cles, int gauche, int droite, const Chevalier *chevaliers) {
+    int milieu = gauche + (droite - gauche) / 2;
+    if (comparerCles(&cles[milieu], &cles[gauche], chevaliers) < 0) echangerCles(&cles[milieu], &cles[gauche]);
+    if (comparerCles(&cles[droite], &cles[gauche], chevaliers) < 0) echangerCles(&cles[droite], &cles[gauche]);
+    if (comparerCles(&cles[milieu], &cles[droite], chevaliers) < 0) echangerCles(&cles[milieu], &cles[droite]);
+
+    CleTri pivot = cles[droite];
     int i = gauche - 1;
 
     for (int j = gauche; j < droite; j++) {
-        int scoreJ = (chevaliers[j].lastScore) ? chevaliers[j].lastScore->score : 0;
-        if (scoreJ >= pivotScore) { // Descendant
+        if (comparerCles(&cles[j], &pivot, chevaliers) < 0) {
             i++;
-            echangerChevaliers(&chevaliers[i], &chevaliers[j]);
+            echangerCles(&cles[i], &cles[j]);
         }
     }
-    echangerChevaliers(&chevaliers[i + 1], &chevaliers[droite]);
+    echangerCles(&cles[i + 1], &cles[droite]);
     return i + 1;
 }
 
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tri rapide d'un tableau de clés
+ *
+ * On ne récurse que sur la plus petite partie pour borner la pile.
+ *
+ * \param[in,out] cles Les clés à trier
+ * \param[in] gauche Indice de la première clé
+ * \param[in] droite Indice de la dernière clé
+ * \param[in] chevaliers Les chevaliers pour départager les clés égales par pseudo, NULL pour départager par indice
+ */
+void triRapideCles(CleTri *cles, int gauche, int droite, const Chevalier *chevaliers) {
+    while (gauche < droite) {
+        int pivot = partition(cles, gauche, droite, chevaliers);
+        if (pivot - gauche < droite - pivot) {
+            triRapideCles(cles, gauche, pivot - 1, chevaliers);
+            gauche = pivot + 1;
+        } else {
+            triRapideCles(cles, pivot + 1, droite, chevaliers);
+            droite = pivot - 1;
+        }
+    }
+}
 
-/* Quicksort */
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Alloue le tableau de clés de chevaliers[gauche..droite] */
+static CleTri *extraireCles(Chevalier *chevaliers, int gauche, int droite, unsigned long long (*cle)(Chevalier *)){
+    int n = droite - gauche + 1;
+    CleTri *cles = (CleTri *)allouerMemoire(MEMOIRE_TAMPONS, n * sizeof(CleTri));
+    if (cles == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        cles[i].cle = cle(&chevaliers[gauche + i]);
+        cles[i].index = gauche + i;
+    }
+    return cles;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Range les chevaliers dans l'ordre donné par des clés triées
+ *
+ * Chaque chevalier n'est déplacé qu'une fois (vers un tableau temporaire),
+ * au lieu d'être échangé à chaque étape du tri.
+ *
+ * \param[in,out] chevaliers Le tableau de chevaliers
+ * \param[in] cles Les clés triées, dont les indices sont ceux de \c chevaliers
+ * \param[in] gauche Indice du premier chevalier concerné
+ * \param[in] n Nombre de chevaliers concernés
+ */
+void appliquerOrdreCles(Chevalier *chevaliers, const CleTri *cles, int gauche, int n){
+    Chevalier *copie = (Chevalier *)allouerMemoire(MEMOIRE_TAMPONS, n * sizeof(Chevalier));
+    if (copie == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        copie[i] = chevaliers[cles[i].index];
+    }
+    memcpy(&chevaliers[gauche], copie, n * sizeof(Chevalier));
+    libererMemoire(MEMOIRE_TAMPONS, copie);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Trie des chevaliers par meilleur score décroissant
+ *
+ * Les meilleurs scores sont extraits une seule fois dans un tableau de
+ * clés (score, indice) qui est trié par tri rapide ; les chevaliers sont
+ * ensuite déplacés une seule fois. À score égal, l'ordre d'origine est gardé.
+ *
+ * \param[in,out] chevaliers Le tableau de chevaliers
+ * \param[in] gauche Indice du premier chevalier à trier
+ * \param[in] droite Indice du dernier chevalier à trier
+ */
 void triRapideChevaliers(Chevalier *chevaliers, int gauche, int droite) {
-    if (gauche < droite) {
-        int pivot = partition(chevaliers, gauche, droite);
-        triRapideChevaliers(chevaliers, gauche, pivot - 1);
-        triRapideChevaliers(chevaliers, pivot + 1, droite);
+    if (gauche >= droite) return;
+
+    DEBUT_MESURE(MESURE_TRI);
+    CleTri *cles = extraireCles(chevaliers, gauche, droite, cleScore);
+    triRapideCles(cles, 0, droite - gauche, NULL);
+    appliquerOrdreCles(chevaliers, cles, gauche, droite - gauche + 1);
+    libererMemoire(MEMOIRE_TAMPONS, cles);
+    FIN_MESURE(MESURE_TRI);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tri par base (LSD) d'un tableau de clés
+ *
+ * Trie les clés par octets, du poids faible au poids fort, avec un
+ * comptage par octet. Les histogrammes des 8 octets sont calculés en un
+ * seul passage et les octets identiques pour toutes les clés sont sautés :
+ * des scores inférieurs à 65536 ne demandent que 2 passes. Le tri est
+ * stable, les clés égales gardent leur ordre d'origine.
+ *
+ * \param[in,out] cles Les clés à trier
+ * \param[in] n Le nombre de clés
+ */
+void triRadixCles(CleTri *cles, int n){
+    static const int NB_OCTETS = 8;
+    int (*comptes)[256];
+    CleTri *tampon, *source = cles, *destination;
+
+    if (n < 2) return;
+
+    comptes = allouerMemoireZero(MEMOIRE_TAMPONS, NB_OCTETS, sizeof(*comptes));
+    tampon = (CleTri *)allouerMemoire(MEMOIRE_TAMPONS, n * sizeof(CleTri));
+    if (comptes == NULL || tampon == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
     }
+    destination = tampon;
+
+    for (int i = 0; i < n; i++) {
+        unsigned long long cle = cles[i].cle;
+        for (int octet = 0; octet < NB_OCTETS; octet++) {
+            comptes[octet][(cle >> (8 * octet)) & 0xFF]++;
+        }
+    }
+
+    for (int octet = 0; octet < NB_OCTETS; octet++) {
+        int *compte = comptes[octet];
+
+        // Toutes les clés ont le même octet : la passe ne changerait rien
+        if (compte[(source[0].cle >> (8 * octet)) & 0xFF] == n) continue;
+
+        int position = 0;
+        for (int v = 0; v < 256; v++) {
+            int nb = compte[v];
+            compte[v] = position;
+            position += nb;
+        }
+        for (int i = 0; i < n; i++) {
+            destination[compte[(source[i].cle >> (8 * octet)) & 0xFF]++] = source[i];
+        }
+
+        CleTri *temp = source;
+        source = destination;
+        destination = temp;
+    }
+
+    if (source != cles) {
+        memcpy(cles, source, n * sizeof(CleTri));
+    }
+    libererMemoire(MEMOIRE_TAMPONS, tampon);
+    libererMemoire(MEMOIRE_TAMPONS, comptes);
 }
 
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Trie des chevaliers par meilleur score décroissant en temps linéaire
+ *
+ * Même ordre que \c triRapideChevaliers, mais par tri par base sur les
+ * clés (score, indice) : le coût reste linéaire même quand beaucoup de
+ * chevaliers ont le même score. Le tri est stable : si le tableau est
+ * trié par nom, les égalités restent dans l'ordre alphabétique.
+ *
+ * \param[in,out] chevaliers Le tableau de chevaliers
+ * \param[in] n Le nombre de chevaliers
+ */
+void triRadixChevaliers(Chevalier *chevaliers, int n){
+    if (n < 2) return;
+
+    DEBUT_MESURE(MESURE_TRI);
+    CleTri *cles = extraireCles(chevaliers, 0, n - 1, cleScore);
+    triRadixCles(cles, n);
+    appliquerOrdreCles(chevaliers, cles, 0, n);
+    libererMemoire(MEMOIRE_TAMPONS, cles);
+    FIN_MESURE(MESURE_TRI);
+}
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 
 /**
  * \brief Trie un tableau de chevaliers par ordre alphabétique
  *
- * Utilise l'algorithme de tri à bulles pour trier les chevaliers
- * dans le tableau par ordre alphabétique croissant de leurs pseudos.
+ * Trie des clés (8 premiers octets du pseudo, indice) par tri rapide,
+ * en ne comparant les pseudos complets qu'à préfixe égal, puis déplace
+ * chaque chevalier une seule fois. Le nom de la fonction est historique :
+ * ce n'est plus un tri à bulles.
  *
  * \param[in,out] tableau Le tableau de chevaliers à trier
  */
 void triBulleTableauChevaliers(TableauChevaliers *tableau){
-    int i, j;
-    for (i = 0; i < tableau->nbChevaliers - 1; i++) {
-        for (j = 0; j < tableau->nbChevaliers-1 ; j++) {
-            if (strcmp(tableau->chevaliers[j].pseudo, tableau->chevaliers[j + 1].pseudo) > 0) {
-                Chevalier temp = tableau->chevaliers[j];
-                tableau->chevaliers[j] = tableau->chevaliers[j + 1];
-                tableau->chevaliers[j + 1] = temp;
-            }
-        }
-    }
+    if (tableau->nbChevaliers < 2) return;
+
+    DEBUT_MESURE(MESURE_TRI);
+    CleTri *cles = extraireCles(tableau->chevaliers, 0, tableau->nbChevaliers - 1, cleNom);
+    triRapideCles(cles, 0, tableau->nbChevaliers - 1, tableau->chevaliers);
+    appliquerOrdreCles(tableau->chevaliers, cles, 0, tableau->nbChevaliers);
+    libererMemoire(MEMOIRE_TAMPONS, cles);
+    FIN_MESURE(MESURE_TRI);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -136,18 +503,22 @@ void triBulleTableauChevaliers(TableauChevaliers *tableau){
 int rechDichotomiqueJoueur(TableauChevaliers *tableau, char *pseudo, int *trouve){
     int debut = 0, milieu, fin = tableau->nbChevaliers - 1;
 
+    DEBUT_MESURE(MESURE_RECHERCHE);
+    *trouve = 0;
     while (debut <= fin) {
         milieu = (debut + fin) / 2;
-        if (strcmp(tableau->chevaliers[milieu].pseudo, pseudo) == 0) {
+        int res = strcmp(texteChaine(tableau->chevaliers[milieu].pseudo), pseudo);
+        if (res == 0) {
             *trouve = 1;
-            return milieu;
-        } else if (strcmp(tableau->chevaliers[milieu].pseudo, pseudo) < 0) {
+            debut = milieu;
+            break;
+        } else if (res < 0) {
             debut = milieu + 1;
         } else {
             fin = milieu - 1;
         }
     }
-    *trouve = 0;
+    FIN_MESURE(MESURE_RECHERCHE);
     return debut;
 }
 
@@ -156,29 +527,16 @@ int rechDichotomiqueJoueur(TableauChevaliers *tableau, char *pseudo, int *trouve
 /**
  * \brief Ajoute un chevalier à la liste
  *
- * Ajoute le chevalier donné en argument à la liste des chevaliers
- * du tableau. Si c'est le premier ajout, on alloue un tableau de
- * chevaliers de taille 1. Sinon, on réalloue pour étendre la taille
- * du tableau.
+ * Ajoute le chevalier donné en argument à la fin du tableau. Quand le
+ * tableau est plein, sa capacité double : un ajout coûte O(1) en
+ * moyenne.
  *
  * \param[in,out] tableau le tableau de chevaliers à modifier
  * \param[in] chevalier le chevalier à ajouter
  */
 void ajouterChevalier(TableauChevaliers *tableau, Chevalier chevalier){
-    if (tableau->chevaliers == NULL) {
-        // Premier ajout
-        tableau->chevaliers = (Chevalier *)malloc(sizeof(Chevalier));
-        if (tableau->chevaliers == NULL) {
-            perror("Erreur d'allocation mémoire");
-            exit(EXIT_FAILURE);
-        }
-    } else {
-        // Réallocation pour étendre la taille
-        tableau->chevaliers = (Chevalier *)realloc(tableau->chevaliers, (tableau->nbChevaliers + 1) * sizeof(Chevalier));
-        if (tableau->chevaliers == NULL) {
-            perror("Erreur de réallocation mémoire");
-            exit(EXIT_FAILURE);
-        }
+    if (tableau->nbChevaliers == tableau->capacite) {
+        reserverChevaliers(tableau, (tableau->capacite < 8) ? 16 : 2 * tableau->capacite);
     }
 
     // Ajouter le chevalier
@@ -188,6 +546,29 @@ void ajouterChevalier(TableauChevaliers *tableau, Chevalier chevalier){
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * \brief Ajoute plusieurs chevaliers à la fin du tableau
+ *
+ * Une seule réallocation au plus, puis une seule copie.
+ *
+ * \param[in,out] tableau Le tableau de chevaliers à modifier
+ * \param[in] chevaliers Les chevaliers à ajouter
+ * \param[in] nb Le nombre de chevaliers à ajouter
+ */
+void ajouterChevaliers(TableauChevaliers *tableau, const Chevalier *chevaliers, int nb){
+    if (nb <= 0) return;
+
+    int besoin = tableau->nbChevaliers + nb;
+    if (besoin > tableau->capacite) {
+        // On garde la croissance géométrique pour les ajouts qui suivront
+        reserverChevaliers(tableau, (besoin < 2 * tableau->capacite) ? 2 * tableau->capacite : besoin);
+    }
+    memcpy(&tableau->chevaliers[tableau->nbChevaliers], chevaliers, (size_t)nb * sizeof(Chevalier));
+    tableau->nbChevaliers = besoin;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
 /**
  * \brief Supprime un chevalier du tableau
  *
@@ -204,119 +585,776 @@ void supprimerChevalier(TableauChevaliers *tableau, int index){
         perror("Index invalide\n");
         exit(EXIT_FAILURE);
     }
-    for (int i = index; i < tableau->nbChevaliers - 1; i++) {
-        tableau->chevaliers[i] = tableau->chevaliers[i + 1];
+    memmove(&tableau->chevaliers[index], &tableau->chevaliers[index + 1], (size_t)(tableau->nbChevaliers - index - 1) * sizeof(Chevalier));
+    tableau->nbChevaliers--;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Supprime plusieurs chevaliers du tableau en un seul passage
+ *
+ * Les chevaliers restants gardent leur ordre. Les indices peuvent être
+ * dans n'importe quel ordre et apparaître plusieurs fois. Comme pour
+ * \c supprimerChevalier, les scores des chevaliers supprimés ne sont pas
+ * libérés.
+ *
+ * \param[in,out] tableau Le tableau de chevaliers à modifier
+ * \param[in] indices Les indices des chevaliers à supprimer
+ * \param[in] nb Le nombre d'indices
+ * \return Le nombre de chevaliers supprimés
+ * \note Si un indice est invalide, le programme termine avec un message d'erreur.
+ */
+int supprimerChevaliers(TableauChevaliers *tableau, const int *indices, int nb){
+    if (nb <= 0 || tableau->nbChevaliers == 0) return 0;
+
+    unsigned char *retire = (unsigned char *)allouerMemoireZero(MEMOIRE_TAMPONS, tableau->nbChevaliers, 1);
+    if (retire == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nb; i++) {
+        if (indices[i] < 0 || indices[i] >= tableau->nbChevaliers) {
+            fprintf(stderr, "Erreur : index %d invalide.\n", indices[i]);
+            exit(EXIT_FAILURE);
+        }
+        retire[indices[i]] = 1;
+    }
+
+    // Compactage : chaque chevalier gardé est déplacé une seule fois
+    int garde = 0;
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        if (!retire[i]) {
+            if (garde != i) tableau->chevaliers[garde] = tableau->chevaliers[i];
+            garde++;
+        }
+    }
+    libererMemoire(MEMOIRE_TAMPONS, retire);
+
+    int supprimes = tableau->nbChevaliers - garde;
+    tableau->nbChevaliers = garde;
+    return supprimes;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Lit la ligne « R nbScores min max somme nbCentroides (moyenne poids fusionne)... » d'un chevalier */
+static Bool lireResume(FILE *fe, ResumeScores *resume, int nbScores){
+    ResumeScores lu;
+    long poidsTotal = 0;
+
+    if (fscanf(fe, " R %d %d %d %lld %d", &lu.nbScores, &lu.min, &lu.max, &lu.somme, &lu.nbCentroides) != 5) {
+        return false;
+    }
+    if (lu.nbScores != nbScores || lu.nbCentroides < 0 || lu.nbCentroides > NB_CENTROIDES) {
+        return false;
+    }
+    for (int i = 0; i < lu.nbCentroides; i++) {
+        int fusionne;
+        if (fscanf(fe, "%f %d %d", &lu.centroides[i].moyenne, &lu.centroides[i].poids, &fusionne) != 3) {
+            return false;
+        }
+        lu.centroides[i].fusionne = (fusionne != 0);
+        poidsTotal += lu.centroides[i].poids;
+    }
+    if (poidsTotal != lu.nbScores) {
+        return false;
+    }
+
+    *resume = lu;
+    return true;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Écrit le résumé d'un chevalier sur une ligne, les moyennes avec assez de chiffres pour être relues à l'identique */
+static void ecrireResume(FILE *fe, const ResumeScores *resume){
+    fprintf(fe, "R %d %d %d %lld %d", resume->nbScores, resume->min, resume->max, resume->somme, resume->nbCentroides);
+    for (int i = 0; i < resume->nbCentroides; i++) {
+        fprintf(fe, " %.9g %d %d", resume->centroides[i].moyenne, resume->centroides[i].poids, resume->centroides[i].fusionne);
+    }
+    fprintf(fe, "\n");
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Lit la ligne « C nbScores somme min max histogramme... » des scores compactés d'un chevalier */
+static Bool lireCompactes(FILE *fe, ScoresCompactes *compactes){
+    ScoresCompactes lu;
+    long total = 0;
+
+    if (fscanf(fe, " C %d %lld %d %d", &lu.nbScores, &lu.somme, &lu.min, &lu.max) != 4 || lu.nbScores < 0) {
+        return false;
+    }
+    for (int i = 0; i < NB_CLASSES_HISTOGRAMME; i++) {
+        if (fscanf(fe, "%d", &lu.histogramme[i]) != 1) {
+            return false;
+        }
+        total += lu.histogramme[i];
+    }
+    if (total != lu.nbScores) {
+        return false;
+    }
+
+    *compactes = lu;
+    return true;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Écrit les scores compactés d'un chevalier sur une ligne */
+static void ecrireCompactes(FILE *fe, const ScoresCompactes *compactes){
+    fprintf(fe, "C %d %lld %d %d", compactes->nbScores, compactes->somme, compactes->min, compactes->max);
+    for (int i = 0; i < NB_CLASSES_HISTOGRAMME; i++) {
+        fprintf(fe, " %d", compactes->histogramme[i]);
+    }
+    fprintf(fe, "\n");
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Construit le chemin d'un fichier du dossier des données
+ *
+ * Le dossier est celui de la variable d'environnement \c SAE_DONNEES si
+ * elle existe, \c DOSSIER_DONNEES sinon. Un '/' est ajouté entre les deux
+ * s'il manque.
+ *
+ * \param[in] nomFichier Le nom du fichier dans le dossier
+ * \return Le chemin, à libérer avec \c libererMemoire (MEMOIRE_TAMPONS)
+ * \note En cas d'erreur d'allocation, le programme termine avec un message d'erreur.
+ */
+char *cheminDonnees(const char *nomFichier) {
+    const char *dossier = getenv("SAE_DONNEES");
+    if (dossier == NULL || dossier[0] == '\0') dossier = DOSSIER_DONNEES;
+    size_t longueur = strlen(dossier);
+    Bool separateur = dossier[longueur - 1] != '/';
+
+    // Le chemin est construit à la taille du nom : un nom long ne déborde pas
+    char *chemin = allouerMemoire(MEMOIRE_TAMPONS, longueur + separateur + strlen(nomFichier) + 1);
+    if (chemin == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    strcpy(chemin, dossier);
+    if (separateur) strcat(chemin, "/");
+    strcat(chemin, nomFichier);
+    return chemin;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Charge un tableau de chevaliers à partir d'un fichier
+ *
+ * Lit le fichier binaire \c FICHIER_SCORES_BINAIRE du dossier des données
+ * (voir \c chargerTableauBinaire). Tant qu'il n'existe pas, le fichier
+ * texte \c FICHIER_SCORES est importé à sa place (voir \c chargerTableauTexte).
+ *
+ * \param[out] nbChevaliers Le nombre de chevaliers lus
+ * \return Un pointeur vers le tableau de chevaliers chargé
+ * \note Si le fichier est absent ou invalide, le programme termine avec un message d'erreur.
+ */
+TableauChevaliers *chargerTableauChevaliers(int *nbChevaliers) {
+    char *chemin = cheminDonnees(FICHIER_SCORES_BINAIRE);
+    TableauChevaliers *tableau;
+    if (access(chemin, F_OK) == 0) {
+        tableau = chargerTableauBinaire(chemin, nbChevaliers);
+    } else {
+        libererMemoire(MEMOIRE_TAMPONS, chemin);
+        chemin = cheminDonnees(FICHIER_SCORES);
+        tableau = chargerTableauTexte(chemin, nbChevaliers);
+    }
+    libererMemoire(MEMOIRE_TAMPONS, chemin);
+    return tableau;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Charge un tableau de chevaliers à partir d'un fichier des scores texte
+ *
+ * Lit un fichier écrit par \c sauvegarderTableauTexte. Les fichiers de
+ * version 1 (sans résumé) et 2 (sans numéros de partie) restent lisibles :
+ * le résumé de chaque chevalier est alors reconstruit à partir de ses
+ * scores, numérotés dans l'ordre du fichier. La politique de rétention
+ * courante est appliquée à chaque chevalier chargé.
+ *
+ * \param[in] chemin Le chemin du fichier des scores
+ * \param[out] nbChevaliers Le nombre de chevaliers lus
+ * \return Un pointeur vers le tableau de chevaliers chargé
+ * \note Si le fichier est absent ou invalide, le programme termine avec un message d'erreur.
+ */
+TableauChevaliers *chargerTableauTexte(const char *chemin, int *nbChevaliers) {
+    char pseudo[LONGUEUR_MAX_PSEUDO + 1];
+    int nb_scores = 0;
+    int nb_conserves = 0;
+    int score, numero;
+    FILE *fe;
+
+    DEBUT_MESURE(MESURE_CHARGEMENT);
+
+    // Ouvrir le fichier
+    if ((fe = fopen(chemin, "r")) == NULL) {
+        perror("Impossible d'ouvrir le fichier");
+        exit(EXIT_FAILURE);
+    }
+
+    // Lire le nombre de chevaliers, suivi de la version du format à partir de la version 2
+    char entete[64];
+    int version = 1;
+    if (fgets(entete, sizeof(entete), fe) == NULL || sscanf(entete, "%d %d", nbChevaliers, &version) < 1 || *nbChevaliers < 0) {
+        fprintf(stderr, "Erreur : format du fichier invalide (nombre de chevaliers).\n");
+        fclose(fe);
+        exit(EXIT_FAILURE);
+    }
+
+    // Une ligne de chevalier occupe au moins 4 octets : un nombre annoncé plus grand que le fichier
+    // ne réserve pas plus, la croissance géométrique du tableau prend le relais si besoin
+    long debut = ftell(fe);
+    fseek(fe, 0, SEEK_END);
+    long taille = ftell(fe) - debut;
+    fseek(fe, debut, SEEK_SET);
+    TableauChevaliers *tableau = creerTableauChevaliers((*nbChevaliers < taille / 4) ? *nbChevaliers : (int)(taille / 4));
+
+    // Lecture des chevaliers
+    for (int i = 0; i < *nbChevaliers; i++) {
+        // À partir de la version 3, la ligne donne aussi le nombre de scores conservés
+        Bool lu = (version >= 3) ? fscanf(fe, "%40s %d %d", pseudo, &nb_scores, &nb_conserves) == 3
+                                 : fscanf(fe, "%40s %d", pseudo, &nb_scores) == 2;
+        if (!lu || (version >= 3 && (nb_conserves < 0 || nb_conserves > nb_scores))) {
+            fprintf(stderr, "Erreur : format du fichier invalide (chevalier %d).\n", i + 1);
+            fclose(fe);
+            libererTableauChevaliers(tableau);  // Libérer la mémoire du tableau en cas d'erreur
+            exit(EXIT_FAILURE);
+        }
+
+        // Créer un nouveau chevalier
+        Chevalier chevalier = creerChevalier(pseudo);
+
+        if (version >= 3) {
+            // Scores conservés avec leur numéro de partie, puis résumé et scores compactés
+            chevalier.nbParties = nb_scores;
+            for (int j = 0; j < nb_conserves; j++) {
+                if (fscanf(fe, "%d %d", &score, &numero) != 2) {
+                    fprintf(stderr, "Erreur : format du fichier invalide (score du chevalier %s).\n", pseudo);
+                    fclose(fe);
+                    libererTableauChevaliers(tableau);
+                    exit(EXIT_FAILURE);
+                }
+                insererMaillon(&chevalier, score, numero);
+            }
+            HistoriqueScores *historique = historiqueChevalier(&chevalier);
+            if (!lireResume(fe, &historique->resume, nb_scores) || !lireCompactes(fe, &historique->compactes)
+                || historique->compactes.nbScores + nb_conserves != nb_scores) {
+                fprintf(stderr, "Erreur : format du fichier invalide (résumé du chevalier %s).\n", pseudo);
+                fclose(fe);
+                libererTableauChevaliers(tableau);
+                exit(EXIT_FAILURE);
+            }
+            compterCompactes(&historique->compactes, 1);
+            appliquerRetention(&chevalier);
+        } else {
+            // Lire les scores du chevalier
+            for (int j = 0; j < nb_scores; j++) {
+                if (fscanf(fe, "%d", &score) != 1) {
+                    fprintf(stderr, "Erreur : format du fichier invalide (score du chevalier %s).\n", pseudo);
+                    fclose(fe);
+                    libererTableauChevaliers(tableau);  // Libérer la mémoire du tableau en cas d'erreur
+                    exit(EXIT_FAILURE);
+                }
+                ajouterScore(&chevalier, score);
+            }
+
+            // Le résumé enregistré remplace celui reconstruit à partir des scores
+            if (version == 2 && !lireResume(fe, &historiqueChevalier(&chevalier)->resume, nb_scores)) {
+                fprintf(stderr, "Erreur : format du fichier invalide (résumé du chevalier %s).\n", pseudo);
+                fclose(fe);
+                libererTableauChevaliers(tableau);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        // Ajouter le chevalier au tableau
+        ajouterChevalier(tableau, chevalier);
+    }
+
+    fclose(fe);
+    FIN_MESURE(MESURE_CHARGEMENT);
+    return tableau;
+}
+
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Sauvegarde un tableau de chevaliers dans un fichier
+ *
+ * Écrit le tableau dans le fichier binaire \c FICHIER_SCORES_BINAIRE du
+ * dossier des données (voir \c sauvegarderTableauBinaire). Le fichier
+ * texte \c FICHIER_SCORES n'est plus réécrit.
+ *
+ * \param[in] tableau Le tableau de chevaliers à sauvegarder
+ * \note Si le fichier ne peut pas être ouvert, le programme termine avec un message d'erreur.
+ */
+void sauvegarderTableauChevaliers(TableauChevaliers *tableau) {
+    char *chemin = cheminDonnees(FICHIER_SCORES_BINAIRE);
+    sauvegarderTableauBinaire(tableau, chemin);
+    libererMemoire(MEMOIRE_TAMPONS, chemin);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Sauvegarde un tableau de chevaliers dans un fichier des scores texte
+ *
+ * Écrit le pseudo et le nombre de parties de chaque chevalier avec ses
+ * scores conservés, son résumé et ses scores compactés (format de version
+ * \c VERSION_FICHIER_SCORES), lisible par \c chargerTableauTexte.
+ *
+ * \param[in] tableau Le tableau de chevaliers à sauvegarder
+ * \param[in] chemin Le chemin du fichier des scores
+ * \note Si le fichier ne peut pas être ouvert, le programme termine avec un message d'erreur.
+ */
+void sauvegarderTableauTexte(TableauChevaliers *tableau, const char *chemin) {
+    FILE *fe;
+
+    DEBUT_MESURE(MESURE_SAUVEGARDE);
+
+    // Ouvrir le fichier en mode écriture
+    if ((fe = fopen(chemin, "w")) == NULL) {
+        perror("Impossible d'ouvrir le fichier");
+        exit(EXIT_FAILURE);
+    }
+
+    // Écrire le nombre total de chevaliers et la version du format
+    fprintf(fe, "%d %d\n", tableau->nbChevaliers, VERSION_FICHIER_SCORES);
+
+    // Parcourir chaque chevalier dans le tableau
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        ecrireChevalierTexte(fe, texteChaine(tableau->chevaliers[i].pseudo), &tableau->chevaliers[i]);
+    }
+
+    // Fermer le fichier
+    fclose(fe);
+    FIN_MESURE(MESURE_SAUVEGARDE);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Écrit un chevalier dans un fichier des scores
+ *
+ * Écrit les lignes d'un chevalier au format de version
+ * \c VERSION_FICHIER_SCORES, sans l'en-tête du fichier : permet d'écrire
+ * un fichier chevalier par chevalier sans garder tout le tableau.
+ *
+ * \param[in] fe Le fichier ouvert en écriture
+ * \param[in] pseudo Le pseudo écrit pour ce chevalier
+ * \param[in] chevalier Le chevalier à écrire
+ */
+void ecrireChevalierTexte(FILE *fe, const char *pseudo, const Chevalier *chevalier){
+    // Écrire le pseudo, le nombre de parties et le nombre de scores conservés
+    int nbConserves = nombreScoresBloc(chevalier->scoresCompresses);
+    for (MaillonScore *m = chevalier->firstScore; m != NULL; m = m->next) {
+        nbConserves++;
+    }
+    fprintf(fe, "%s %d %d\n", pseudo, chevalier->nbParties, nbConserves);
+
+    // Parcourir et écrire les scores avec leur numéro de partie
+    MaillonScore *currentScore = chevalier->firstScore;
+    while (currentScore != NULL) {
+        fprintf(fe, "%d %d ", currentScore->score, currentScore->numero);
+        currentScore = currentScore->next;
+    }
+    LecteurScores lecteur;
+    ouvrirListeScores(&lecteur, chevalier->scoresCompresses);
+    while (scoreSuivant(&lecteur)) {
+        fprintf(fe, "%d %d ", lecteur.score, lecteur.numero);
+    }
+    fprintf(fe, "\n"); // Saut de ligne après les scores d'un chevalier
+    ecrireResume(fe, &lireHistorique(chevalier)->resume);
+    ecrireCompactes(fe, &lireHistorique(chevalier)->compactes);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compresse la liste des scores d'un chevalier
+ *
+ * Les maillons sont remplacés par un bloc d'octets (environ 3 octets par
+ * score au lieu d'un maillon alloué). Le chevalier est décompressé
+ * automatiquement par \c ajouterScore.
+ *
+ * \param[in,out] chevalier Le chevalier à compresser
+ */
+void compresserChevalier(Chevalier *chevalier){
+    if (chevalier->firstScore == NULL) return;
+
+    // Un chevalier déjà froid qui a de nouveaux maillons est d'abord décompressé entièrement
+    if (chevalier->scoresCompresses != NULL) {
+        decompresserChevalier(chevalier);
+    }
+    chevalier->scoresCompresses = compresserListeScores(chevalier->firstScore, &chevalier->tailleCompresses);
+
+    // Les scores restent comptés dans l'arbre des scores : ils changent seulement de forme
+    MaillonScore *current = chevalier->firstScore;
+    while (current != NULL) {
+        MaillonScore *tmp = current;
+        current = current->next;
+        rendreMaillonScore(tmp);
+    }
+    chevalier->firstScore = NULL;
+    chevalier->lastScore = NULL;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Reconstruit la liste des scores d'un chevalier compressé
+ *
+ * \param[in,out] chevalier Le chevalier à décompresser
+ */
+void decompresserChevalier(Chevalier *chevalier){
+    LecteurScores lecteur;
+
+    if (chevalier->scoresCompresses == NULL) return;
+
+    // Le bloc est déjà dans l'ordre décroissant : les maillons sont ajoutés en fin de liste
+    ouvrirListeScores(&lecteur, chevalier->scoresCompresses);
+    while (scoreSuivant(&lecteur)) {
+        MaillonScore *maillon = prendreMaillonScore();
+        maillon->score = lecteur.score;
+        maillon->numero = lecteur.numero;
+        maillon->next = NULL;
+        if (chevalier->lastScore == NULL) {
+            chevalier->firstScore = maillon;
+        } else {
+            chevalier->lastScore->next = maillon;
+        }
+        chevalier->lastScore = maillon;
+    }
+
+    libererMemoire(MEMOIRE_SCORES, chevalier->scoresCompresses);
+    chevalier->scoresCompresses = NULL;
+    chevalier->tailleCompresses = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compresse tous les chevaliers d'un tableau
+ *
+ * \param[in,out] tableau Le tableau de chevaliers
+ */
+void compresserTableau(TableauChevaliers *tableau){
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        compresserChevalier(&tableau->chevaliers[i]);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le meilleur score d'un chevalier, compressé ou non
+ *
+ * Lu dans le chevalier : ni la liste ni le bloc compressé ne sont parcourus.
+ *
+ * \param[in] chevalier Le chevalier
+ * \return Le meilleur score, 0 si le chevalier n'a aucun score
+ */
+int meilleurScoreChevalier(const Chevalier *chevalier){
+    return chevalier->meilleurScore;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Suite d'octets qui grandit au fur et à mesure de l'écriture du fichier binaire */
+typedef struct {
+    unsigned char *octets;
+    size_t taille;
+    size_t capacite;
+} TamponOctets;
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Ajoute des octets à la fin du tampon */
+static void ecrireOctets(TamponOctets *tampon, const void *octets, size_t taille){
+    if (tampon->taille + taille > tampon->capacite) {
+        size_t capacite = (tampon->capacite == 0) ? 4096 : tampon->capacite;
+        while (tampon->taille + taille > capacite) {
+            capacite *= 2;
+        }
+        unsigned char *nouveau = (unsigned char *)reallouerMemoire(MEMOIRE_TAMPONS, tampon->octets, capacite);
+        if (nouveau == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        tampon->octets = nouveau;
+        tampon->capacite = capacite;
+    }
+    memcpy(tampon->octets + tampon->taille, octets, taille);
+    tampon->taille += taille;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Ajoute un entier non signé en LEB128 */
+static void ecrireVarint(TamponOctets *tampon, unsigned long long valeur){
+    unsigned char octets[TAILLE_MAX_VARINT];
+    ecrireOctets(tampon, octets, encoderVarint(valeur, octets));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Sauvegarde un tableau de chevaliers dans un fichier binaire compact
+ *
+ * Les listes de scores sont écrites sous forme compressée (écarts en
+ * LEB128), comme les autres entiers du fichier.
+ *
+ * \param[in] tableau Le tableau de chevaliers à sauvegarder
+ * \param[in] chemin Le chemin du fichier
+ * \note Si le fichier ne peut pas être écrit, le programme termine avec un message d'erreur.
+ */
+void sauvegarderTableauBinaire(TableauChevaliers *tableau, const char *chemin){
+    DEBUT_MESURE(MESURE_SAUVEGARDE);
+    TamponOctets tampon = {NULL, 0, 0};
+
+    ecrireOctets(&tampon, SIGNATURE_FICHIER_BINAIRE, 4);
+    ecrireVarint(&tampon, tableau->nbChevaliers);
+
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        Chevalier *chevalier = &tableau->chevaliers[i];
+        const char *pseudo = texteChaine(chevalier->pseudo);
+        size_t longueur = strlen(pseudo);
+
+        ecrireVarint(&tampon, longueur);
+        ecrireOctets(&tampon, pseudo, longueur);
+        ecrireVarint(&tampon, chevalier->nbParties);
+
+        // Les chevaliers chauds sont compressés à la volée, les froids écrits tels quels
+        if (chevalier->scoresCompresses != NULL) {
+            ecrireVarint(&tampon, chevalier->tailleCompresses);
+            ecrireOctets(&tampon, chevalier->scoresCompresses, chevalier->tailleCompresses);
+        } else {
+            int taille;
+            unsigned char *bloc = compresserListeScores(chevalier->firstScore, &taille);
+            ecrireVarint(&tampon, taille);
+            ecrireOctets(&tampon, bloc, taille);
+            libererMemoire(MEMOIRE_SCORES, bloc);
+        }
+
+        const ResumeScores *resume = &lireHistorique(chevalier)->resume;
+        ecrireVarint(&tampon, resume->nbScores);
+        ecrireVarint(&tampon, encoderZigzag(resume->min));
+        ecrireVarint(&tampon, encoderZigzag(resume->max));
+        ecrireVarint(&tampon, encoderZigzag(resume->somme));
+        ecrireVarint(&tampon, resume->nbCentroides);
+        for (int j = 0; j < resume->nbCentroides; j++) {
+            unsigned char fusionne = resume->centroides[j].fusionne;
+            ecrireOctets(&tampon, &resume->centroides[j].moyenne, sizeof(float));
+            ecrireVarint(&tampon, resume->centroides[j].poids);
+            ecrireOctets(&tampon, &fusionne, 1);
+        }
+
+        const ScoresCompactes *compactes = &lireHistorique(chevalier)->compactes;
+        ecrireVarint(&tampon, compactes->nbScores);
+        ecrireVarint(&tampon, encoderZigzag(compactes->somme));
+        ecrireVarint(&tampon, encoderZigzag(compactes->min));
+        ecrireVarint(&tampon, encoderZigzag(compactes->max));
+        for (int j = 0; j < NB_CLASSES_HISTOGRAMME; j++) {
+            ecrireVarint(&tampon, compactes->histogramme[j]);
+        }
+    }
+
+    FILE *fs = fopen(chemin, "wb");
+    if (fs == NULL) {
+        perror("Impossible d'ouvrir le fichier");
+        exit(EXIT_FAILURE);
+    }
+    if (fwrite(tampon.octets, 1, tampon.taille, fs) != tampon.taille) {
+        perror("Erreur d'écriture du fichier");
+        exit(EXIT_FAILURE);
+    }
+    fclose(fs);
+    libererMemoire(MEMOIRE_TAMPONS, tampon.octets);
+    FIN_MESURE(MESURE_SAUVEGARDE);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Curseur de lecture du fichier binaire : toute lecture après la fin rend le fichier invalide */
+typedef struct {
+    const unsigned char *position;
+    const unsigned char *fin;
+    Bool valide;
+} LectureBinaire;
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Lit un entier LEB128 ; le tampon du fichier est suivi d'octets nuls, le décodage ne peut pas déborder */
+static unsigned long long lireVarint(LectureBinaire *lecture){
+    unsigned long long valeur = 0;
+    if (lecture->position >= lecture->fin) {
+        lecture->valide = false;
+        return 0;
+    }
+    lecture->position = decoderVarint(lecture->position, &valeur);
+    if (lecture->position > lecture->fin) {
+        lecture->valide = false;
+    }
+    return valeur;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Lit des octets bruts */
+static const unsigned char *lireOctets(LectureBinaire *lecture, size_t taille){
+    const unsigned char *debut = lecture->position;
+    if ((size_t)(lecture->fin - lecture->position) < taille) {
+        lecture->valide = false;
+        return NULL;
+    }
+    lecture->position += taille;
+    return debut;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Lit un chevalier du fichier binaire ; ses scores restent compressés */
+static Bool lireChevalierBinaire(LectureBinaire *lecture, Chevalier *chevalier){
+    char pseudo[LONGUEUR_MAX_PSEUDO + 1];
+    size_t longueur = lireVarint(lecture);
+    const unsigned char *octets = lireOctets(lecture, longueur);
+    if (!lecture->valide || longueur >= sizeof(pseudo)) return false;
+    memcpy(pseudo, octets, longueur);
+    pseudo[longueur] = '\0';
+
+    *chevalier = creerChevalier(pseudo);
+    chevalier->nbParties = (int)lireVarint(lecture);
+
+    int taille = (int)lireVarint(lecture);
+    octets = lireOctets(lecture, taille);
+    if (!lecture->valide || taille <= 0) return false;
+
+    // Un bloc d'une liste vide ne contient que son nombre de scores (0) : il n'est pas gardé
+    if (nombreScoresBloc(octets) > 0) {
+        chevalier->scoresCompresses = (unsigned char *)allouerMemoire(MEMOIRE_SCORES, taille + TAILLE_MAX_VARINT);
+        if (chevalier->scoresCompresses == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(chevalier->scoresCompresses, octets, taille);
+        memset(chevalier->scoresCompresses + taille, 0, TAILLE_MAX_VARINT);
+        chevalier->tailleCompresses = taille;
+
+        LecteurScores lecteur;
+        ouvrirListeScores(&lecteur, chevalier->scoresCompresses);
+        while (scoreSuivant(&lecteur)) {
+            compterScore(lecteur.score, 1);
+            if (lecteur.lus == 1) chevalier->meilleurScore = lecteur.score;  // Le premier score du bloc est le meilleur
+        }
+    }
+
+    ResumeScores *resume = &historiqueChevalier(chevalier)->resume;
+    resume->nbScores = (int)lireVarint(lecture);
+    resume->min = (int)decoderZigzag(lireVarint(lecture));
+    resume->max = (int)decoderZigzag(lireVarint(lecture));
+    resume->somme = decoderZigzag(lireVarint(lecture));
+    resume->nbCentroides = (int)lireVarint(lecture);
+    if (!lecture->valide || resume->nbCentroides > NB_CENTROIDES) return false;
+    for (int j = 0; j < resume->nbCentroides; j++) {
+        octets = lireOctets(lecture, sizeof(float));
+        if (octets != NULL) memcpy(&resume->centroides[j].moyenne, octets, sizeof(float));
+        resume->centroides[j].poids = (int)lireVarint(lecture);
+        octets = lireOctets(lecture, 1);
+        resume->centroides[j].fusionne = (octets != NULL && *octets != 0);
     }
-    tableau->nbChevaliers--;
+
+    ScoresCompactes *compactes = &chevalier->historique->compactes;
+    compactes->nbScores = (int)lireVarint(lecture);
+    compactes->somme = decoderZigzag(lireVarint(lecture));
+    compactes->min = (int)decoderZigzag(lireVarint(lecture));
+    compactes->max = (int)decoderZigzag(lireVarint(lecture));
+    long totalHistogramme = 0;
+    for (int j = 0; j < NB_CLASSES_HISTOGRAMME; j++) {
+        compactes->histogramme[j] = (int)lireVarint(lecture);
+        totalHistogramme += compactes->histogramme[j];
+    }
+    if (!lecture->valide || totalHistogramme != compactes->nbScores) return false;
+    compterCompactes(compactes, 1);
+
+    return lecture->valide && resume->nbScores == chevalier->nbParties;
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 
 /**
- * \brief Charge un tableau de chevaliers à partir d'un fichier
+ * \brief Charge un tableau de chevaliers depuis un fichier binaire compact
  *
- * Lit le fichier "scores.txt" et charge les chevaliers avec leurs scores
- * dans un tableau de chevaliers.
+ * Les chevaliers chargés sont froids : leurs scores restent compressés.
  *
+ * \param[in] chemin Le chemin du fichier écrit par \c sauvegarderTableauBinaire
  * \param[out] nbChevaliers Le nombre de chevaliers lus
  * \return Un pointeur vers le tableau de chevaliers chargé
+ * \note Si le fichier est absent ou invalide, le programme termine avec un message d'erreur.
  */
-TableauChevaliers *chargerTableauChevaliers(int *nbChevaliers) {
-    char pseudo[40];
-    int nb_scores = 0;
-    int score;
-    FILE *fe;
-
-    // Ouvrir le fichier
-    if ((fe = fopen("src/fichier/scores.txt", "r")) == NULL) {
+TableauChevaliers *chargerTableauBinaire(const char *chemin, int *nbChevaliers){
+    DEBUT_MESURE(MESURE_CHARGEMENT);
+    FILE *fe = fopen(chemin, "rb");
+    if (fe == NULL) {
         perror("Impossible d'ouvrir le fichier");
         exit(EXIT_FAILURE);
     }
 
-    // Lire le nombre de chevaliers
-    if (fscanf(fe, "%d", nbChevaliers) != 1) {
-        fprintf(stderr, "Erreur : format du fichier invalide (nombre de chevaliers).\n");
-        fclose(fe);
+    // Le fichier est lu en une fois, suivi d'octets nuls pour que le décodage ne déborde jamais
+    fseek(fe, 0, SEEK_END);
+    long taille = ftell(fe);
+    fseek(fe, 0, SEEK_SET);
+    unsigned char *contenu = (unsigned char *)allouerMemoireZero(MEMOIRE_TAMPONS, taille + TAILLE_MAX_VARINT, 1);
+    if (contenu == NULL) {
+        perror("Erreur d'allocation mémoire");
         exit(EXIT_FAILURE);
     }
+    if (fread(contenu, 1, taille, fe) != (size_t)taille) {
+        perror("Erreur de lecture du fichier");
+        exit(EXIT_FAILURE);
+    }
+    fclose(fe);
 
-    // Créer le tableau dynamique de chevaliers
-    TableauChevaliers *tableau = creerTableauChevaliers(*nbChevaliers);
+    LectureBinaire lecture = {contenu, contenu + taille, true};
+    const unsigned char *signature = lireOctets(&lecture, 4);
+    if (signature == NULL || memcmp(signature, SIGNATURE_FICHIER_BINAIRE, 4) != 0) {
+        fprintf(stderr, "Erreur : %s n'est pas un fichier de scores binaire.\n", chemin);
+        exit(EXIT_FAILURE);
+    }
 
-    // Lecture des chevaliers
+    // Un chevalier occupe plus de 4 octets : un nombre plus grand que le fichier ne réserve pas plus
+    *nbChevaliers = (int)lireVarint(&lecture);
+    TableauChevaliers *tableau = creerTableauChevaliers((*nbChevaliers < taille / 4) ? *nbChevaliers : (int)(taille / 4));
     for (int i = 0; i < *nbChevaliers; i++) {
-        if (fscanf(fe, "%s %d", pseudo, &nb_scores) != 2) {
+        Chevalier chevalier;
+        if (!lireChevalierBinaire(&lecture, &chevalier)) {
             fprintf(stderr, "Erreur : format du fichier invalide (chevalier %d).\n", i + 1);
-            fclose(fe);
-            libererTableauChevaliers(tableau);  // Libérer la mémoire du tableau en cas d'erreur
             exit(EXIT_FAILURE);
         }
 
-        // Créer un nouveau chevalier
-        Chevalier chevalier = creerChevalier(pseudo);
-
-        // Lire les scores du chevalier
-        for (int j = 0; j < nb_scores; j++) {
-            if (fscanf(fe, "%d", &score) != 1) {
-                fprintf(stderr, "Erreur : format du fichier invalide (score du chevalier %s).\n", pseudo);
-                fclose(fe);
-                libererTableauChevaliers(tableau);  // Libérer la mémoire du tableau en cas d'erreur
-                exit(EXIT_FAILURE);
-            }
-            ajouterScore(&chevalier, score);
+        // La politique de rétention courante s'applique aussi au chargement
+        if (retentionMeilleurs > 0 && nombreScoresBloc(chevalier.scoresCompresses) > retentionMeilleurs + retentionDerniers) {
+            decompresserChevalier(&chevalier);
+            appliquerRetention(&chevalier);
+            compresserChevalier(&chevalier);
         }
-
-        // Ajouter le chevalier au tableau
         ajouterChevalier(tableau, chevalier);
     }
 
-    fclose(fe);
+    libererMemoire(MEMOIRE_TAMPONS, contenu);
+    FIN_MESURE(MESURE_CHARGEMENT);
     return tableau;
 }
 
-
-/*---------------------------------------------------------------------------------------------------------------------------------*/
-
-/**
- * \brief Sauvegarde un tableau de chevaliers dans un fichier
- * 
- * Écrit les informations du tableau de chevaliers, comprenant le pseudo
- * le nombre de parties de chaque chevalier avec leurs scores, dans le fichier "scores.txt".
- * 
- * \param[in] tableau Le tableau de chevaliers à sauvegarder
- * \note Si le fichier ne peut pas être ouvert, le programme termine avec un message d'erreur.
- */
-void sauvegarderTableauChevaliers(TableauChevaliers *tableau) {
-    FILE *fe;
-
-    // Ouvrir le fichier en mode écriture
-    if ((fe = fopen("src/fichier/scores.txt", "w")) == NULL) {
-        perror("Impossible d'ouvrir le fichier");
-        exit(EXIT_FAILURE);
-    }
-
-    // Écrire le nombre total de chevaliers
-    fprintf(fe, "%d\n", tableau->nbChevaliers);
-
-    // Parcourir chaque chevalier dans le tableau
-    for (int i = 0; i < tableau->nbChevaliers; i++) {
-        // Écrire le pseudo et le nombre de parties
-        fprintf(fe, "%s %d\n", tableau->chevaliers[i].pseudo, tableau->chevaliers[i].nbParties);
-
-        // Parcourir et écrire les scores
-        MaillonScore *currentScore = tableau->chevaliers[i].firstScore;
-        while (currentScore != NULL) {
-            fprintf(fe, "%d ", currentScore->score);
-            currentScore = currentScore->next;
-        }
-        fprintf(fe, "\n"); // Saut de ligne après les scores d'un chevalier
-    }
-
-    // Fermer le fichier
-    fclose(fe);
-}
-
-
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 
 /**
@@ -332,7 +1370,7 @@ void sauvegarderTableauChevaliers(TableauChevaliers *tableau) {
  */
 int rechercheChevalierExiste(TableauChevaliers *tableau, Chevalier *chevalier){
     for (int i = 0; i < tableau->nbChevaliers; i++) {
-        if (strcmp(tableau->chevaliers[i].pseudo, chevalier->pseudo) == 0) {
+        if (tableau->chevaliers[i].pseudo == chevalier->pseudo) {
             return i;
         }
     }
@@ -361,24 +1399,40 @@ Bool chevalierExiste(TableauChevaliers *tableau, Chevalier *chevalier) {
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 
-/**
- * \brief Ajoute un score à la liste des scores du chevalier
- *
- * \param   Chevalier    chevalier à modifier
- * \param   score        score à ajouter
- *
- * Ajoute un score à la liste des scores du chevalier en l'insérant
- * dans l'ordre décroissant. Si la liste est vide, on ajoute le score
- * directement.
- */
-void ajouterScore(Chevalier *chevalier, int score) {
-    MaillonScore *newScore = (MaillonScore *)malloc(sizeof(MaillonScore));
-    if (newScore == NULL) {
-        perror("Erreur d'allocation mémoire\n");
-        exit(EXIT_FAILURE);
+/* Ajoute delta au compte d'un score dans l'arbre de Fenwick, en O(log SCORE_MAX) */
+static void compterScore(int score, int delta){
+    if (score < 0) score = 0;
+    if (score > SCORE_MAX) score = SCORE_MAX;
+
+    // Les ajouts atomiques permettent aux fragments du registre d'enregistrer en parallèle
+    for (int i = score + 1; i <= TAILLE_ARBRE_SCORES; i += i & -i) {
+        __atomic_fetch_add(&arbreScores[i], delta, __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&totalScores, delta, __ATOMIC_RELAXED);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Nombre de scores strictement inférieurs à un score */
+static int compterScoresInferieurs(int score){
+    int total = 0;
+    if (score <= 0) return 0;
+    if (score > TAILLE_ARBRE_SCORES) score = TAILLE_ARBRE_SCORES;
+
+    for (int i = score; i > 0; i -= i & -i) {
+        total += __atomic_load_n(&arbreScores[i], __ATOMIC_RELAXED);
     }
+    return total;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Insère un score à sa place dans la liste triée par ordre décroissant */
+static void insererMaillon(Chevalier *chevalier, int score, int numero) {
+    MaillonScore *newScore = prendreMaillonScore();
 
     newScore->score = score;
+    newScore->numero = numero;
     newScore->next = NULL;
 
     // Si la liste est vide, on insère directement le premier maillon
@@ -407,7 +1461,251 @@ void ajouterScore(Chevalier *chevalier, int score) {
         }
     }
 
+    // La rétention garde toujours le premier maillon : le meilleur score ne fait que monter
+    chevalier->meilleurScore = chevalier->firstScore->score;
+    compterScore(score, 1);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Classe de l'histogramme d'un score : 0 pour les scores nuls, puis une classe par puissance de 2 */
+static int classeHistogramme(int score){
+    int classe = 0;
+    while (score > 0 && classe < NB_CLASSES_HISTOGRAMME - 1) {
+        score >>= 1;
+        classe++;
+    }
+    return classe;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Valeur qui représente une classe de l'histogramme dans l'arbre des scores : le milieu de la classe */
+static int valeurClasse(int classe){
+    if (classe == 0) return 0;
+    int bas = 1 << (classe - 1);
+    int haut = (classe == NB_CLASSES_HISTOGRAMME - 1) ? SCORE_MAX : (1 << classe) - 1;
+    return bas + (haut - bas) / 2;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Ajoute delta fois chaque score compacté à l'arbre des scores, à la valeur de sa classe */
+static void compterCompactes(const ScoresCompactes *compactes, int delta){
+    for (int classe = 0; classe < NB_CLASSES_HISTOGRAMME; classe++) {
+        if (compactes->histogramme[classe] != 0) {
+            compterScore(valeurClasse(classe), delta * compactes->histogramme[classe]);
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Ajoute un score retiré de la liste aux agrégats compactés */
+static void compacterScore(ScoresCompactes *compactes, int score){
+    if (compactes->nbScores == 0 || score < compactes->min) compactes->min = score;
+    if (compactes->nbScores == 0 || score > compactes->max) compactes->max = score;
+    compactes->nbScores++;
+    compactes->somme += score;
+    compactes->histogramme[classeHistogramme(score)]++;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Retire de la liste les scores qui ne sont ni parmi les meilleurs ni parmi les derniers */
+static void appliquerRetention(Chevalier *chevalier){
+    if (retentionMeilleurs <= 0 || chevalier->firstScore == NULL) return;
+
+    // Les derniers scores sont ceux dont le numéro de partie dépasse cette limite
+    int limiteRecents = chevalier->nbParties - retentionDerniers;
+    int rang = 0;
+    MaillonScore *precedent = NULL;
+    MaillonScore *current = chevalier->firstScore;
+
+    // Le premier maillon est toujours gardé (rang 0 < retentionMeilleurs) : precedent n'est jamais NULL lors d'un retrait
+    while (current != NULL) {
+        MaillonScore *suivant = current->next;
+        if (rang < retentionMeilleurs || current->numero > limiteRecents) {
+            precedent = current;
+        } else {
+            // Le score reste compté dans l'arbre, déplacé au milieu de sa classe comme ceux relus du fichier
+            compacterScore(&historiqueChevalier(chevalier)->compactes, current->score);
+            compterScore(current->score, -1);
+            compterScore(valeurClasse(classeHistogramme(current->score)), 1);
+            precedent->next = suivant;
+            rendreMaillonScore(current);
+        }
+        rang++;
+        current = suivant;
+    }
+    chevalier->lastScore = precedent;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Change la politique de rétention des scores
+ *
+ * Chaque chevalier garde dans sa liste ses \c nbMeilleurs meilleurs scores
+ * et ses \c nbDerniers derniers scores. Les autres sont compactés dans ses
+ * \c ScoresCompactes, et restent comptés par les requêtes de rang au
+ * milieu de leur classe d'histogramme. La politique s'applique aux ajouts
+ * suivants et au chargement du fichier des scores.
+ *
+ * \param[in] nbMeilleurs Le nombre de meilleurs scores gardés (au moins 1), 0 ou moins pour tout garder
+ * \param[in] nbDerniers Le nombre de derniers scores gardés
+ */
+void definirRetention(int nbMeilleurs, int nbDerniers){
+    retentionMeilleurs = nbMeilleurs;
+    retentionDerniers = (nbDerniers < 0) ? 0 : nbDerniers;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Ajoute un score à la liste des scores du chevalier
+ *
+ * \param   Chevalier    chevalier à modifier
+ * \param   score        score à ajouter
+ *
+ * Ajoute un score à la liste des scores du chevalier en l'insérant
+ * dans l'ordre décroissant. Si la liste est vide, on ajoute le score
+ * directement. La politique de rétention est ensuite appliquée : la
+ * liste ne dépasse jamais la somme des deux limites.
+ */
+void ajouterScore(Chevalier *chevalier, int score) {
+    if (chevalier->scoresCompresses != NULL) {
+        decompresserChevalier(chevalier);
+    }
     chevalier->nbParties++;
+    insererMaillon(chevalier, score, chevalier->nbParties);
+    ajouterAuResume(&historiqueChevalier(chevalier)->resume, score);
+    appliquerRetention(chevalier);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Initialise un résumé de scores vide
+ *
+ * \param[out] resume Le résumé à initialiser
+ */
+void initialiserResume(ResumeScores *resume){
+    resume->nbScores = 0;
+    resume->min = 0;
+    resume->max = 0;
+    resume->somme = 0;
+    resume->nbCentroides = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Fusionne les deux centroïdes voisins dont le poids compte le moins pour les quantiles */
+static void fusionnerCentroides(ResumeScores *resume){
+    Centroide *c = resume->centroides;
+    double cumul = 0, meilleurCout = 0;
+    int meilleur = 0;
+
+    // Un groupe au milieu peut être gros, un groupe près de q = 0 ou q = 1 doit rester petit
+    for (int i = 0; i + 1 < resume->nbCentroides; i++) {
+        double poids = c[i].poids + c[i + 1].poids;
+        double q = (cumul + poids / 2) / resume->nbScores;
+        double cout = poids / (q * (1 - q) + 1e-9);
+        if (i == 0 || cout < meilleurCout) {
+            meilleurCout = cout;
+            meilleur = i;
+        }
+        cumul += c[i].poids;
+    }
+
+    int poids = c[meilleur].poids + c[meilleur + 1].poids;
+    c[meilleur].moyenne = ((double)c[meilleur].moyenne * c[meilleur].poids + (double)c[meilleur + 1].moyenne * c[meilleur + 1].poids) / poids;
+    c[meilleur].poids = poids;
+    c[meilleur].fusionne = true;
+    memmove(&c[meilleur + 1], &c[meilleur + 2], (resume->nbCentroides - meilleur - 2) * sizeof(Centroide));
+    resume->nbCentroides--;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Ajoute un score au résumé
+ *
+ * Coût en O(NB_CENTROIDES), indépendant du nombre de scores déjà ajoutés.
+ *
+ * \param[in,out] resume Le résumé
+ * \param[in] score Le score à ajouter
+ */
+void ajouterAuResume(ResumeScores *resume, int score){
+    Centroide *c = resume->centroides;
+
+    if (resume->nbScores == 0 || score < resume->min) resume->min = score;
+    if (resume->nbScores == 0 || score > resume->max) resume->max = score;
+    resume->nbScores++;
+    resume->somme += score;
+
+    // Place du score parmi les centroïdes rangés par moyenne
+    int i = 0;
+    while (i < resume->nbCentroides && c[i].moyenne < score) {
+        i++;
+    }
+    if (i < resume->nbCentroides && c[i].moyenne == score && !c[i].fusionne) {
+        c[i].poids++;
+        return;
+    }
+
+    memmove(&c[i + 1], &c[i], (resume->nbCentroides - i) * sizeof(Centroide));
+    c[i].moyenne = score;
+    c[i].poids = 1;
+    c[i].fusionne = false;
+    resume->nbCentroides++;
+
+    if (resume->nbCentroides > NB_CENTROIDES) {
+        fusionnerCentroides(resume);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Estime un quantile à partir du résumé
+ *
+ * Donne le plus petit score qui couvre au moins \c q des scores, comme
+ * \c scoreCentile. Le résultat est exact tant que le chevalier a au plus
+ * \c NB_CENTROIDES scores distincts, et approché au-delà.
+ *
+ * \param[in] resume Le résumé
+ * \param[in] q Le quantile voulu, entre 0 et 1 (0.5 pour la médiane)
+ * \return Le score estimé, 0 si le résumé est vide
+ */
+float quantileResume(const ResumeScores *resume, double q){
+    const Centroide *c = resume->centroides;
+
+    if (resume->nbScores == 0) return 0;
+
+    // Rang du score cherché (à partir de 0) : le plus petit score qui couvre q des scores
+    double part = q * resume->nbScores;
+    long rang = (long)part;
+    if (rang < part) rang++;
+    rang--;
+    if (rang <= 0) return resume->min;
+    if (rang >= resume->nbScores - 1) return resume->max;
+
+    // Centroïde qui contient ce rang
+    long debut = 0;
+    int i = 0;
+    while (debut + c[i].poids <= rang) {
+        debut += c[i].poids;
+        i++;
+    }
+    if (!c[i].fusionne) {
+        return c[i].moyenne;
+    }
+
+    // Les scores d'un groupe fusionné sont supposés répartis entre les milieux avec ses voisins
+    double gauche = (i == 0) ? resume->min : (c[i - 1].moyenne + c[i].moyenne) / 2;
+    double droite = (i == resume->nbCentroides - 1) ? resume->max : (c[i].moyenne + c[i + 1].moyenne) / 2;
+    return gauche + (droite - gauche) * (rang - debut + 0.5) / c[i].poids;
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -420,36 +1718,187 @@ void ajouterScore(Chevalier *chevalier, int score) {
  * - Le meilleur score
  * - Le moins bon score
  * - Le score moyen 
+ * - La médiane et les 90e et 99e centiles
  * 
  * Si le chevalier n'a pas de score, un message d'erreur est affiché
  * 
  * \param[in] chevalier Le chevalier à qui on affiche les statistiques
  */
 void afficherStatistiques(Chevalier *chevalier){
-    if (chevalier->firstScore == NULL) {
-        printf("Le chevalier %s n'a aucun score enregistré.\n", chevalier->pseudo);
+    StatistiquesChevalier stats;
+
+    if (!calculerStatistiques(chevalier, &stats)) {
+        printf("Le chevalier %s n'a aucun score enregistré.\n", texteChaine(chevalier->pseudo));
         return;
     }
-    float scoreMoyen;
-    int nbScores = 0;
-    int sommeScores = 0;
 
-    MaillonScore *current = chevalier->firstScore;
-    while (current != NULL) {
-        sommeScores += current->score;
-        nbScores++;
-        current = current->next;
+    // Affichage des statistiques
+    printf("Statistiques pour %s :\n", texteChaine(chevalier->pseudo));
+    printf("- Nombre de scores : %d\n", stats.nbScores);
+    printf("- Meilleur score : %d\n", stats.meilleurScore);
+    printf("- Moins bon score : %d\n", stats.moinsBonScore);
+    printf("- Score moyen : %.2f\n", stats.scoreMoyen);
+    printf("- Médiane : %.1f - 90e centile : %.1f - 99e centile : %.1f\n", stats.mediane, stats.centile90, stats.centile99);
+    const ScoresCompactes *compactes = &lireHistorique(chevalier)->compactes;
+    if (compactes->nbScores > 0) {
+        printf("- Anciens scores compactés : %d (de %d à %d)\n", compactes->nbScores, compactes->min, compactes->max);
     }
+}
 
-    // Calcul du score moyen en virgule flottante
-    scoreMoyen = (float)sommeScores / nbScores; // Calcul du score moyen en virgule flottante
+/*---------------------------------------------------------------------------------------------------------------------------------*/
 
-    // Affichage des statistiques
-    printf("Statistiques pour %s :\n", chevalier->pseudo);
-    printf("- Nombre de scores : %d\n", nbScores);
-    printf("- Meilleur score : %d\n", chevalier->firstScore->score);
-    printf("- Moins bon score : %d\n", chevalier->lastScore->score);
-    printf("- Score moyen : %.2f\n", scoreMoyen);
+/**
+ * \brief Calcule les statistiques du chevalier
+ *
+ * Lit le résumé des scores du chevalier et remplit \c stats avec le nombre
+ * de scores, le meilleur, le moins bon, le score moyen et les quantiles,
+ * sans parcourir la liste des scores.
+ *
+ * \param[in] chevalier Le chevalier dont on calcule les statistiques
+ * \param[out] stats Les statistiques calculées
+ * \return true si le chevalier a au moins un score, false sinon
+ */
+Bool calculerStatistiques(Chevalier *chevalier, StatistiquesChevalier *stats){
+    const ResumeScores *resume = &lireHistorique(chevalier)->resume;
+
+    stats->nbScores = 0;
+    stats->meilleurScore = 0;
+    stats->moinsBonScore = 0;
+    stats->scoreMoyen = 0;
+    stats->mediane = 0;
+    stats->centile90 = 0;
+    stats->centile99 = 0;
+
+    if (resume->nbScores == 0) {
+        return false;
+    }
+
+    stats->nbScores = resume->nbScores;
+    stats->meilleurScore = resume->max;
+    stats->moinsBonScore = resume->min;
+    stats->scoreMoyen = (float)resume->somme / resume->nbScores; // Calcul du score moyen en virgule flottante
+    stats->mediane = quantileResume(resume, 0.5);
+    stats->centile90 = quantileResume(resume, 0.9);
+    stats->centile99 = quantileResume(resume, 0.99);
+    return true;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compte les scores enregistrés supérieurs ou égaux à un score
+ *
+ * Tous les scores en mémoire sont comptés dans un arbre de Fenwick tenu
+ * à jour par \c ajouterScore et \c libererScores : la requête est en
+ * O(log SCORE_MAX), sans tri. Les scores compactés par la rétention y
+ * sont comptés à la valeur du milieu de leur classe d'histogramme : le
+ * compte est exact pour les scores 0 et les puissances de 2.
+ *
+ * \param[in] score Le score de référence
+ * \return Le nombre de scores supérieurs ou égaux à \c score
+ */
+int compterScoresSuperieurs(int score){
+    return nombreScores() - compterScoresInferieurs(score);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le nombre total de scores enregistrés
+ *
+ * \return Le nombre de scores en mémoire
+ */
+int nombreScores(void){
+    return __atomic_load_n(&totalScores, __ATOMIC_RELAXED);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le nombre de maillons de scores en mémoire
+ *
+ * Les scores des chevaliers froids, gardés compressés, n'ont pas de maillon.
+ *
+ * \return Le nombre de maillons pris et pas encore rendus, tous fils confondus
+ */
+long nombreMaillonsScores(void){
+    return __atomic_load_n(&nbMaillonsScores, __ATOMIC_RELAXED);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le rang d'un score parmi tous les scores enregistrés
+ *
+ * Le rang vaut 1 + le nombre de scores strictement meilleurs : des scores
+ * égaux ont le même rang.
+ *
+ * \param[in] score Le score dont on veut le rang
+ * \return Le rang du score
+ */
+int rangScore(int score){
+    if (score >= SCORE_MAX) return 1;
+    return 1 + compterScoresSuperieurs(score + 1);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le score d'un centile parmi tous les scores enregistrés
+ *
+ * Renvoie le plus petit score tel qu'au moins \c centile % des scores
+ * lui sont inférieurs ou égaux (50 donne la médiane), en O(log SCORE_MAX).
+ *
+ * \param[in] centile Le centile voulu, entre 0 et 100
+ * \return Le score du centile, -1 si aucun score n'est enregistré
+ */
+int scoreCentile(double centile){
+    int total = nombreScores();
+    if (total <= 0) return -1;
+
+    // Nombre de scores à couvrir (arrondi au supérieur), entre 1 et total
+    double part = centile * total / 100.0;
+    long cible = (long)part;
+    if (cible < part) cible++;
+    if (cible < 1) cible = 1;
+    if (cible > total) cible = total;
+
+    // Descente dans l'arbre : position = nombre de scores distincts entièrement sous la cible
+    int position = 0;
+    for (int pas = TAILLE_ARBRE_SCORES; pas > 0; pas >>= 1) {
+        int suivante = position + pas;
+        if (suivante <= TAILLE_ARBRE_SCORES) {
+            int compte = __atomic_load_n(&arbreScores[suivante], __ATOMIC_RELAXED);
+            if (compte < cible) {
+                position = suivante;
+                cible -= compte;
+            }
+        }
+    }
+    return (position > SCORE_MAX) ? SCORE_MAX : position;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Affiche le rang du meilleur score d'un chevalier
+ *
+ * Affiche le rang du meilleur score du chevalier parmi tous les scores
+ * enregistrés et la part des scores qu'il égale ou dépasse.
+ *
+ * \param[in] chevalier Le chevalier
+ */
+void afficherRangChevalier(Chevalier *chevalier){
+    int total = nombreScores();
+
+    if (lireHistorique(chevalier)->resume.nbScores == 0 || total == 0) {
+        printf("Le chevalier %s n'a aucun score classé.\n", texteChaine(chevalier->pseudo));
+        return;
+    }
+
+    int meilleur = meilleurScoreChevalier(chevalier);
+    printf("- Rang du meilleur score : %d sur %d scores\n", rangScore(meilleur), total);
+    printf("- Scores égalés ou dépassés : %.1f %%\n", 100.0 * compterScoresInferieurs(meilleur + 1) / total);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -464,14 +1913,32 @@ void afficherStatistiques(Chevalier *chevalier){
  * \param[in] chevalier Le chevalier dont les scores doivent être libérés
  */
 void libererScores(Chevalier *chevalier) {
+    if (chevalier->scoresCompresses != NULL) {
+        LecteurScores lecteur;
+        ouvrirListeScores(&lecteur, chevalier->scoresCompresses);
+        while (scoreSuivant(&lecteur)) {
+            compterScore(lecteur.score, -1);
+        }
+        libererMemoire(MEMOIRE_SCORES, chevalier->scoresCompresses);
+        chevalier->scoresCompresses = NULL;
+        chevalier->tailleCompresses = 0;
+    }
+
     MaillonScore *current = chevalier->firstScore;
     while (current != NULL) {
         MaillonScore *tmp = current;
         current = current->next;
-        free(tmp);
+        compterScore(tmp->score, -1);
+        rendreMaillonScore(tmp);
     }
     chevalier->firstScore = NULL;
     chevalier->lastScore = NULL;
+    chevalier->meilleurScore = 0;
+    if (chevalier->historique != NULL) {
+        compterCompactes(&chevalier->historique->compactes, -1);
+    }
+    libererMemoire(MEMOIRE_SCORES, chevalier->historique);
+    chevalier->historique = NULL;
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -491,9 +1958,7 @@ void libererChevalier(Chevalier *chevalier){
     libererScores(chevalier);
 
     // Réinitialiser les champs du chevalier
-    chevalier->pseudo[0] = '\0';
-    chevalier->pv = 0;
-    chevalier->dmg = 0;
+    chevalier->pseudo = CHAINE_VIDE;
     chevalier->nbParties = 0;
     chevalier->firstScore = NULL;
     chevalier->lastScore = NULL;
@@ -513,9 +1978,10 @@ void libererTableauChevaliers(TableauChevaliers *tableau){
     for (int i = 0; i < tableau->nbChevaliers; i++) {
         libererScores(&(tableau->chevaliers[i])); // Libérer les scores si nécessaire
     }
-    free(tableau->chevaliers);
+    libererMemoire(MEMOIRE_REGISTRE, tableau->chevaliers);
     tableau->chevaliers = NULL;
     tableau->nbChevaliers = 0;
+    tableau->capacite = 0;
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -537,12 +2003,10 @@ void afficherTableauChevaliers(TableauChevaliers tableau){
         Chevalier *chevalier = &(tableau.chevaliers[i]);
 
         printf("Chevalier %d :\n", i + 1);
-        printf("Pseudo : %s\n", chevalier->pseudo);
-        printf("PV : %d\n", chevalier->pv);
-        printf("DMG : %d\n", chevalier->dmg);
+        printf("Pseudo : %s\n", texteChaine(chevalier->pseudo));
         printf("Parties jouées : %d\n", chevalier->nbParties);
 
-        if (chevalier->firstScore == NULL) {
+        if (chevalier->firstScore == NULL && chevalier->scoresCompresses == NULL) {
             printf("- Scores : Aucun score enregistré\n");
         } else {
             printf("- Scores :\n");
@@ -554,6 +2018,13 @@ void afficherTableauChevaliers(TableauChevaliers tableau){
                 current = current->next;
             }
 
+        // Scores d'un chevalier froid
+        LecteurScores lecteur;
+        ouvrirListeScores(&lecteur, chevalier->scoresCompresses);
+        while (scoreSuivant(&lecteur)) {
+            printf("  - %d\n", lecteur.score);
+        }
+
     }
     
     printf("\n");
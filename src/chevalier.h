@@ -11,6 +11,7 @@
     #include <stdio.h>
     #include <stdlib.h>
     #include <string.h>
+    #include "chaines.h"
 
     /**
      * \def PV_MIN
@@ -31,6 +32,109 @@
      */
     #define DMG_MIN 1
 
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def LONGUEUR_MAX_PSEUDO
+     * \brief Nombre maximum de caractères d'un pseudo, les suivants sont ignorés.
+     */
+    #define LONGUEUR_MAX_PSEUDO 40
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def SCORE_MAX
+     * \brief Plus grand score distingué par le classement global des scores.
+     *
+     * Les scores au-delà sont comptés comme \c SCORE_MAX et les scores
+     * négatifs comme 0 dans l'arbre de Fenwick des scores.
+     */
+    #define SCORE_MAX 65535
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def NB_CENTROIDES
+     * \brief Nombre maximum de centroïdes du résumé des scores d'un chevalier.
+     */
+    #define NB_CENTROIDES 16
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def VERSION_FICHIER_SCORES
+     * \brief Version du format du fichier des scores écrite par la sauvegarde.
+     *
+     * La version 1 (sans numéro) ne contient que les scores, la version 2
+     * ajoute le résumé des scores de chaque chevalier et la version 3 le numéro
+     * de partie de chaque score conservé et les scores compactés.
+     */
+    #define VERSION_FICHIER_SCORES 3
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def DOSSIER_DONNEES
+     * \brief Dossier par défaut des fichiers du jeu (scores et monstres).
+     *
+     * La variable d'environnement \c SAE_DONNEES le remplace, voir
+     * \c cheminDonnees.
+     */
+    #define DOSSIER_DONNEES "src/fichier/"
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def FICHIER_SCORES
+     * \brief Fichier des scores texte, dans le dossier des données.
+     *
+     * Le jeu l'importe tant que \c FICHIER_SCORES_BINAIRE n'existe pas.
+     */
+    #define FICHIER_SCORES "scores.txt"
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def FICHIER_SCORES_BINAIRE
+     * \brief Fichier des scores compressé lu et écrit par le jeu, dans le dossier des données.
+     */
+    #define FICHIER_SCORES_BINAIRE "scores.bin"
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def RETENTION_MEILLEURS
+     * \brief Nombre de meilleurs scores conservés par défaut pour chaque chevalier.
+     */
+    #define RETENTION_MEILLEURS 10
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def RETENTION_DERNIERS
+     * \brief Nombre de derniers scores conservés par défaut pour chaque chevalier.
+     */
+    #define RETENTION_DERNIERS 10
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def NB_CLASSES_HISTOGRAMME
+     * \brief Nombre de classes de l'histogramme des scores compactés.
+     *
+     * La classe 0 compte les scores nuls ou négatifs, la classe k (k >= 1) les
+     * scores de 2^(k-1) à 2^k - 1, et la dernière tous les scores au-delà.
+     */
+    #define NB_CLASSES_HISTOGRAMME 17
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def SIGNATURE_FICHIER_BINAIRE
+     * \brief Quatre premiers octets d'un fichier de scores binaire.
+     */
+    #define SIGNATURE_FICHIER_BINAIRE "MKG1"
+
     /*---------------------------------------------------------------------------------------------------------------------------------*/
     /**
      * \enum Bool
@@ -54,30 +158,127 @@
     typedef struct maillon
     {
         int score;
+        int numero;   // Numéro de la partie du score (1 pour la première)
         struct maillon *next;
     }MaillonScore;
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \struct Centroide
+     * \brief Groupe de scores voisins résumé par leur moyenne et leur nombre.
+     */
+    typedef struct {
+        float moyenne;
+        int poids;
+        Bool fusionne;   // false si tous les scores du groupe sont égaux à la moyenne
+    } Centroide;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ResumeScores
+     * \brief Résumé de taille fixe des scores d'un chevalier (t-digest simplifié).
+     *
+     * Le nombre, la somme, le minimum et le maximum des scores sont exacts.
+     * Les centroïdes sont rangés par moyenne croissante : quand il y en a trop,
+     * les deux voisins les moins utiles aux extrémités sont fusionnés, ce qui
+     * garde les quantiles extrêmes précis.
+     */
+    typedef struct {
+        int nbScores;
+        int min;
+        int max;
+        long long somme;
+        int nbCentroides;
+        Centroide centroides[NB_CENTROIDES + 1];  // Une place de plus pour l'insertion avant fusion
+    } ResumeScores;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ScoresCompactes
+     * \brief Agrégats exacts des scores retirés de la liste par la politique de rétention.
+     *
+     * Sa taille ne dépend pas du nombre de scores retirés. Ils restent
+     * comptés dans l'arbre des scores, à la valeur du milieu de leur classe :
+     * l'histogramme suffit à les en retirer quand le chevalier est libéré.
+     */
+    typedef struct {
+        int nbScores;
+        long long somme;
+        int min;
+        int max;
+        int histogramme[NB_CLASSES_HISTOGRAMME];
+    } ScoresCompactes;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct HistoriqueScores
+     * \brief Données des scores d'un chevalier qui ne servent qu'aux statistiques.
+     *
+     * Allouée à part au premier score du chevalier : les parcours du tableau
+     * (tris, classements, recherches) ne la chargent jamais en mémoire.
+     */
+    typedef struct {
+        ResumeScores resume;
+        ScoresCompactes compactes;
+    } HistoriqueScores;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \struct Chevalier
-     * \brief Représente un chevalier avec ses informations et ses scores.
+     * \brief Représente un joueur enregistré avec ses informations et ses scores.
      *
-     * La structure `Chevalier` contient les informations de base pour un joueur,
-     * notamment son pseudo, ses statistiques de parties jouées et une liste de scores.
+     * La structure `Chevalier` ne contient que les informations qui durent
+     * d'une partie à l'autre : son pseudo (interné), son nombre de parties,
+     * son meilleur score et sa liste de scores. L'état en jeu est dans un \c Combattant et
+     * le résumé des scores dans \c historique (NULL tant qu'il n'a aucun score).
+     * Un chevalier froid garde sa liste compressée dans \c scoresCompresses
+     * (et \c firstScore vaut NULL) jusqu'à son prochain score.
      */
     typedef struct 
     {
-        char pseudo[41];
-        int pv;
-        int dmg;
+        IdChaine pseudo;                  // Texte lu avec texteChaine
         int nbParties;
+        int meilleurScore;                // Copie du premier score de la liste, 0 si aucun
+        int tailleCompresses;             // Taille en octets de scoresCompresses
         MaillonScore *firstScore;
         MaillonScore *lastScore;
+        unsigned char *scoresCompresses;  // Liste des scores encodée quand le chevalier est froid, NULL sinon
+        HistoriqueScores *historique;
     }Chevalier;
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \struct Combattant
+     * \brief État d'un chevalier pendant une partie.
+     *
+     * Recréé au début de chaque partie, il n'est jamais enregistré.
+     * Sans \c choisirArme, le joueur choisit ses armes au clavier ; sinon
+     * la fonction les choisit (0 : Pierre, 1 : Feuille, 2 : Ciseaux) à
+     * partir de \c etatArme, ce qui permet de jouer sans entrée ;
+     * \c observerArme, s'il n'est pas NULL, reçoit ensuite l'arme du monstre.
+     * Avec \c graineMonstres, les monstres tirent leurs armes avec cette
+     * graine plutôt qu'avec \c rand, et \c muet retire tout l'affichage :
+     * des parties simulées peuvent alors être jouées en même temps.
+     */
+    typedef struct {
+        char pseudo[LONGUEUR_MAX_PSEUDO + 1];
+        int pv;
+        int dmg;
+        int (*choisirArme)(void *etatArme);   // NULL : choix au clavier
+        void *etatArme;
+        void (*observerArme)(void *etatArme, int armeMonstre);   // NULL : rien n'est retenu des armes des monstres
+        unsigned int *graineMonstres;         // NULL : armes des monstres tirées avec rand
+        Bool muet;                            // true : la partie n'affiche rien
+    } Combattant;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \struct Chevalier
      * \brief Représente un chevalier avec ses informations et ses scores.
@@ -88,49 +289,118 @@
     typedef struct {
         Chevalier *chevaliers; // Tableau dynamique de chevaliers
         int nbChevaliers;            // Nombre de chevaliers dans le tableau
+        int capacite;                // Nombre de chevaliers que le tableau peut contenir sans réallocation
     } TableauChevaliers;
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \struct CleTri
+     * \brief Clé compacte utilisée pour trier les chevaliers sans les déplacer.
+     *
+     * \c cle est précalculée une fois par chevalier (meilleur score ou début
+     * du pseudo) et \c index est la position du chevalier dans son tableau.
+     */
+    typedef struct {
+        unsigned long long cle;
+        int index;
+    } CleTri;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct StatistiquesChevalier
+     * \brief Statistiques calculées sur la liste des scores d'un chevalier.
+     *
+     * Regroupe le nombre de scores, le meilleur et le moins bon score, le score
+     * moyen et quelques quantiles, pour pouvoir les calculer sans les afficher.
+     */
+    typedef struct {
+        int nbScores;
+        int meilleurScore;
+        int moinsBonScore;
+        float scoreMoyen;
+        float mediane;
+        float centile90;
+        float centile99;
+    } StatistiquesChevalier;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \brief Crée un nouveau chevalier
      *
      * \param pseudo pseudo du chevalier
      * \return un chevalier avec : 
      *                      - un pseudo, 
-     *                      - 20 points de vie, 
-     *                      - 1 point de dégât,
      *                      - 0 partie jouée 
      *                      - et une liste de scores vide
      */
-    Chevalier creerChevalier(char *pseudo);
+    Chevalier creerChevalier(const char *pseudo);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Crée le combattant d'une nouvelle partie
+     *
+     * \param pseudo pseudo du joueur
+     * \return un combattant avec 20 points de vie et 1 point de dégât, qui
+     * choisit ses armes au clavier et affiche la partie
+     */
+    Combattant creerCombattant(const char *pseudo);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
     /**
      * \brief Crée un nouveau tableau de chevaliers
      *
-     * Alloue dynamiquement un tableau de chevaliers et l'initialise avec
-     * une taille de 0 et un pointeur de chevaliers NULL.
+     * Alloue dynamiquement un tableau de chevaliers vide, avec de la place
+     * pour \c capacite chevaliers (aucune si elle vaut 0).
      *
+     * \param[in] capacite Le nombre de chevaliers attendus
      * \return Un pointeur vers le tableau de chevaliers crée
      */
-    TableauChevaliers *creerTableauChevaliers();
+    TableauChevaliers *creerTableauChevaliers(int capacite);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Réserve de la place pour au moins \c capacite chevaliers
+     *
+     * Ne réduit jamais le tableau.
+     *
+     * \param[in,out] tableau Le tableau de chevaliers
+     * \param[in] capacite Le nombre de chevaliers à pouvoir contenir
+     * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+     */
+    void reserverChevaliers(TableauChevaliers *tableau, int capacite);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
     /**
      * \brief Ajoute un chevalier à la liste
      *
-     * Ajoute le chevalier donné en argument à la liste des chevaliers
-     * du tableau. Si c'est le premier ajout, on alloue un tableau de
-     * chevaliers de taille 1. Sinon, on réalloue pour étendre la taille
-     * du tableau.
+     * Ajoute le chevalier donné en argument à la fin du tableau. Quand le
+     * tableau est plein, sa capacité double : un ajout coûte O(1) en
+     * moyenne.
      *
      * \param[in,out] tableau le tableau de chevaliers à modifier
      * \param[in] chevalier le chevalier à ajouter
      */
     void ajouterChevalier(TableauChevaliers *tableau, Chevalier chevalier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Ajoute plusieurs chevaliers à la fin du tableau
+     *
+     * Une seule réallocation au plus, puis une seule copie.
+     *
+     * \param[in,out] tableau Le tableau de chevaliers à modifier
+     * \param[in] chevaliers Les chevaliers à ajouter
+     * \param[in] nb Le nombre de chevaliers à ajouter
+     */
+    void ajouterChevaliers(TableauChevaliers *tableau, const Chevalier *chevaliers, int nb);
     
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -149,25 +419,79 @@
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \brief Supprime plusieurs chevaliers du tableau en un seul passage
+     *
+     * Les chevaliers restants gardent leur ordre. Les indices peuvent être
+     * dans n'importe quel ordre et apparaître plusieurs fois. Comme pour
+     * \c supprimerChevalier, les scores des chevaliers supprimés ne sont pas
+     * libérés.
+     *
+     * \param[in,out] tableau Le tableau de chevaliers à modifier
+     * \param[in] indices Les indices des chevaliers à supprimer
+     * \param[in] nb Le nombre d'indices
+     * \return Le nombre de chevaliers supprimés
+     * \note Si un indice est invalide, le programme termine avec un message d'erreur.
+     */
+    int supprimerChevaliers(TableauChevaliers *tableau, const int *indices, int nb);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Construit le chemin d'un fichier du dossier des données
+     *
+     * Le dossier est celui de la variable d'environnement \c SAE_DONNEES si
+     * elle existe, \c DOSSIER_DONNEES sinon : une session peut ainsi jouer
+     * sur des copies sans toucher aux fichiers du jeu.
+     *
+     * \param[in] nomFichier Le nom du fichier dans le dossier
+     * \return Le chemin, à libérer avec \c libererMemoire (MEMOIRE_TAMPONS)
+     * \note En cas d'erreur d'allocation, le programme termine avec un message d'erreur.
+     */
+    char *cheminDonnees(const char *nomFichier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \brief Charge un tableau de chevaliers à partir d'un fichier
      *
-     * Lit le fichier "scores.txt" et charge les chevaliers avec leurs scores
-     * dans un tableau de chevaliers.
+     * Lit le fichier binaire \c FICHIER_SCORES_BINAIRE du dossier des données
+     * (voir \c chargerTableauBinaire). Tant qu'il n'existe pas, le fichier
+     * texte \c FICHIER_SCORES est importé à sa place (voir \c chargerTableauTexte).
      *
      * \param[out] nbChevaliers Le nombre de chevaliers lus
      * \return Un pointeur vers le tableau de chevaliers chargé
+     * \note Si le fichier est absent ou invalide, le programme termine avec un message d'erreur.
      */
     TableauChevaliers *chargerTableauChevaliers(int *nbChevaliers);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \brief Charge un tableau de chevaliers à partir d'un fichier des scores texte
+     *
+     * Lit un fichier écrit par \c sauvegarderTableauTexte. Les fichiers de
+     * version 1 (sans résumé) et 2 (sans numéros de partie) restent lisibles :
+     * le résumé de chaque chevalier est alors reconstruit à partir de ses
+     * scores, numérotés dans l'ordre du fichier. La politique de rétention
+     * courante est appliquée à chaque chevalier chargé.
+     *
+     * \param[in] chemin Le chemin du fichier des scores
+     * \param[out] nbChevaliers Le nombre de chevaliers lus
+     * \return Un pointeur vers le tableau de chevaliers chargé
+     * \note Si le fichier est absent ou invalide, le programme termine avec un message d'erreur.
+     */
+    TableauChevaliers *chargerTableauTexte(const char *chemin, int *nbChevaliers);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \brief Sauvegarde un tableau de chevaliers dans un fichier
-     * 
-     * Écrit les informations du tableau de chevaliers, comprenant le pseudo
-     * le nombre de parties de chaque chevalier avec leurs scores, dans le fichier "scores.txt".
-     * 
+     *
+     * Écrit le tableau dans le fichier binaire \c FICHIER_SCORES_BINAIRE du
+     * dossier des données (voir \c sauvegarderTableauBinaire). Le fichier
+     * texte \c FICHIER_SCORES n'est plus réécrit.
+     *
      * \param[in] tableau Le tableau de chevaliers à sauvegarder
      * \note Si le fichier ne peut pas être ouvert, le programme termine avec un message d'erreur.
      */
@@ -175,6 +499,107 @@
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \brief Sauvegarde un tableau de chevaliers dans un fichier des scores texte
+     *
+     * Écrit le pseudo et le nombre de parties de chaque chevalier avec ses
+     * scores conservés, son résumé et ses scores compactés (format de version
+     * \c VERSION_FICHIER_SCORES), lisible par \c chargerTableauTexte.
+     *
+     * \param[in] tableau Le tableau de chevaliers à sauvegarder
+     * \param[in] chemin Le chemin du fichier des scores
+     * \note Si le fichier ne peut pas être ouvert, le programme termine avec un message d'erreur.
+     */
+    void sauvegarderTableauTexte(TableauChevaliers *tableau, const char *chemin);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Écrit un chevalier dans un fichier des scores
+     *
+     * Écrit les lignes d'un chevalier au format de version
+     * \c VERSION_FICHIER_SCORES, sans l'en-tête du fichier : permet d'écrire
+     * un fichier chevalier par chevalier sans garder tout le tableau.
+     *
+     * \param[in] fe Le fichier ouvert en écriture
+     * \param[in] pseudo Le pseudo écrit pour ce chevalier
+     * \param[in] chevalier Le chevalier à écrire
+     */
+    void ecrireChevalierTexte(FILE *fe, const char *pseudo, const Chevalier *chevalier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Sauvegarde un tableau de chevaliers dans un fichier binaire compact
+     *
+     * Les listes de scores sont écrites sous forme compressée (écarts en
+     * LEB128), comme les autres entiers du fichier.
+     *
+     * \param[in] tableau Le tableau de chevaliers à sauvegarder
+     * \param[in] chemin Le chemin du fichier
+     * \note Si le fichier ne peut pas être écrit, le programme termine avec un message d'erreur.
+     */
+    void sauvegarderTableauBinaire(TableauChevaliers *tableau, const char *chemin);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Charge un tableau de chevaliers depuis un fichier binaire compact
+     *
+     * Les chevaliers chargés sont froids : leurs scores restent compressés.
+     *
+     * \param[in] chemin Le chemin du fichier écrit par \c sauvegarderTableauBinaire
+     * \param[out] nbChevaliers Le nombre de chevaliers lus
+     * \return Un pointeur vers le tableau de chevaliers chargé
+     * \note Si le fichier est absent ou invalide, le programme termine avec un message d'erreur.
+     */
+    TableauChevaliers *chargerTableauBinaire(const char *chemin, int *nbChevaliers);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compresse la liste des scores d'un chevalier
+     *
+     * Les maillons sont remplacés par un bloc d'octets (environ 3 octets par
+     * score au lieu d'un maillon alloué). Le chevalier est décompressé
+     * automatiquement par \c ajouterScore.
+     *
+     * \param[in,out] chevalier Le chevalier à compresser
+     */
+    void compresserChevalier(Chevalier *chevalier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Reconstruit la liste des scores d'un chevalier compressé
+     *
+     * \param[in,out] chevalier Le chevalier à décompresser
+     */
+    void decompresserChevalier(Chevalier *chevalier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compresse tous les chevaliers d'un tableau
+     *
+     * \param[in,out] tableau Le tableau de chevaliers
+     */
+    void compresserTableau(TableauChevaliers *tableau);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le meilleur score d'un chevalier, compressé ou non
+     *
+     * Lu dans le chevalier : ni la liste ni le bloc compressé ne sont parcourus.
+     *
+     * \param[in] chevalier Le chevalier
+     * \return Le meilleur score, 0 si le chevalier n'a aucun score
+     */
+    int meilleurScoreChevalier(const Chevalier *chevalier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \brief Cherche si un chevalier existe dans le tableau
      *
@@ -208,10 +633,27 @@
      *
      * Ajoute un score à la liste des scores du chevalier en l'insérant
      * dans l'ordre décroissant. Si la liste est vide, on ajoute le score
-     * directement.
+     * directement. La politique de rétention est ensuite appliquée : la
+     * liste ne dépasse jamais la somme des deux limites.
      */
     void ajouterScore(Chevalier *Chevalier, int score);
 
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Change la politique de rétention des scores
+     *
+     * Chaque chevalier garde dans sa liste ses \c nbMeilleurs meilleurs scores
+     * et ses \c nbDerniers derniers scores. Les autres sont compactés dans ses
+     * \c ScoresCompactes, et restent comptés par les requêtes de rang au
+     * milieu de leur classe d'histogramme. La politique s'applique aux ajouts
+     * suivants et au chargement du fichier des scores.
+     *
+     * \param[in] nbMeilleurs Le nombre de meilleurs scores gardés (au moins 1), 0 ou moins pour tout garder
+     * \param[in] nbDerniers Le nombre de derniers scores gardés
+     */
+    void definirRetention(int nbMeilleurs, int nbDerniers);
+
     /*---------------------------------------------------------------------------------------------------------------------------------*/
     
     /**
@@ -230,6 +672,42 @@
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \brief Initialise un résumé de scores vide
+     *
+     * \param[out] resume Le résumé à initialiser
+     */
+    void initialiserResume(ResumeScores *resume);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Ajoute un score au résumé
+     *
+     * Coût en O(NB_CENTROIDES), indépendant du nombre de scores déjà ajoutés.
+     *
+     * \param[in,out] resume Le résumé
+     * \param[in] score Le score à ajouter
+     */
+    void ajouterAuResume(ResumeScores *resume, int score);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Estime un quantile à partir du résumé
+     *
+     * Donne le plus petit score qui couvre au moins \c q des scores, comme
+     * \c scoreCentile. Le résultat est exact tant que le chevalier a au plus
+     * \c NB_CENTROIDES scores distincts, et approché au-delà.
+     *
+     * \param[in] resume Le résumé
+     * \param[in] q Le quantile voulu, entre 0 et 1 (0.5 pour la médiane)
+     * \return Le score estimé, 0 si le résumé est vide
+     */
+    float quantileResume(const ResumeScores *resume, double q);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \brief Affiche les statistiques du chevalier
      * 
@@ -238,15 +716,105 @@
      * - Le meilleur score
      * - Le moins bon score
      * - Le score moyen 
+     * - La médiane et les 90e et 99e centiles
      * 
      * Si le chevalier n'a pas de score, un message d'erreur est affiché
      * 
      * \param[in] chevalier Le chevalier à qui on affiche les statistiques
      */
     void afficherStatistiques(Chevalier *chevalier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Calcule les statistiques du chevalier
+     *
+     * Lit le résumé des scores du chevalier et remplit \c stats avec le nombre
+     * de scores, le meilleur, le moins bon, le score moyen et les quantiles,
+     * sans parcourir la liste des scores.
+     *
+     * \param[in] chevalier Le chevalier dont on calcule les statistiques
+     * \param[out] stats Les statistiques calculées
+     * \return true si le chevalier a au moins un score, false sinon
+     */
+    Bool calculerStatistiques(Chevalier *chevalier, StatistiquesChevalier *stats);
     
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \brief Compte les scores enregistrés supérieurs ou égaux à un score
+     *
+     * Tous les scores en mémoire sont comptés dans un arbre de Fenwick tenu
+     * à jour par \c ajouterScore et \c libererScores : la requête est en
+     * O(log SCORE_MAX), sans tri. Les scores compactés par la rétention y
+     * sont comptés à la valeur du milieu de leur classe d'histogramme : le
+     * compte est exact pour les scores 0 et les puissances de 2.
+     *
+     * \param[in] score Le score de référence
+     * \return Le nombre de scores supérieurs ou égaux à \c score
+     */
+    int compterScoresSuperieurs(int score);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le nombre total de scores enregistrés
+     *
+     * \return Le nombre de scores en mémoire
+     */
+    int nombreScores(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le nombre de maillons de scores en mémoire
+     *
+     * Les scores des chevaliers froids, gardés compressés, n'ont pas de maillon.
+     *
+     * \return Le nombre de maillons pris et pas encore rendus, tous fils confondus
+     */
+    long nombreMaillonsScores(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le rang d'un score parmi tous les scores enregistrés
+     *
+     * Le rang vaut 1 + le nombre de scores strictement meilleurs : des scores
+     * égaux ont le même rang.
+     *
+     * \param[in] score Le score dont on veut le rang
+     * \return Le rang du score
+     */
+    int rangScore(int score);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le score d'un centile parmi tous les scores enregistrés
+     *
+     * Renvoie le plus petit score tel qu'au moins \c centile % des scores
+     * lui sont inférieurs ou égaux (50 donne la médiane), en O(log SCORE_MAX).
+     *
+     * \param[in] centile Le centile voulu, entre 0 et 100
+     * \return Le score du centile, -1 si aucun score n'est enregistré
+     */
+    int scoreCentile(double centile);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Affiche le rang du meilleur score d'un chevalier
+     *
+     * Affiche le rang du meilleur score du chevalier parmi tous les scores
+     * enregistrés et la part des scores qu'il égale ou dépasse.
+     *
+     * \param[in] chevalier Le chevalier
+     */
+    void afficherRangChevalier(Chevalier *chevalier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \brief Libère la mémoire allouée pour la liste des scores d'un chevalier
      * 
@@ -285,23 +853,137 @@
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
     /**
-    * \brief Trie un tableau de chevaliers par ordre alphabétique
-    * 
-    * Tri un tableau de chevaliers en ordre alphabétique croissant
-    * en utilisant l'algorithme du tri à bulles.
-    *
-    * \param[in] tableau Le tableau de chevaliers à trier
-    */
+     * \brief Trie un tableau de chevaliers par ordre alphabétique
+     *
+     * Trie des clés (8 premiers octets du pseudo, indice) par tri rapide,
+     * en ne comparant les pseudos complets qu'à préfixe égal, puis déplace
+     * chaque chevalier une seule fois. Le nom de la fonction est historique :
+     * ce n'est plus un tri à bulles.
+     *
+     * \param[in,out] tableau Le tableau de chevaliers à trier
+     */
     void triBulleTableauChevaliers(TableauChevaliers *tableau);
 
-    void echangerChevaliers(Chevalier *a, Chevalier *b);
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Clé de tri d'un chevalier par meilleur score
+     *
+     * Les meilleurs scores donnent les plus petites clés.
+     *
+     * \param[in] chevalier Le chevalier
+     * \return La clé de tri
+     */
+    unsigned long long cleScore(Chevalier *chevalier);
 
-    /* Partition pour le tri rapide */
-    int partition(Chevalier *chevaliers, int gauche, int droite);
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Clé de collation du pseudo d'un chevalier
+     *
+     * Les 8 premiers octets du pseudo lus en gros-boutiste : l'ordre des clés
+     * est celui de strcmp sur ces 8 octets.
+     *
+     * \param[in] chevalier Le chevalier
+     * \return La clé de tri
+     */
+    unsigned long long cleNom(Chevalier *chevalier);
 
-    /* Quicksort */
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compare deux clés de tri
+     *
+     * À clé égale, on départage par le pseudo complet si \c chevaliers est donné,
+     * puis par l'indice : deux clés distinctes ne sont jamais égales.
+     *
+     * \param[in] a La première clé
+     * \param[in] b La deuxième clé
+     * \param[in] chevaliers Les chevaliers indexés par les clés, ou NULL
+     * \return Un entier négatif, nul ou positif comme strcmp
+     */
+    int comparerCles(const CleTri *a, const CleTri *b, const Chevalier *chevaliers);
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Partition pour le tri rapide des clés
+     *
+     * Le pivot est la médiane de la première, du milieu et de la dernière clé,
+     * ce qui évite le pire cas sur un tableau déjà trié.
+     *
+     * \param[in,out] cles Les clés à partitionner
+     * \param[in] gauche Indice de la première clé
+     * \param[in] droite Indice de la dernière clé
+     * \param[in] chevaliers Les chevaliers pour départager les clés égales par pseudo, NULL pour départager par indice
+     * \return L'indice final du pivot
+     */
+    int partition(CleTri *cles, int gauche, int droite, const Chevalier *chevaliers);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Tri rapide d'un tableau de clés
+     *
+     * \param[in,out] cles Les clés à trier
+     * \param[in] gauche Indice de la première clé
+     * \param[in] droite Indice de la dernière clé
+     * \param[in] chevaliers Les chevaliers pour départager les clés égales par pseudo, NULL pour départager par indice
+     */
+    void triRapideCles(CleTri *cles, int gauche, int droite, const Chevalier *chevaliers);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Range les chevaliers dans l'ordre donné par des clés triées
+     *
+     * \param[in,out] chevaliers Le tableau de chevaliers
+     * \param[in] cles Les clés triées, dont les indices sont ceux de \c chevaliers
+     * \param[in] gauche Indice du premier chevalier concerné
+     * \param[in] n Nombre de chevaliers concernés
+     */
+    void appliquerOrdreCles(Chevalier *chevaliers, const CleTri *cles, int gauche, int n);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Trie des chevaliers par meilleur score décroissant
+     *
+     * Les meilleurs scores sont extraits une seule fois dans un tableau de
+     * clés (score, indice) qui est trié par tri rapide ; les chevaliers sont
+     * ensuite déplacés une seule fois. À score égal, l'ordre d'origine est gardé.
+     *
+     * \param[in,out] chevaliers Le tableau de chevaliers
+     * \param[in] gauche Indice du premier chevalier à trier
+     * \param[in] droite Indice du dernier chevalier à trier
+     */
     void triRapideChevaliers(Chevalier *chevaliers, int gauche, int droite);
 
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Tri par base (LSD) d'un tableau de clés
+     *
+     * Trie les clés octet par octet, du poids faible au poids fort, en sautant
+     * les octets identiques pour toutes les clés. Le tri est stable.
+     *
+     * \param[in,out] cles Les clés à trier
+     * \param[in] n Le nombre de clés
+     */
+    void triRadixCles(CleTri *cles, int n);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Trie des chevaliers par meilleur score décroissant en temps linéaire
+     *
+     * Même ordre que \c triRapideChevaliers, mais par tri par base sur les
+     * clés (score, indice). Le tri est stable : si le tableau est trié par
+     * nom, les égalités restent dans l'ordre alphabétique.
+     *
+     * \param[in,out] chevaliers Le tableau de chevaliers
+     * \param[in] n Le nombre de chevaliers
+     */
+    void triRadixChevaliers(Chevalier *chevaliers, int n);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
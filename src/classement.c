@@ -0,0 +1,562 @@
+/**
+ * \file classement.c
+ * \brief Classements figés publiés pour des lectures concurrentes
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "classement.h"
+#include "compression.h"
+#include "instrumentation.h"
+
+#include <limits.h>
+#include <stdarg.h>
+
+/* Ordre alphabétique des entrées */
+static int comparerEntreesNom(const void *a, const void *b){
+    return strcmp(texteChaine(((const EntreeClassement *)a)->pseudo), texteChaine(((const EntreeClassement *)b)->pseudo));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Alloue un classement de nbEntrees entrées, non trié */
+static Classement *allouerClassement(int nbEntrees){
+    Classement *classement = (Classement *)allouerMemoire(MEMOIRE_REGISTRE, sizeof(Classement));
+    if (classement == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    classement->entrees = (EntreeClassement *)allouerMemoire(MEMOIRE_REGISTRE, (nbEntrees > 0 ? nbEntrees : 1) * sizeof(EntreeClassement));
+    classement->ordreScores = (int *)allouerMemoire(MEMOIRE_REGISTRE, (nbEntrees > 0 ? nbEntrees : 1) * sizeof(int));
+    if (classement->entrees == NULL || classement->ordreScores == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    classement->version = 0;
+    classement->nbEntrees = 0;
+    classement->epoqueRetrait = 0;
+    classement->suivantRetire = NULL;
+    return classement;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Copie les champs utiles d'un chevalier dans une entrée */
+static void copierEntree(EntreeClassement *entree, Chevalier *chevalier, int indice){
+    entree->pseudo = chevalier->pseudo;
+    entree->nbParties = chevalier->nbParties;
+    entree->meilleurScore = meilleurScoreChevalier(chevalier);
+    entree->indice = indice;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Trie les entrées par nom puis calcule l'ordre des scores */
+static void ordonnerClassement(Classement *classement){
+    DEBUT_MESURE(MESURE_CLASSEMENT);
+    qsort(classement->entrees, classement->nbEntrees, sizeof(EntreeClassement), comparerEntreesNom);
+
+    // Tri par base stable : à score égal, l'ordre alphabétique est conservé
+    CleTri *cles = (CleTri *)allouerMemoire(MEMOIRE_TAMPONS, (classement->nbEntrees > 0 ? classement->nbEntrees : 1) * sizeof(CleTri));
+    if (cles == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < classement->nbEntrees; i++) {
+        cles[i].cle = (unsigned long long)((long long)INT_MAX - classement->entrees[i].meilleurScore);
+        cles[i].index = i;
+    }
+    triRadixCles(cles, classement->nbEntrees);
+    for (int i = 0; i < classement->nbEntrees; i++) {
+        classement->ordreScores[i] = cles[i].index;
+    }
+    libererMemoire(MEMOIRE_TAMPONS, cles);
+    FIN_MESURE(MESURE_CLASSEMENT);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Construit un classement à partir d'un tableau de chevaliers
+ *
+ * Le tableau n'est pas modifié (il n'est pas trié sur place).
+ *
+ * \param[in] tableau Le tableau de chevaliers
+ * \return Un nouveau classement, à publier ou à libérer
+ */
+Classement *construireClassement(TableauChevaliers *tableau){
+    Classement *classement = allouerClassement(tableau->nbChevaliers);
+
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        copierEntree(&classement->entrees[i], &tableau->chevaliers[i], i);
+    }
+    classement->nbEntrees = tableau->nbChevaliers;
+
+    ordonnerClassement(classement);
+    return classement;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Construit un classement à partir du registre
+ *
+ * Chaque fragment est verrouillé en lecture le temps de sa copie.
+ *
+ * \param[in] registre Le registre des chevaliers
+ * \return Un nouveau classement, à publier ou à libérer
+ */
+Classement *construireClassementRegistre(RegistreChevaliers *registre){
+    int capacite = nombreChevaliersRegistre(registre);
+    Classement *classement = allouerClassement(capacite);
+
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        FragmentRegistre *fragment = &registre->fragments[i];
+        pthread_rwlock_rdlock(&fragment->verrou);
+
+        // Des chevaliers ont pu être ajoutés depuis le comptage
+        if (classement->nbEntrees + fragment->tableau.nbChevaliers > capacite) {
+            capacite = 2 * (classement->nbEntrees + fragment->tableau.nbChevaliers);
+            classement->entrees = (EntreeClassement *)reallouerMemoire(MEMOIRE_REGISTRE, classement->entrees, capacite * sizeof(EntreeClassement));
+            classement->ordreScores = (int *)reallouerMemoire(MEMOIRE_REGISTRE, classement->ordreScores, capacite * sizeof(int));
+            if (classement->entrees == NULL || classement->ordreScores == NULL) {
+                perror("Erreur de réallocation mémoire");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        for (int j = 0; j < fragment->tableau.nbChevaliers; j++) {
+            copierEntree(&classement->entrees[classement->nbEntrees++], &fragment->tableau.chevaliers[j], -1);
+        }
+        pthread_rwlock_unlock(&fragment->verrou);
+    }
+
+    ordonnerClassement(classement);
+    return classement;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère la mémoire d'un classement non publié
+ *
+ * \param[in] classement Le classement à libérer
+ */
+void libererClassement(Classement *classement){
+    if (classement == NULL) return;
+    libererMemoire(MEMOIRE_REGISTRE, classement->entrees);
+    libererMemoire(MEMOIRE_REGISTRE, classement->ordreScores);
+    libererMemoire(MEMOIRE_REGISTRE, classement);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Initialise un point de publication vide
+ *
+ * \param[out] publication La publication à initialiser
+ */
+void initialiserPublication(PublicationClassement *publication){
+    publication->courant = NULL;
+    publication->epoque = 1;
+    for (int i = 0; i < MAX_LECTEURS; i++) {
+        publication->lecteurs[i] = 0;
+        publication->inscrits[i] = 0;
+    }
+    publication->prochaineVersion = 1;
+    publication->retires = NULL;
+    pthread_mutex_init(&publication->verrouPublication, NULL);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Libère les classements retirés qu'aucun lecteur actif n'a pu voir (verrou de publication pris) */
+static void recupererClassements(PublicationClassement *publication){
+    unsigned long plusAncienne = __atomic_load_n(&publication->epoque, __ATOMIC_SEQ_CST);
+
+    for (int i = 0; i < MAX_LECTEURS; i++) {
+        unsigned long e = __atomic_load_n(&publication->lecteurs[i], __ATOMIC_SEQ_CST);
+        if (e != 0 && e < plusAncienne) {
+            plusAncienne = e;
+        }
+    }
+
+    // Un lecteur entré à l'époque e a pu voir tout classement retiré à une époque >= e
+    Classement **precedent = &publication->retires;
+    while (*precedent != NULL) {
+        Classement *retire = *precedent;
+        if (retire->epoqueRetrait < plusAncienne) {
+            *precedent = retire->suivantRetire;
+            libererClassement(retire);
+        } else {
+            precedent = &retire->suivantRetire;
+        }
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Publie un nouveau classement
+ *
+ * Remplace atomiquement le classement courant, puis libère les anciens
+ * classements qu'aucun lecteur actif ne peut plus lire.
+ *
+ * \param[in,out] publication La publication
+ * \param[in] classement Le classement à publier (la publication en devient propriétaire)
+ */
+void publierClassement(PublicationClassement *publication, Classement *classement){
+    pthread_mutex_lock(&publication->verrouPublication);
+
+    classement->version = publication->prochaineVersion++;
+    Classement *ancien = __atomic_exchange_n(&publication->courant, classement, __ATOMIC_SEQ_CST);
+    if (ancien != NULL) {
+        ancien->epoqueRetrait = __atomic_fetch_add(&publication->epoque, 1, __ATOMIC_SEQ_CST);
+        ancien->suivantRetire = publication->retires;
+        publication->retires = ancien;
+    }
+    recupererClassements(publication);
+
+    pthread_mutex_unlock(&publication->verrouPublication);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Réserve un emplacement de lecteur
+ *
+ * \param[in,out] publication La publication
+ * \return L'identifiant du lecteur, -1 si tous les emplacements sont pris
+ */
+int inscrireLecteur(PublicationClassement *publication){
+    for (int i = 0; i < MAX_LECTEURS; i++) {
+        int libre = 0;
+        if (__atomic_compare_exchange_n(&publication->inscrits[i], &libre, 1, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère un emplacement de lecteur
+ *
+ * \param[in,out] publication La publication
+ * \param[in] lecteur L'identifiant rendu par \c inscrireLecteur
+ */
+void desinscrireLecteur(PublicationClassement *publication, int lecteur){
+    __atomic_store_n(&publication->lecteurs[lecteur], 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&publication->inscrits[lecteur], 0, __ATOMIC_SEQ_CST);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Commence une lecture du classement courant
+ *
+ * Le classement renvoyé reste valide jusqu'à l'appel de \c finLecture,
+ * même si un autre classement est publié entre temps.
+ *
+ * \param[in,out] publication La publication
+ * \param[in] lecteur L'identifiant du lecteur
+ * \return Le classement courant (NULL si rien n'a encore été publié)
+ */
+const Classement *debutLecture(PublicationClassement *publication, int lecteur){
+    unsigned long epoque = __atomic_load_n(&publication->epoque, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&publication->lecteurs[lecteur], epoque, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&publication->courant, __ATOMIC_SEQ_CST);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Termine une lecture du classement
+ *
+ * \param[in,out] publication La publication
+ * \param[in] lecteur L'identifiant du lecteur
+ */
+void finLecture(PublicationClassement *publication, int lecteur){
+    __atomic_store_n(&publication->lecteurs[lecteur], 0, __ATOMIC_RELEASE);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère la publication et tous ses classements
+ *
+ * Aucun lecteur ne doit être en cours de lecture.
+ *
+ * \param[in,out] publication La publication à libérer
+ */
+void libererPublication(PublicationClassement *publication){
+    while (publication->retires != NULL) {
+        Classement *suivant = publication->retires->suivantRetire;
+        libererClassement(publication->retires);
+        publication->retires = suivant;
+    }
+    libererClassement(publication->courant);
+    publication->courant = NULL;
+    pthread_mutex_destroy(&publication->verrouPublication);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Tampon de sortie : une page est formatée en mémoire puis écrite en un seul appel */
+typedef struct {
+    char *texte;
+    size_t taille;
+    size_t capacite;
+} TamponSortie;
+
+/* Ajoute une ligne formatée au tampon, en doublant sa capacité si besoin */
+static void ecrireTampon(TamponSortie *tampon, const char *format, ...){
+    va_list arguments;
+    int longueur;
+
+    while (1) {
+        va_start(arguments, format);
+        longueur = vsnprintf(tampon->texte + tampon->taille, tampon->capacite - tampon->taille, format, arguments);
+        va_end(arguments);
+        if (longueur >= 0 && tampon->taille + longueur < tampon->capacite) break;
+
+        tampon->capacite *= 2;
+        tampon->texte = (char *)reallouerMemoire(MEMOIRE_TAMPONS, tampon->texte, tampon->capacite);
+        if (tampon->texte == NULL) {
+            perror("Erreur de réallocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+    }
+    tampon->taille += longueur;
+}
+
+/* Crée un tampon vide */
+static TamponSortie creerTampon(void){
+    TamponSortie tampon;
+    tampon.capacite = 4096;
+    tampon.taille = 0;
+    tampon.texte = (char *)allouerMemoire(MEMOIRE_TAMPONS, tampon.capacite);
+    if (tampon.texte == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    tampon.texte[0] = '\0';
+    return tampon;
+}
+
+/* Écrit le tampon sur la sortie standard en une fois et le libère */
+static void viderTampon(TamponSortie *tampon){
+    fwrite(tampon->texte, 1, tampon->taille, stdout);
+    fflush(stdout);
+    libererMemoire(MEMOIRE_TAMPONS, tampon->texte);
+    tampon->texte = NULL;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Affiche une page d'un classement
+ *
+ * Utilise l'ordre déjà calculé dans le classement : le coût ne dépend que
+ * de la taille de la page. La page est formatée en mémoire et écrite en
+ * un seul appel.
+ *
+ * \param[in] classement Le classement à afficher
+ * \param[in] parScore true pour l'ordre des meilleurs scores, false pour l'ordre alphabétique
+ * \param[in] nbParPage Le nombre de lignes par page
+ * \param[in] page Le numéro de la page, à partir de 0
+ */
+void afficherPageClassement(const Classement *classement, Bool parScore, int nbParPage, int page){
+    if (classement == NULL || classement->nbEntrees == 0) {
+        printf("Aucun chevalier enregistré.\n");
+        return;
+    }
+
+    long debut = (long)nbParPage * page;
+    long fin = debut + nbParPage;
+    if (nbParPage <= 0 || page < 0 || debut >= classement->nbEntrees) {
+        printf("Page vide.\n");
+        return;
+    }
+    if (fin > classement->nbEntrees) fin = classement->nbEntrees;
+
+    TamponSortie tampon = creerTampon();
+    ecrireTampon(&tampon, "Classement (version %lu) :\n", classement->version);
+    for (long i = debut; i < fin; i++) {
+        const EntreeClassement *entree = &classement->entrees[parScore ? classement->ordreScores[i] : i];
+        ecrireTampon(&tampon, "%ld. %s - %d partie(s) - meilleur score : %d\n", i + 1, texteChaine(entree->pseudo), entree->nbParties, entree->meilleurScore);
+    }
+    ecrireTampon(&tampon, "\n");
+    viderTampon(&tampon);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Affiche un classement
+ *
+ * \param[in] classement Le classement à afficher
+ * \param[in] parScore true pour l'ordre des meilleurs scores, false pour l'ordre alphabétique
+ */
+void afficherClassement(const Classement *classement, Bool parScore){
+    afficherPageClassement(classement, parScore, (classement != NULL) ? classement->nbEntrees : 0, 0);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Affiche un classement avec la liste des scores de chaque chevalier
+ *
+ * Les scores sont lus dans le tableau d'où le classement a été construit :
+ * celui-ci ne doit pas avoir été modifié depuis.
+ *
+ * \param[in] classement Le classement à afficher, construit par construireClassement
+ * \param[in] parScore true pour l'ordre des meilleurs scores, false pour l'ordre alphabétique
+ * \param[in] tableau Le tableau de chevaliers source du classement
+ */
+void afficherClassementScores(const Classement *classement, Bool parScore, TableauChevaliers *tableau){
+    if (classement == NULL || classement->nbEntrees == 0) {
+        printf("Aucun chevalier enregistré.\n");
+        return;
+    }
+
+    TamponSortie tampon = creerTampon();
+    ecrireTampon(&tampon, "Classement (version %lu) :\n", classement->version);
+    for (int i = 0; i < classement->nbEntrees; i++) {
+        const EntreeClassement *entree = &classement->entrees[parScore ? classement->ordreScores[i] : i];
+        ecrireTampon(&tampon, "%d. %s - %d partie(s) - meilleur score : %d\n", i + 1, texteChaine(entree->pseudo), entree->nbParties, entree->meilleurScore);
+        if (entree->indice < 0 || entree->indice >= tableau->nbChevaliers) continue;
+
+        // Scores récents puis scores compressés, comme afficherTableauChevaliers
+        Chevalier *chevalier = &tableau->chevaliers[entree->indice];
+        for (MaillonScore *courant = chevalier->firstScore; courant != NULL; courant = courant->next) {
+            ecrireTampon(&tampon, "  - %d\n", courant->score);
+        }
+        LecteurScores lecteur;
+        ouvrirListeScores(&lecteur, chevalier->scoresCompresses);
+        while (scoreSuivant(&lecteur)) {
+            ecrireTampon(&tampon, "  - %d\n", lecteur.score);
+        }
+    }
+    ecrireTampon(&tampon, "\n");
+    viderTampon(&tampon);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Descend la racine d'un tas où la plus mauvaise clé est en haut */
+static void descendreTas(CleTri *tas, int taille, int i){
+    while (1) {
+        int pire = i, gauche = 2 * i + 1, droite = 2 * i + 2;
+        if (gauche < taille && comparerCles(&tas[gauche], &tas[pire], NULL) > 0) pire = gauche;
+        if (droite < taille && comparerCles(&tas[droite], &tas[pire], NULL) > 0) pire = droite;
+        if (pire == i) return;
+        CleTri temp = tas[i];
+        tas[i] = tas[pire];
+        tas[pire] = temp;
+        i = pire;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Sélectionne une page des meilleurs chevaliers sans trier tout le tableau
+ *
+ * Garde dans un tas les \c decalage + \c nb meilleures clés (score, indice)
+ * rencontrées : le coût est en O(n log(decalage + nb)). L'ordre obtenu est
+ * celui de \c triRadixChevaliers.
+ *
+ * \param[in] tableau Le tableau de chevaliers (non modifié)
+ * \param[in] nb Le nombre de chevaliers voulus
+ * \param[in] decalage Le nombre de meilleurs chevaliers à sauter
+ * \param[out] page Tableau d'au moins \c nb clés, rempli du meilleur au moins bon
+ * \return Le nombre de clés écrites dans \c page
+ */
+int selectionnerMeilleurs(TableauChevaliers *tableau, int nb, int decalage, CleTri *page){
+    if (nb <= 0 || decalage < 0 || decalage >= tableau->nbChevaliers) return 0;
+
+    int capacite = decalage + nb;
+    if (capacite > tableau->nbChevaliers) capacite = tableau->nbChevaliers;
+
+    CleTri *tas = (CleTri *)allouerMemoire(MEMOIRE_TAMPONS, capacite * sizeof(CleTri));
+    if (tas == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    int taille = 0;
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        CleTri cle = { cleScore(&tableau->chevaliers[i]), i };
+        if (taille < capacite) {
+            // Remontée dans le tas
+            int j = taille++;
+            tas[j] = cle;
+            while (j > 0 && comparerCles(&tas[(j - 1) / 2], &tas[j], NULL) < 0) {
+                CleTri temp = tas[j];
+                tas[j] = tas[(j - 1) / 2];
+                tas[(j - 1) / 2] = temp;
+                j = (j - 1) / 2;
+            }
+        } else if (comparerCles(&cle, &tas[0], NULL) < 0) {
+            tas[0] = cle;
+            descendreTas(tas, taille, 0);
+        }
+    }
+
+    // Tri par tas : les plus mauvaises clés partent à la fin
+    for (int fin = taille - 1; fin > 0; fin--) {
+        CleTri temp = tas[0];
+        tas[0] = tas[fin];
+        tas[fin] = temp;
+        descendreTas(tas, fin, 0);
+    }
+
+    int nbPage = taille - decalage;
+    memcpy(page, &tas[decalage], nbPage * sizeof(CleTri));
+    libererMemoire(MEMOIRE_TAMPONS, tas);
+    return nbPage;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Affiche une page des meilleurs chevaliers d'un tableau
+ *
+ * Sélectionne la page avec \c selectionnerMeilleurs, la formate en mémoire
+ * et l'écrit en un seul appel.
+ *
+ * \param[in] tableau Le tableau de chevaliers (non modifié)
+ * \param[in] nbParPage Le nombre de lignes par page
+ * \param[in] page Le numéro de la page, à partir de 0
+ */
+void afficherPageMeilleurs(TableauChevaliers *tableau, int nbParPage, int page){
+    if (nbParPage <= 0 || page < 0) {
+        printf("Page vide.\n");
+        return;
+    }
+
+    CleTri *cles = (CleTri *)allouerMemoire(MEMOIRE_TAMPONS, nbParPage * sizeof(CleTri));
+    if (cles == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    long decalage = (long)nbParPage * page;
+    int nb = (decalage < tableau->nbChevaliers) ? selectionnerMeilleurs(tableau, nbParPage, (int)decalage, cles) : 0;
+    if (nb == 0) {
+        printf("Page vide.\n");
+        libererMemoire(MEMOIRE_TAMPONS, cles);
+        return;
+    }
+
+    TamponSortie tampon = creerTampon();
+    for (int i = 0; i < nb; i++) {
+        Chevalier *chevalier = &tableau->chevaliers[cles[i].index];
+        ecrireTampon(&tampon, "%ld. %s - %d partie(s) - meilleur score : %d\n", decalage + i + 1, texteChaine(chevalier->pseudo),
+            chevalier->nbParties, meilleurScoreChevalier(chevalier));
+    }
+    ecrireTampon(&tampon, "\n");
+    viderTampon(&tampon);
+    libererMemoire(MEMOIRE_TAMPONS, cles);
+}
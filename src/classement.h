@@ -0,0 +1,257 @@
+/**
+ * \file classement.h
+ * \brief En-tête pour le fichier classement.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef CLASSEMENT_H
+#define CLASSEMENT_H
+
+    #include "chevalier.h"
+    #include "registre.h"
+
+    /**
+     * \def MAX_LECTEURS
+     * \brief Nombre maximum de lecteurs inscrits en même temps sur une publication.
+     */
+    #define MAX_LECTEURS 64
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct EntreeClassement
+     * \brief Ligne du classement, copiée depuis un chevalier.
+     *
+     * Une entrée ne pointe pas vers la liste des scores du chevalier :
+     * elle reste valide même si le registre est modifié ensuite (les
+     * chaînes internées ne sont jamais retirées). Son indice permet de
+     * retrouver le chevalier dans le tableau source pour lister ses scores.
+     */
+    typedef struct {
+        IdChaine pseudo;
+        int nbParties;
+        int meilleurScore;
+        int indice;        // Indice du chevalier dans le tableau source, -1 s'il vient du registre
+    } EntreeClassement;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct Classement
+     * \brief Image figée du classement à un instant donné.
+     *
+     * Les entrées sont rangées par ordre alphabétique des pseudos et
+     * \c ordreScores donne les indices des entrées par meilleur score
+     * décroissant (à égalité, par ordre alphabétique). Un classement publié
+     * n'est plus jamais modifié.
+     */
+    typedef struct Classement {
+        unsigned long version;
+        int nbEntrees;
+        EntreeClassement *entrees;
+        int *ordreScores;
+        unsigned long epoqueRetrait;       // Époque à laquelle le classement a été remplacé
+        struct Classement *suivantRetire;  // Liste des classements en attente de libération
+    } Classement;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct PublicationClassement
+     * \brief Point de publication du classement courant.
+     *
+     * Les lecteurs prennent le classement courant sans verrou et annoncent
+     * l'époque à laquelle ils ont commencé leur lecture. Un classement
+     * remplacé n'est libéré que lorsque plus aucun lecteur actif n'a pu le voir
+     * (récupération par époques).
+     */
+    typedef struct {
+        Classement *courant;
+        unsigned long epoque;
+        unsigned long lecteurs[MAX_LECTEURS];  // Époque annoncée par chaque lecteur, 0 si inactif
+        int inscrits[MAX_LECTEURS];            // 1 si l'emplacement de lecteur est pris
+        unsigned long prochaineVersion;
+        Classement *retires;
+        pthread_mutex_t verrouPublication;     // Ne sérialise que les rédacteurs
+    } PublicationClassement;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Construit un classement à partir d'un tableau de chevaliers
+     *
+     * Le tableau n'est pas modifié (il n'est pas trié sur place).
+     *
+     * \param[in] tableau Le tableau de chevaliers
+     * \return Un nouveau classement, à publier ou à libérer
+     */
+    Classement *construireClassement(TableauChevaliers *tableau);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Construit un classement à partir du registre
+     *
+     * Chaque fragment est verrouillé en lecture le temps de sa copie.
+     *
+     * \param[in] registre Le registre des chevaliers
+     * \return Un nouveau classement, à publier ou à libérer
+     */
+    Classement *construireClassementRegistre(RegistreChevaliers *registre);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère la mémoire d'un classement non publié
+     *
+     * \param[in] classement Le classement à libérer
+     */
+    void libererClassement(Classement *classement);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Initialise un point de publication vide
+     *
+     * \param[out] publication La publication à initialiser
+     */
+    void initialiserPublication(PublicationClassement *publication);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Publie un nouveau classement
+     *
+     * Remplace atomiquement le classement courant, puis libère les anciens
+     * classements qu'aucun lecteur actif ne peut plus lire.
+     *
+     * \param[in,out] publication La publication
+     * \param[in] classement Le classement à publier (la publication en devient propriétaire)
+     */
+    void publierClassement(PublicationClassement *publication, Classement *classement);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Réserve un emplacement de lecteur
+     *
+     * \param[in,out] publication La publication
+     * \return L'identifiant du lecteur, -1 si tous les emplacements sont pris
+     */
+    int inscrireLecteur(PublicationClassement *publication);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère un emplacement de lecteur
+     *
+     * \param[in,out] publication La publication
+     * \param[in] lecteur L'identifiant rendu par \c inscrireLecteur
+     */
+    void desinscrireLecteur(PublicationClassement *publication, int lecteur);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Commence une lecture du classement courant
+     *
+     * Le classement renvoyé reste valide jusqu'à l'appel de \c finLecture,
+     * même si un autre classement est publié entre temps.
+     *
+     * \param[in,out] publication La publication
+     * \param[in] lecteur L'identifiant du lecteur
+     * \return Le classement courant (NULL si rien n'a encore été publié)
+     */
+    const Classement *debutLecture(PublicationClassement *publication, int lecteur);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Termine une lecture du classement
+     *
+     * \param[in,out] publication La publication
+     * \param[in] lecteur L'identifiant du lecteur
+     */
+    void finLecture(PublicationClassement *publication, int lecteur);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère la publication et tous ses classements
+     *
+     * Aucun lecteur ne doit être en cours de lecture.
+     *
+     * \param[in,out] publication La publication à libérer
+     */
+    void libererPublication(PublicationClassement *publication);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Affiche une page d'un classement
+     *
+     * Utilise l'ordre déjà calculé dans le classement : le coût ne dépend que
+     * de la taille de la page. La page est formatée en mémoire et écrite en
+     * un seul appel.
+     *
+     * \param[in] classement Le classement à afficher
+     * \param[in] parScore true pour l'ordre des meilleurs scores, false pour l'ordre alphabétique
+     * \param[in] nbParPage Le nombre de lignes par page
+     * \param[in] page Le numéro de la page, à partir de 0
+     */
+    void afficherPageClassement(const Classement *classement, Bool parScore, int nbParPage, int page);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Affiche un classement
+     *
+     * \param[in] classement Le classement à afficher
+     * \param[in] parScore true pour l'ordre des meilleurs scores, false pour l'ordre alphabétique
+     */
+    void afficherClassement(const Classement *classement, Bool parScore);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Affiche un classement avec la liste des scores de chaque chevalier
+     *
+     * Les scores sont lus dans le tableau d'où le classement a été construit :
+     * celui-ci ne doit pas avoir été modifié depuis.
+     *
+     * \param[in] classement Le classement à afficher, construit par construireClassement
+     * \param[in] parScore true pour l'ordre des meilleurs scores, false pour l'ordre alphabétique
+     * \param[in] tableau Le tableau de chevaliers source du classement
+     */
+    void afficherClassementScores(const Classement *classement, Bool parScore, TableauChevaliers *tableau);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Sélectionne une page des meilleurs chevaliers sans trier tout le tableau
+     *
+     * Garde dans un tas les \c decalage + \c nb meilleures clés (score, indice)
+     * rencontrées : le coût est en O(n log(decalage + nb)). L'ordre obtenu est
+     * celui de \c triRadixChevaliers.
+     *
+     * \param[in] tableau Le tableau de chevaliers (non modifié)
+     * \param[in] nb Le nombre de chevaliers voulus
+     * \param[in] decalage Le nombre de meilleurs chevaliers à sauter
+     * \param[out] page Tableau d'au moins \c nb clés, rempli du meilleur au moins bon
+     * \return Le nombre de clés écrites dans \c page
+     */
+    int selectionnerMeilleurs(TableauChevaliers *tableau, int nb, int decalage, CleTri *page);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Affiche une page des meilleurs chevaliers d'un tableau
+     *
+     * \param[in] tableau Le tableau de chevaliers (non modifié)
+     * \param[in] nbParPage Le nombre de lignes par page
+     * \param[in] page Le numéro de la page, à partir de 0
+     */
+    void afficherPageMeilleurs(TableauChevaliers *tableau, int nbParPage, int page);
+
+#endif
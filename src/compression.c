@@ -0,0 +1,189 @@
+/**
+ * \file compression.c
+ * \brief Encodage compact (écarts et LEB128) des listes de scores
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "compression.h"
+#include "instrumentation.h"
+
+/**
+ * \brief Encode un entier non signé en LEB128
+ *
+ * Sept bits par octet, le bit de poids fort indique qu'un octet suit.
+ *
+ * \param[in] valeur L'entier à encoder
+ * \param[out] sortie Au moins \c TAILLE_MAX_VARINT octets
+ * \return Le nombre d'octets écrits
+ */
+int encoderVarint(unsigned long long valeur, unsigned char *sortie){
+    int n = 0;
+    while (valeur >= 0x80) {
+        sortie[n++] = (unsigned char)(valeur | 0x80);
+        valeur >>= 7;
+    }
+    sortie[n++] = (unsigned char)valeur;
+    return n;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Décode un entier non signé encodé en LEB128
+ *
+ * \param[in] entree Les octets à décoder
+ * \param[out] valeur L'entier décodé
+ * \return La position qui suit le dernier octet lu
+ */
+const unsigned char *decoderVarint(const unsigned char *entree, unsigned long long *valeur){
+    // Cas le plus fréquent (écarts entre scores voisins) : un seul octet, sans boucle
+    if (entree[0] < 0x80) {
+        *valeur = entree[0];
+        return entree + 1;
+    }
+
+    unsigned long long resultat = 0;
+    int decalage = 0;
+    do {
+        resultat |= (unsigned long long)(*entree & 0x7F) << decalage;
+        decalage += 7;
+    } while (*entree++ & 0x80);
+    *valeur = resultat;
+    return entree;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Transforme un entier signé en entier non signé petit si sa valeur absolue est petite
+ *
+ * \param[in] valeur L'entier signé
+ * \return 2 * valeur si elle est positive, -2 * valeur - 1 sinon
+ */
+unsigned long long encoderZigzag(long long valeur){
+    return ((unsigned long long)valeur << 1) ^ (unsigned long long)(valeur >> 63);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Inverse de \c encoderZigzag
+ *
+ * \param[in] valeur L'entier non signé
+ * \return L'entier signé d'origine
+ */
+long long decoderZigzag(unsigned long long valeur){
+    return (long long)(valeur >> 1) ^ -(long long)(valeur & 1);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compresse une liste de scores triée par ordre décroissant
+ *
+ * Le bloc contient le nombre de scores, puis pour chaque score l'écart avec
+ * le score précédent (toujours positif) et l'écart de numéro de partie,
+ * chacun en LEB128. Un score tient en général sur 2 ou 3 octets.
+ *
+ * \param[in] premier Le premier maillon de la liste
+ * \param[out] taille La taille du bloc en octets
+ * \return Le bloc alloué, à libérer avec \c libererMemoire (MEMOIRE_SCORES)
+ * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+ */
+unsigned char *compresserListeScores(const MaillonScore *premier, int *taille){
+    int nb = 0;
+    for (const MaillonScore *m = premier; m != NULL; m = m->next) {
+        nb++;
+    }
+
+    // Pire cas : chaque valeur occupe TAILLE_MAX_VARINT octets
+    unsigned char *tampon = (unsigned char *)allouerMemoire(MEMOIRE_SCORES, (1 + 2 * (size_t)nb) * TAILLE_MAX_VARINT);
+    if (tampon == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    int n = encoderVarint(nb, tampon);
+    long long scorePrecedent = 0;
+    long long numeroPrecedent = 0;
+    for (const MaillonScore *m = premier; m != NULL; m = m->next) {
+        // Le premier score est codé tel quel (zigzag), les suivants par leur écart au précédent
+        if (m == premier) {
+            n += encoderVarint(encoderZigzag(m->score), tampon + n);
+        } else {
+            n += encoderVarint((unsigned long long)(scorePrecedent - m->score), tampon + n);
+        }
+        n += encoderVarint(encoderZigzag((long long)m->numero - numeroPrecedent), tampon + n);
+        scorePrecedent = m->score;
+        numeroPrecedent = m->numero;
+    }
+
+    // On rend au système la place réservée pour le pire cas
+    unsigned char *bloc = (unsigned char *)reallouerMemoire(MEMOIRE_SCORES, tampon, n);
+    *taille = n;
+    return (bloc != NULL) ? bloc : tampon;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Prépare la lecture d'un bloc de scores compressé
+ *
+ * \param[out] lecteur Le curseur à initialiser
+ * \param[in] bloc Le bloc produit par \c compresserListeScores
+ */
+void ouvrirListeScores(LecteurScores *lecteur, const unsigned char *bloc){
+    unsigned long long nb = 0;
+
+    lecteur->position = (bloc != NULL) ? decoderVarint(bloc, &nb) : NULL;
+    lecteur->restants = (int)nb;
+    lecteur->lus = 0;
+    lecteur->score = 0;
+    lecteur->numero = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Décode le score suivant d'un bloc
+ *
+ * Les scores sont rendus dans l'ordre de la liste d'origine (décroissant).
+ *
+ * \param[in,out] lecteur Le curseur
+ * \return true si un score a été décodé, false à la fin du bloc
+ */
+Bool scoreSuivant(LecteurScores *lecteur){
+    unsigned long long ecart, ecartNumero;
+
+    if (lecteur->restants <= 0) {
+        return false;
+    }
+
+    lecteur->position = decoderVarint(lecteur->position, &ecart);
+    lecteur->position = decoderVarint(lecteur->position, &ecartNumero);
+    if (lecteur->lus == 0) {
+        lecteur->score = (int)decoderZigzag(ecart);
+    } else {
+        lecteur->score -= (int)ecart;
+    }
+    lecteur->numero += (int)decoderZigzag(ecartNumero);
+    lecteur->restants--;
+    lecteur->lus++;
+    return true;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le nombre de scores d'un bloc sans le décoder
+ *
+ * \param[in] bloc Le bloc compressé
+ * \return Le nombre de scores du bloc
+ */
+int nombreScoresBloc(const unsigned char *bloc){
+    unsigned long long nb = 0;
+    if (bloc != NULL) {
+        decoderVarint(bloc, &nb);
+    }
+    return (int)nb;
+}
@@ -0,0 +1,128 @@
+/**
+ * \file compression.h
+ * \brief En-tête pour le fichier compression.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+    #include "chevalier.h"
+
+    /**
+     * \def TAILLE_MAX_VARINT
+     * \brief Nombre maximum d'octets d'un entier de 64 bits encodé en LEB128.
+     */
+    #define TAILLE_MAX_VARINT 10
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct LecteurScores
+     * \brief Curseur de lecture d'une liste de scores compressée.
+     *
+     * Après chaque appel réussi à \c scoreSuivant, \c score et \c numero
+     * contiennent le score décodé et son numéro de partie.
+     */
+    typedef struct {
+        const unsigned char *position;
+        int restants;   // Scores qui restent à décoder
+        int lus;        // Scores déjà décodés
+        int score;
+        int numero;
+    } LecteurScores;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Encode un entier non signé en LEB128
+     *
+     * Sept bits par octet, le bit de poids fort indique qu'un octet suit.
+     *
+     * \param[in] valeur L'entier à encoder
+     * \param[out] sortie Au moins \c TAILLE_MAX_VARINT octets
+     * \return Le nombre d'octets écrits
+     */
+    int encoderVarint(unsigned long long valeur, unsigned char *sortie);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Décode un entier non signé encodé en LEB128
+     *
+     * \param[in] entree Les octets à décoder
+     * \param[out] valeur L'entier décodé
+     * \return La position qui suit le dernier octet lu
+     */
+    const unsigned char *decoderVarint(const unsigned char *entree, unsigned long long *valeur);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Transforme un entier signé en entier non signé petit si sa valeur absolue est petite
+     *
+     * \param[in] valeur L'entier signé
+     * \return 2 * valeur si elle est positive, -2 * valeur - 1 sinon
+     */
+    unsigned long long encoderZigzag(long long valeur);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Inverse de \c encoderZigzag
+     *
+     * \param[in] valeur L'entier non signé
+     * \return L'entier signé d'origine
+     */
+    long long decoderZigzag(unsigned long long valeur);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compresse une liste de scores triée par ordre décroissant
+     *
+     * Le bloc contient le nombre de scores, puis pour chaque score l'écart avec
+     * le score précédent (toujours positif) et l'écart de numéro de partie,
+     * chacun en LEB128. Un score tient en général sur 2 ou 3 octets.
+     *
+     * \param[in] premier Le premier maillon de la liste
+     * \param[out] taille La taille du bloc en octets
+     * \return Le bloc alloué, à libérer avec \c libererMemoire (MEMOIRE_SCORES)
+     * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+     */
+    unsigned char *compresserListeScores(const MaillonScore *premier, int *taille);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Prépare la lecture d'un bloc de scores compressé
+     *
+     * \param[out] lecteur Le curseur à initialiser
+     * \param[in] bloc Le bloc produit par \c compresserListeScores
+     */
+    void ouvrirListeScores(LecteurScores *lecteur, const unsigned char *bloc);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Décode le score suivant d'un bloc
+     *
+     * Les scores sont rendus dans l'ordre de la liste d'origine (décroissant).
+     *
+     * \param[in,out] lecteur Le curseur
+     * \return true si un score a été décodé, false à la fin du bloc
+     */
+    Bool scoreSuivant(LecteurScores *lecteur);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le nombre de scores d'un bloc sans le décoder
+     *
+     * \param[in] bloc Le bloc compressé
+     * \return Le nombre de scores du bloc
+     */
+    int nombreScoresBloc(const unsigned char *bloc);
+
+#endif
@@ -0,0 +1,272 @@
+/**
+ * \file generateur.c
+ * \brief Fichiers des scores et de monstres synthétiques, reproductibles à partir d'une graine
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "generateur.h"
+
+#include <limits.h>
+
+/* Caractères des pseudos générés */
+static const char alphabetPseudos[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+#define TAILLE_ALPHABET_PSEUDOS 36
+
+/* Noms des monstres générés */
+static const char *nomsMonstres[] = {"Chouin-Chouin", "Lutin_Cordial", "Chimere", "Petite_Pustule", "Dragonus", "Gobelin", "Troll_Grincheux"};
+#define NB_NOMS_MONSTRES 7
+
+/**
+ * \brief Initialise un générateur avec une graine
+ *
+ * \param[out] aleatoire Le générateur
+ * \param[in] graine La graine
+ */
+void initialiserAleatoire(Aleatoire *aleatoire, unsigned long long graine){
+    aleatoire->etat = graine;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tire un entier sur 64 bits
+ *
+ * \param[in,out] aleatoire Le générateur
+ * \return Le prochain entier de la suite
+ */
+unsigned long long tirerAleatoire(Aleatoire *aleatoire){
+    unsigned long long z = (aleatoire->etat += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Tire un entier entre 0 et borne - 1
+ *
+ * \param[in,out] aleatoire Le générateur
+ * \param[in] borne Le nombre de valeurs possibles (au moins 1)
+ * \return L'entier tiré
+ */
+unsigned int tirerEntier(Aleatoire *aleatoire, unsigned int borne){
+    // Les 32 bits de poids fort multipliés par la borne : pas de biais du modulo sur les petites bornes
+    return (unsigned int)(((tirerAleatoire(aleatoire) >> 32) * borne) >> 32);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne les paramètres par défaut d'un fichier des scores
+ *
+ * 1000 chevaliers, pseudos de 4 à 12 caractères, 1 à 20 parties
+ * uniformes, scores de 0 à 2000 sans ex aequo forcés, graine 1.
+ *
+ * \param[out] parametres Les paramètres à remplir
+ */
+void parametresScoresDefaut(ParametresScores *parametres){
+    parametres->nbChevaliers = 1000;
+    parametres->longueurMin = 4;
+    parametres->longueurMax = 12;
+    parametres->nbPartiesMin = 1;
+    parametres->nbPartiesMax = 20;
+    parametres->asymetrie = 0;
+    parametres->scoreMax = 2000;
+    parametres->nbValeursScores = 0;
+    parametres->graine = 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne les paramètres par défaut d'un fichier de monstres
+ *
+ * 10 monstres par vague, autant de chaque niveau, graine 1.
+ *
+ * \param[out] parametres Les paramètres à remplir
+ */
+void parametresVaguesDefaut(ParametresVagues *parametres){
+    parametres->nbMonstresVague1 = 10;
+    parametres->nbMonstresVague2 = 10;
+    parametres->poidsNiveaux[0] = 1;
+    parametres->poidsNiveaux[1] = 1;
+    parametres->poidsNiveaux[2] = 1;
+    parametres->graine = 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Permutation de [0, nb) : congruence de période masque + 1 (puissance de 2), répétée jusqu'à retomber sous nb */
+static unsigned long long permuterNumero(unsigned long long numero, unsigned long long nb, unsigned long long masque, unsigned long long increment){
+    do {
+        numero = (numero * 6364136223846793005ULL + increment) & masque;
+    } while (numero >= nb);
+    return numero;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Écrit un pseudo : le numéro en base 36 sur nbChiffres caractères (unicité), puis des caractères au hasard */
+static void genererPseudo(char *pseudo, unsigned long long numero, int nbChiffres, int longueur, Aleatoire *aleatoire){
+    for (int i = nbChiffres - 1; i >= 0; i--) {
+        pseudo[i] = alphabetPseudos[numero % TAILLE_ALPHABET_PSEUDOS];
+        numero /= TAILLE_ALPHABET_PSEUDOS;
+    }
+    for (int i = nbChiffres; i < longueur; i++) {
+        pseudo[i] = alphabetPseudos[tirerEntier(aleatoire, TAILLE_ALPHABET_PSEUDOS)];
+    }
+    pseudo[longueur] = '\0';
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Tire un nombre de parties : le plus petit de asymetrie + 1 tirages uniformes */
+static int tirerNbParties(const ParametresScores *parametres, Aleatoire *aleatoire){
+    unsigned int etendue = (unsigned int)(parametres->nbPartiesMax - parametres->nbPartiesMin + 1);
+    unsigned int nb = tirerEntier(aleatoire, etendue);
+    for (int i = 0; i < parametres->asymetrie; i++) {
+        unsigned int autre = tirerEntier(aleatoire, etendue);
+        if (autre < nb) nb = autre;
+    }
+    return parametres->nbPartiesMin + (int)nb;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Tire un score, parmi nbValeursScores valeurs régulièrement espacées si elles sont imposées */
+static int tirerScore(const ParametresScores *parametres, Aleatoire *aleatoire){
+    if (parametres->nbValeursScores <= 0) {
+        return (int)tirerEntier(aleatoire, (unsigned int)parametres->scoreMax + 1);
+    }
+    if (parametres->nbValeursScores == 1) {
+        return parametres->scoreMax;
+    }
+    int rang = (int)tirerEntier(aleatoire, (unsigned int)parametres->nbValeursScores);
+    return (int)((long long)rang * parametres->scoreMax / (parametres->nbValeursScores - 1));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Écrit un fichier des scores synthétique
+ *
+ * Les pseudos sont tous différents et dans un ordre sans rapport avec
+ * l'ordre alphabétique. Le fichier est écrit chevalier par chevalier, au
+ * format de \c sauvegarderTableauChevaliers : sa taille n'est pas limitée
+ * par la mémoire. Le même jeu de paramètres donne le même fichier.
+ *
+ * \param[in] chemin Le chemin du fichier à écrire
+ * \param[in] parametres La forme du fichier
+ * \note Si le fichier ne peut pas être écrit, le programme termine avec un message d'erreur.
+ */
+void genererFichierScores(const char *chemin, const ParametresScores *parametres){
+    char pseudo[LONGUEUR_MAX_PSEUDO + 1];
+    Aleatoire aleatoire;
+    FILE *fs;
+
+    if (parametres->nbChevaliers < 0 || parametres->nbChevaliers > INT_MAX || parametres->longueurMin > parametres->longueurMax
+        || parametres->nbPartiesMin < 0 || parametres->nbPartiesMin > parametres->nbPartiesMax || parametres->scoreMax < 0
+        || parametres->scoreMax > SCORE_MAX) {
+        fprintf(stderr, "Erreur : paramètres du fichier des scores invalides.\n");
+        exit(EXIT_FAILURE);
+    }
+    if ((fs = fopen(chemin, "w")) == NULL) {
+        perror("Impossible d'ouvrir le fichier");
+        exit(EXIT_FAILURE);
+    }
+    initialiserAleatoire(&aleatoire, parametres->graine);
+
+    // Assez de chiffres en base 36 pour numéroter tous les chevaliers
+    int nbChiffres = 1;
+    for (unsigned long long puissance = TAILLE_ALPHABET_PSEUDOS; puissance < (unsigned long long)parametres->nbChevaliers; puissance *= TAILLE_ALPHABET_PSEUDOS) {
+        nbChiffres++;
+    }
+    int longueurMin = (parametres->longueurMin < nbChiffres) ? nbChiffres : parametres->longueurMin;
+    int longueurMax = (parametres->longueurMax < longueurMin) ? longueurMin : parametres->longueurMax;
+    if (longueurMax > LONGUEUR_MAX_PSEUDO) longueurMax = LONGUEUR_MAX_PSEUDO;
+    if (longueurMin > longueurMax) longueurMin = longueurMax;
+
+    // Période de la permutation : la plus petite puissance de 2 qui contient tous les numéros
+    unsigned long long masque = 1;
+    while (masque < (unsigned long long)parametres->nbChevaliers) {
+        masque <<= 1;
+    }
+    masque--;
+    unsigned long long increment = (tirerAleatoire(&aleatoire) | 1) & masque;
+    if (increment == 0) increment = 1;
+
+    fprintf(fs, "%ld %d\n", parametres->nbChevaliers, VERSION_FICHIER_SCORES);
+    for (long i = 0; i < parametres->nbChevaliers; i++) {
+        unsigned long long numero = permuterNumero((unsigned long long)i, (unsigned long long)parametres->nbChevaliers, masque, increment);
+        int longueur = longueurMin + (int)tirerEntier(&aleatoire, (unsigned int)(longueurMax - longueurMin + 1));
+        genererPseudo(pseudo, numero, nbChiffres, longueur, &aleatoire);
+
+        // Le chevalier passe par ajouterScore : résumé, rétention et scores compactés sont ceux du jeu
+        Chevalier chevalier = creerChevalier("");
+        int nbParties = tirerNbParties(parametres, &aleatoire);
+        for (int j = 0; j < nbParties; j++) {
+            ajouterScore(&chevalier, tirerScore(parametres, &aleatoire));
+        }
+        ecrireChevalierTexte(fs, pseudo, &chevalier);
+        libererChevalier(&chevalier);
+    }
+
+    fclose(fs);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Tire un niveau de monstre selon les poids des niveaux */
+static int tirerNiveau(const ParametresVagues *parametres, int poidsTotal, Aleatoire *aleatoire){
+    int tirage = (int)tirerEntier(aleatoire, (unsigned int)poidsTotal);
+    int niveau = 0;
+    while (tirage >= parametres->poidsNiveaux[niveau]) {
+        tirage -= parametres->poidsNiveaux[niveau];
+        niveau++;
+    }
+    return niveau + 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Écrit un fichier de monstres synthétique
+ *
+ * Le fichier est au format lu par \c lireMonstres. Le même jeu de
+ * paramètres donne le même fichier.
+ *
+ * \param[in] chemin Le chemin du fichier à écrire
+ * \param[in] parametres La forme du fichier
+ * \note Si le fichier ne peut pas être écrit, le programme termine avec un message d'erreur.
+ */
+void genererFichierVagues(const char *chemin, const ParametresVagues *parametres){
+    Aleatoire aleatoire;
+    FILE *fs;
+    int poidsTotal = 0;
+
+    for (int i = 0; i < 3; i++) {
+        if (parametres->poidsNiveaux[i] < 0) poidsTotal = -1;
+        if (poidsTotal >= 0) poidsTotal += parametres->poidsNiveaux[i];
+    }
+    if (poidsTotal <= 0 || parametres->nbMonstresVague1 < 0 || parametres->nbMonstresVague2 < 0) {
+        fprintf(stderr, "Erreur : paramètres du fichier de monstres invalides.\n");
+        exit(EXIT_FAILURE);
+    }
+    if ((fs = fopen(chemin, "w")) == NULL) {
+        perror("Impossible d'ouvrir le fichier");
+        exit(EXIT_FAILURE);
+    }
+    initialiserAleatoire(&aleatoire, parametres->graine);
+
+    for (int vague = 1; vague <= 2; vague++) {
+        int nb = (vague == 1) ? parametres->nbMonstresVague1 : parametres->nbMonstresVague2;
+        fprintf(fs, "Contexte\n%d\n", nb);
+        for (int i = 0; i < nb; i++) {
+            const char *nom = nomsMonstres[tirerEntier(&aleatoire, NB_NOMS_MONSTRES)];
+            fprintf(fs, "%s %d\n", nom, tirerNiveau(parametres, poidsTotal, &aleatoire));
+        }
+    }
+
+    fclose(fs);
+}
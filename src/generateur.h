@@ -0,0 +1,139 @@
+/**
+ * \file generateur.h
+ * \brief En-tête pour le fichier generateur.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef GENERATEUR_H
+#define GENERATEUR_H
+
+    #include "chevalier.h"
+
+    /**
+     * \struct Aleatoire
+     * \brief Générateur pseudo-aléatoire reproductible (splitmix64).
+     *
+     * Deux générateurs initialisés avec la même graine donnent la même suite,
+     * quels que soient la machine et les autres appels à \c rand.
+     */
+    typedef struct {
+        unsigned long long etat;
+    } Aleatoire;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ParametresScores
+     * \brief Forme d'un fichier des scores synthétique.
+     */
+    typedef struct {
+        long nbChevaliers;
+        int longueurMin;          // Longueur des pseudos, tirée uniformément entre ces bornes
+        int longueurMax;
+        int nbPartiesMin;         // Nombre de parties de chaque chevalier
+        int nbPartiesMax;
+        int asymetrie;            // 0 : nombres de parties uniformes ; k : minimum de k + 1 tirages, resserré vers nbPartiesMin
+        int scoreMax;             // Scores entre 0 et scoreMax
+        int nbValeursScores;      // 0 : toutes les valeurs ; n : seulement n valeurs régulièrement espacées (beaucoup d'ex aequo)
+        unsigned long long graine;
+    } ParametresScores;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ParametresVagues
+     * \brief Forme d'un fichier de monstres synthétique.
+     */
+    typedef struct {
+        int nbMonstresVague1;
+        int nbMonstresVague2;
+        int poidsNiveaux[3];      // Poids relatifs des niveaux 1, 2 et 3
+        unsigned long long graine;
+    } ParametresVagues;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Initialise un générateur avec une graine
+     *
+     * \param[out] aleatoire Le générateur
+     * \param[in] graine La graine
+     */
+    void initialiserAleatoire(Aleatoire *aleatoire, unsigned long long graine);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Tire un entier sur 64 bits
+     *
+     * \param[in,out] aleatoire Le générateur
+     * \return Le prochain entier de la suite
+     */
+    unsigned long long tirerAleatoire(Aleatoire *aleatoire);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Tire un entier entre 0 et borne - 1
+     *
+     * \param[in,out] aleatoire Le générateur
+     * \param[in] borne Le nombre de valeurs possibles (au moins 1)
+     * \return L'entier tiré
+     */
+    unsigned int tirerEntier(Aleatoire *aleatoire, unsigned int borne);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne les paramètres par défaut d'un fichier des scores
+     *
+     * 1000 chevaliers, pseudos de 4 à 12 caractères, 1 à 20 parties
+     * uniformes, scores de 0 à 2000 sans ex aequo forcés, graine 1.
+     *
+     * \param[out] parametres Les paramètres à remplir
+     */
+    void parametresScoresDefaut(ParametresScores *parametres);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne les paramètres par défaut d'un fichier de monstres
+     *
+     * 10 monstres par vague, autant de chaque niveau, graine 1.
+     *
+     * \param[out] parametres Les paramètres à remplir
+     */
+    void parametresVaguesDefaut(ParametresVagues *parametres);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Écrit un fichier des scores synthétique
+     *
+     * Les pseudos sont tous différents et dans un ordre sans rapport avec
+     * l'ordre alphabétique. Le fichier est écrit chevalier par chevalier, au
+     * format de \c sauvegarderTableauChevaliers : sa taille n'est pas limitée
+     * par la mémoire. Le même jeu de paramètres donne le même fichier.
+     *
+     * \param[in] chemin Le chemin du fichier à écrire
+     * \param[in] parametres La forme du fichier
+     * \note Si le fichier ne peut pas être écrit, le programme termine avec un message d'erreur.
+     */
+    void genererFichierScores(const char *chemin, const ParametresScores *parametres);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Écrit un fichier de monstres synthétique
+     *
+     * Le fichier est au format lu par \c lireMonstres. Le même jeu de
+     * paramètres donne le même fichier.
+     *
+     * \param[in] chemin Le chemin du fichier à écrire
+     * \param[in] parametres La forme du fichier
+     * \note Si le fichier ne peut pas être écrit, le programme termine avec un message d'erreur.
+     */
+    void genererFichierVagues(const char *chemin, const ParametresVagues *parametres);
+
+#endif
@@ -0,0 +1,723 @@
+/**
+ * \file instrumentation.c
+ * \brief Compteurs et durées des chemins critiques
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "instrumentation.h"
+
+#include <malloc.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * \def AJOUTER_SEUL
+ * \brief Ajoute une valeur à un compteur écrit par un seul fil et lu par d'autres.
+ *
+ * Ni verrou ni instruction atomique à l'écriture : seules la lecture et
+ * l'écriture du compteur sont indivisibles, pour que les autres fils ne
+ * lisent jamais une valeur à moitié écrite.
+ */
+#define AJOUTER_SEUL(compteur, valeur) \
+    __atomic_store_n(&(compteur), __atomic_load_n(&(compteur), __ATOMIC_RELAXED) + (valeur), __ATOMIC_RELAXED)
+
+/* Histogrammes des points de mesure d'un fil : les fils du registre et du tri parallèle mesurent sans se gêner */
+typedef struct BlocMesures {
+    HistogrammeLatences points[NB_POINTS_MESURE];
+    struct BlocMesures *suivant;         // Liste de tous les blocs
+    struct BlocMesures *suivantLibre;    // Liste des blocs rendus par les fils terminés
+} BlocMesures;
+
+static BlocMesures *blocs = NULL;
+static BlocMesures *blocsLibres = NULL;
+static pthread_mutex_t verrouBlocs = PTHREAD_MUTEX_INITIALIZER;
+static __thread BlocMesures *blocFil = NULL;
+static pthread_key_t cleBloc;
+static pthread_once_t cleBlocCreee = PTHREAD_ONCE_INIT;
+
+static const char *nomsMesures[NB_POINTS_MESURE] = {"chargement", "sauvegarde", "tri", "classement", "recherche", "vagues", "manche",
+                                                    "partie", "requete classement", "requete stats"};
+
+/* Compteurs de mémoire, mis à jour comme les mesures par des opérations atomiques */
+static StatistiquesMemoire memoires[NB_SOUS_SYSTEMES];
+
+static const char *nomsSousSystemes[NB_SOUS_SYSTEMES] = {"registre", "scores", "vagues", "noms", "tampons"};
+
+/* Un événement de trace : les anneaux passent d'un fil à l'autre, l'événement garde donc son fil */
+typedef struct {
+    const char *nom;
+    long long debut;
+    long long duree;
+    int fil;
+} EvenementTrace;
+
+/* Anneau d'événements d'un fil, écrit sans verrou par ce seul fil */
+typedef struct AnneauTrace {
+    EvenementTrace evenements[TAILLE_ANNEAU_TRACE];
+    long nbEcrits;                       // Depuis le début de la trace : au-delà de la taille, les plus anciens sont écrasés
+    struct AnneauTrace *suivant;         // Liste de tous les anneaux
+    struct AnneauTrace *suivantLibre;    // Liste des anneaux rendus par les fils terminés
+} AnneauTrace;
+
+static int traceActive = 0;
+static char *cheminTrace = NULL;
+static long long origineTrace;
+static int filPrincipal;
+static int nbFils = 0;
+static AnneauTrace *anneaux = NULL;
+static AnneauTrace *anneauxLibres = NULL;
+static pthread_mutex_t verrouTrace = PTHREAD_MUTEX_INITIALIZER;
+static __thread AnneauTrace *anneauFil = NULL;
+static __thread int numeroFil = 0;
+static pthread_key_t cleAnneau;
+static pthread_once_t cleCreee = PTHREAD_ONCE_INIT;
+
+/**
+ * \brief Lit l'horloge monotone
+ *
+ * \return Le temps en nanosecondes depuis une origine fixe
+ */
+long long horlogeMesure(void){
+    struct timespec maintenant;
+    clock_gettime(CLOCK_MONOTONIC, &maintenant);
+    return (long long)maintenant.tv_sec * 1000000000LL + maintenant.tv_nsec;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Rend le bloc d'un fil qui se termine : ses durées restent comptées et un autre fil le reprend */
+static void rendreBloc(void *bloc){
+    pthread_mutex_lock(&verrouBlocs);
+    ((BlocMesures *)bloc)->suivantLibre = blocsLibres;
+    blocsLibres = (BlocMesures *)bloc;
+    pthread_mutex_unlock(&verrouBlocs);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Crée la clé qui rend le bloc d'un fil à sa fin */
+static void creerCleBloc(void){
+    pthread_key_create(&cleBloc, rendreBloc);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Donne un bloc au fil courant : un bloc rendu s'il y en a, sinon un nouveau */
+static BlocMesures *prendreBloc(void){
+    pthread_once(&cleBlocCreee, creerCleBloc);
+
+    pthread_mutex_lock(&verrouBlocs);
+    BlocMesures *bloc = blocsLibres;
+    if (bloc != NULL) {
+        blocsLibres = bloc->suivantLibre;
+    } else {
+        bloc = (BlocMesures *)calloc(1, sizeof(BlocMesures));
+        if (bloc == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        bloc->suivant = blocs;
+        blocs = bloc;
+    }
+    pthread_mutex_unlock(&verrouBlocs);
+
+    pthread_setspecific(cleBloc, bloc);
+    return bloc;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Case d'une durée : exacte sous 2^BITS_SOUS_CASES ns, puis 2^BITS_SOUS_CASES cases par puissance de 2 */
+static inline int caseHistogramme(long long duree){
+    if (duree < (1LL << BITS_SOUS_CASES)) return (duree < 0) ? 0 : (int)duree;
+    if (duree >= (1LL << BITS_DUREE_MAX)) return NB_CASES_HISTOGRAMME - 1;
+
+    int decalage = 63 - __builtin_clzll((unsigned long long)duree) - BITS_SOUS_CASES;
+    return ((decalage + 1) << BITS_SOUS_CASES) + (int)((duree >> decalage) & ((1 << BITS_SOUS_CASES) - 1));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Ajoute une durée aux compteurs et à l'histogramme d'un point de mesure
+ *
+ * Utilisable par plusieurs threads en même temps : chaque fil écrit dans
+ * son bloc, pris à sa première mesure. Pendant une trace, la durée est
+ * aussi enregistrée comme événement.
+ *
+ * \param[in] point Le point de mesure
+ * \param[in] debut Le début de la mesure, donné par \c horlogeMesure
+ * \param[in] fin La fin de la mesure, donnée par \c horlogeMesure
+ */
+void enregistrerMesure(PointMesure point, long long debut, long long fin){
+    if (blocFil == NULL) {
+        blocFil = prendreBloc();
+    }
+    HistogrammeLatences *histogramme = &blocFil->points[point];
+    long long duree = fin - debut;
+    AJOUTER_SEUL(histogramme->nb, 1);
+    AJOUTER_SEUL(histogramme->totalNs, duree);
+    AJOUTER_SEUL(histogramme->cases[caseHistogramme(duree)], 1);
+    if (duree > __atomic_load_n(&histogramme->maxNs, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&histogramme->maxNs, duree, __ATOMIC_RELAXED);
+    }
+
+    if (__atomic_load_n(&traceActive, __ATOMIC_RELAXED)) {
+        tracerEvenement(nomsMesures[point], debut, fin);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Lit les compteurs d'un point de mesure
+ *
+ * \param[in] point Le point de mesure
+ * \param[out] stats Les compteurs du point, tous fils confondus
+ */
+void lireMesure(PointMesure point, StatistiquesMesure *stats){
+    memset(stats, 0, sizeof(StatistiquesMesure));
+    pthread_mutex_lock(&verrouBlocs);
+    for (BlocMesures *bloc = blocs; bloc != NULL; bloc = bloc->suivant) {
+        HistogrammeLatences *histogramme = &bloc->points[point];
+        long long max = __atomic_load_n(&histogramme->maxNs, __ATOMIC_RELAXED);
+        stats->nb += __atomic_load_n(&histogramme->nb, __ATOMIC_RELAXED);
+        stats->totalNs += __atomic_load_n(&histogramme->totalNs, __ATOMIC_RELAXED);
+        if (max > stats->maxNs) stats->maxNs = max;
+    }
+    pthread_mutex_unlock(&verrouBlocs);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Lit l'histogramme d'un point de mesure
+ *
+ * \param[in] point Le point de mesure
+ * \param[out] histogramme L'histogramme du point, fusion de ceux de tous les fils
+ */
+void lireHistogramme(PointMesure point, HistogrammeLatences *histogramme){
+    memset(histogramme, 0, sizeof(HistogrammeLatences));
+    pthread_mutex_lock(&verrouBlocs);
+    for (BlocMesures *bloc = blocs; bloc != NULL; bloc = bloc->suivant) {
+        fusionnerHistogrammes(histogramme, &bloc->points[point]);
+    }
+    pthread_mutex_unlock(&verrouBlocs);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Ajoute un histogramme à un autre
+ *
+ * La source peut être en cours de remplissage par un autre fil : chacun
+ * de ses compteurs est lu d'un bloc.
+ *
+ * \param[in,out] cible L'histogramme qui reçoit les durées
+ * \param[in] source L'histogramme ajouté
+ */
+void fusionnerHistogrammes(HistogrammeLatences *cible, const HistogrammeLatences *source){
+    long long max = __atomic_load_n(&source->maxNs, __ATOMIC_RELAXED);
+    cible->nb += __atomic_load_n(&source->nb, __ATOMIC_RELAXED);
+    cible->totalNs += __atomic_load_n(&source->totalNs, __ATOMIC_RELAXED);
+    if (max > cible->maxNs) cible->maxNs = max;
+    for (int i = 0; i < NB_CASES_HISTOGRAMME; i++) {
+        cible->cases[i] += __atomic_load_n(&source->cases[i], __ATOMIC_RELAXED);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne la première durée d'une case d'histogramme
+ *
+ * \param[in] indice L'indice de la case, de 0 à NB_CASES_HISTOGRAMME
+ * \return La durée en nanosecondes
+ */
+long long debutCaseHistogramme(int indice){
+    int groupe = indice >> BITS_SOUS_CASES;
+    if (groupe == 0) return indice;
+    long long sousCase = indice & ((1 << BITS_SOUS_CASES) - 1);
+    return ((1LL << BITS_SOUS_CASES) + sousCase) << (groupe - 1);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne un centile d'un histogramme
+ *
+ * Le centile est la durée de rang ceil(centile * nb / 100) parmi les
+ * durées triées, arrondie à la fin de sa case.
+ *
+ * \param[in] histogramme L'histogramme
+ * \param[in] centile Le centile voulu, entre 0 et 100
+ * \return La durée en nanosecondes, 0 si l'histogramme est vide
+ */
+long long centileHistogramme(const HistogrammeLatences *histogramme, double centile){
+    long total = 0;
+    for (int i = 0; i < NB_CASES_HISTOGRAMME; i++) total += histogramme->cases[i];
+    if (total == 0) return 0;
+
+    double position = centile / 100.0 * total;
+    long rang = (long)position;
+    if (rang < position) rang++;
+    if (rang < 1) rang = 1;
+
+    long cumul = 0;
+    for (int i = 0; i < NB_CASES_HISTOGRAMME; i++) {
+        cumul += histogramme->cases[i];
+        if (cumul >= rang) {
+            long long fin = debutCaseHistogramme(i + 1) - 1;
+            return (fin < histogramme->maxNs) ? fin : histogramme->maxNs;
+        }
+    }
+    return histogramme->maxNs;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Écrit les histogrammes de tous les points de mesure au format texte
+ *
+ * Un bloc par point mesuré au moins une fois : une ligne d'en-tête, une
+ * ligne de centiles, une ligne "debut fin nombre" par case non vide et
+ * "fin".
+ *
+ * \param[in] fichier Le fichier où écrire
+ */
+void ecrireHistogrammes(FILE *fichier){
+    HistogrammeLatences histogramme;
+    for (int point = 0; point < NB_POINTS_MESURE; point++) {
+        lireHistogramme(point, &histogramme);
+        if (histogramme.nb == 0) continue;
+
+        fprintf(fichier, "histogramme %s nb=%ld total_ns=%lld max_ns=%lld\n", nomMesure(point), histogramme.nb,
+                histogramme.totalNs, histogramme.maxNs);
+        fprintf(fichier, "centiles p50=%lld p90=%lld p99=%lld p99.9=%lld max=%lld\n", centileHistogramme(&histogramme, 50),
+                centileHistogramme(&histogramme, 90), centileHistogramme(&histogramme, 99), centileHistogramme(&histogramme, 99.9),
+                histogramme.maxNs);
+        for (int i = 0; i < NB_CASES_HISTOGRAMME; i++) {
+            if (histogramme.cases[i] > 0) {
+                fprintf(fichier, "%lld %lld %ld\n", debutCaseHistogramme(i), debutCaseHistogramme(i + 1) - 1, histogramme.cases[i]);
+            }
+        }
+        fprintf(fichier, "fin\n");
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le nom d'un point de mesure
+ *
+ * \param[in] point Le point de mesure
+ * \return Son nom, tel qu'il est affiché
+ */
+const char *nomMesure(PointMesure point){
+    return nomsMesures[point];
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Affiche les compteurs de tous les points de mesure et de tous les sous-systèmes
+ *
+ * \param[in] fichier Le fichier où écrire (stdout, stderr...)
+ */
+void afficherMesures(FILE *fichier){
+#ifndef INSTRUMENTATION
+    fprintf(fichier, "Mesures désactivées à la compilation (make INSTRUMENTATION=1 pour les activer).\n");
+#else
+    HistogrammeLatences histogramme;
+    StatistiquesMemoire memoire;
+
+    fprintf(fichier, "%-18s %10s %12s %12s %10s %10s %10s %10s %10s\n", "mesure", "nombre", "total (ms)", "moyenne (us)",
+            "p50 (us)", "p90 (us)", "p99 (us)", "p99.9 (us)", "max (us)");
+    for (int i = 0; i < NB_POINTS_MESURE; i++) {
+        lireHistogramme(i, &histogramme);
+        fprintf(fichier, "%-18s %10ld %12.3f %12.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n", nomMesure(i), histogramme.nb,
+                histogramme.totalNs / 1e6, (histogramme.nb > 0) ? histogramme.totalNs / 1e3 / histogramme.nb : 0.0,
+                centileHistogramme(&histogramme, 50) / 1e3, centileHistogramme(&histogramme, 90) / 1e3,
+                centileHistogramme(&histogramme, 99) / 1e3, centileHistogramme(&histogramme, 99.9) / 1e3, histogramme.maxNs / 1e3);
+    }
+
+    fprintf(fichier, "\n%-18s %12s %12s %12s %14s %14s\n", "memoire", "allocations", "reallocs", "liberations", "vivants (o)", "pic (o)");
+    for (int i = 0; i < NB_SOUS_SYSTEMES; i++) {
+        lireMemoire(i, &memoire);
+        fprintf(fichier, "%-18s %12ld %12ld %12ld %14lld %14lld\n", nomSousSysteme(i), memoire.nbAllocations,
+                memoire.nbReallocations, memoire.nbLiberations, memoire.octetsVivants, memoire.picOctets);
+    }
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Écrit les mesures dans la destination donnée par la variable d'environnement \c SAE_MESURES
+ *
+ * "-" désigne la sortie d'erreur, toute autre valeur un fichier. Sans la
+ * variable, rien n'est écrit. Les histogrammes suivent le tableau des
+ * mesures.
+ */
+void ecrireMesuresSortie(void){
+    const char *destination = getenv("SAE_MESURES");
+    if (destination == NULL || destination[0] == '\0') return;
+
+    if (destination[0] == '-' && destination[1] == '\0') {
+        afficherMesures(stderr);
+        fprintf(stderr, "\n");
+        ecrireHistogrammes(stderr);
+        return;
+    }
+    FILE *fichier = fopen(destination, "w");
+    if (fichier == NULL) {
+        perror("Impossible d'écrire les mesures");
+        return;
+    }
+    afficherMesures(fichier);
+    fprintf(fichier, "\n");
+    ecrireHistogrammes(fichier);
+    fclose(fichier);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Remet à zéro les compteurs et les histogrammes de tous les points de mesure
+ *
+ * À appeler quand aucun autre fil ne mesure : une durée enregistrée
+ * pendant la remise à zéro peut survivre en partie.
+ *
+ * Pour la mémoire, seuls les nombres d'opérations repartent de zéro ; le
+ * pic repart des octets vivants, qui ne changent pas.
+ */
+void reinitialiserMesures(void){
+    pthread_mutex_lock(&verrouBlocs);
+    for (BlocMesures *bloc = blocs; bloc != NULL; bloc = bloc->suivant) {
+        for (int i = 0; i < NB_POINTS_MESURE; i++) {
+            HistogrammeLatences *histogramme = &bloc->points[i];
+            __atomic_store_n(&histogramme->nb, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&histogramme->totalNs, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&histogramme->maxNs, 0, __ATOMIC_RELAXED);
+            for (int j = 0; j < NB_CASES_HISTOGRAMME; j++) {
+                __atomic_store_n(&histogramme->cases[j], 0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    pthread_mutex_unlock(&verrouBlocs);
+    for (int i = 0; i < NB_SOUS_SYSTEMES; i++) {
+        __atomic_store_n(&memoires[i].nbAllocations, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&memoires[i].nbReallocations, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&memoires[i].nbLiberations, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&memoires[i].picOctets, __atomic_load_n(&memoires[i].octetsVivants, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+#ifdef INSTRUMENTATION
+/* Ajoute des octets aux octets vivants d'un sous-système et relève le pic */
+static void ajouterOctets(SousSysteme sousSysteme, long long octets){
+    StatistiquesMemoire *memoire = &memoires[sousSysteme];
+    long long vivants = __atomic_add_fetch(&memoire->octetsVivants, octets, __ATOMIC_RELAXED);
+    long long pic = __atomic_load_n(&memoire->picOctets, __ATOMIC_RELAXED);
+    while (vivants > pic && !__atomic_compare_exchange_n(&memoire->picOctets, &pic, vivants, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+#endif
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Alloue de la mémoire comptée pour un sous-système
+ *
+ * Comme malloc. Sans \c INSTRUMENTATION, rien n'est compté.
+ *
+ * \param[in] sousSysteme Le sous-système qui alloue
+ * \param[in] taille Le nombre d'octets
+ * \return La mémoire allouée, à rendre avec \c libererMemoire, ou NULL
+ */
+void *allouerMemoire(SousSysteme sousSysteme, size_t taille){
+    void *objet = malloc(taille);
+#ifdef INSTRUMENTATION
+    if (objet != NULL) {
+        __atomic_add_fetch(&memoires[sousSysteme].nbAllocations, 1, __ATOMIC_RELAXED);
+        ajouterOctets(sousSysteme, malloc_usable_size(objet));
+    }
+#endif
+    return objet;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Alloue de la mémoire mise à zéro, comptée pour un sous-système
+ *
+ * Comme calloc.
+ *
+ * \param[in] sousSysteme Le sous-système qui alloue
+ * \param[in] nb Le nombre d'éléments
+ * \param[in] taille La taille d'un élément
+ * \return La mémoire allouée, à rendre avec \c libererMemoire, ou NULL
+ */
+void *allouerMemoireZero(SousSysteme sousSysteme, size_t nb, size_t taille){
+    void *objet = calloc(nb, taille);
+#ifdef INSTRUMENTATION
+    if (objet != NULL) {
+        __atomic_add_fetch(&memoires[sousSysteme].nbAllocations, 1, __ATOMIC_RELAXED);
+        ajouterOctets(sousSysteme, malloc_usable_size(objet));
+    }
+#endif
+    return objet;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Change la taille d'une mémoire comptée pour un sous-système
+ *
+ * Comme realloc : NULL alloue une nouvelle mémoire.
+ *
+ * \param[in] sousSysteme Le sous-système qui a alloué la mémoire
+ * \param[in] objet La mémoire à agrandir ou réduire, ou NULL
+ * \param[in] taille La nouvelle taille
+ * \return La mémoire réallouée, ou NULL (l'ancienne reste alors valide)
+ */
+void *reallouerMemoire(SousSysteme sousSysteme, void *objet, size_t taille){
+#ifdef INSTRUMENTATION
+    long long ancienne = (objet != NULL) ? (long long)malloc_usable_size(objet) : 0;
+    void *nouvel = realloc(objet, taille);
+    if (nouvel != NULL) {
+        __atomic_add_fetch((objet != NULL) ? &memoires[sousSysteme].nbReallocations : &memoires[sousSysteme].nbAllocations, 1, __ATOMIC_RELAXED);
+        ajouterOctets(sousSysteme, (long long)malloc_usable_size(nouvel) - ancienne);
+    }
+    return nouvel;
+#else
+    return realloc(objet, taille);
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère une mémoire comptée pour un sous-système
+ *
+ * \param[in] sousSysteme Le sous-système qui a alloué la mémoire
+ * \param[in] objet La mémoire à libérer (NULL est ignoré)
+ */
+void libererMemoire(SousSysteme sousSysteme, void *objet){
+    if (objet == NULL) return;
+#ifdef INSTRUMENTATION
+    __atomic_add_fetch(&memoires[sousSysteme].nbLiberations, 1, __ATOMIC_RELAXED);
+    __atomic_sub_fetch(&memoires[sousSysteme].octetsVivants, (long long)malloc_usable_size(objet), __ATOMIC_RELAXED);
+#endif
+    free(objet);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compte un objet pris ou rendu ailleurs que par malloc (pools)
+ *
+ * \param[in] sousSysteme Le sous-système de l'objet
+ * \param[in] octets La taille de l'objet, positive s'il est pris, négative s'il est rendu
+ */
+void compterMemoire(SousSysteme sousSysteme, long octets){
+#ifdef INSTRUMENTATION
+    __atomic_add_fetch((octets >= 0) ? &memoires[sousSysteme].nbAllocations : &memoires[sousSysteme].nbLiberations, 1, __ATOMIC_RELAXED);
+    ajouterOctets(sousSysteme, octets);
+#else
+    (void)sousSysteme;
+    (void)octets;
+#endif
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Lit les compteurs de mémoire d'un sous-système
+ *
+ * \param[in] sousSysteme Le sous-système
+ * \param[out] stats Ses compteurs
+ */
+void lireMemoire(SousSysteme sousSysteme, StatistiquesMemoire *stats){
+    stats->nbAllocations = __atomic_load_n(&memoires[sousSysteme].nbAllocations, __ATOMIC_RELAXED);
+    stats->nbReallocations = __atomic_load_n(&memoires[sousSysteme].nbReallocations, __ATOMIC_RELAXED);
+    stats->nbLiberations = __atomic_load_n(&memoires[sousSysteme].nbLiberations, __ATOMIC_RELAXED);
+    stats->octetsVivants = __atomic_load_n(&memoires[sousSysteme].octetsVivants, __ATOMIC_RELAXED);
+    stats->picOctets = __atomic_load_n(&memoires[sousSysteme].picOctets, __ATOMIC_RELAXED);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le nom d'un sous-système
+ *
+ * \param[in] sousSysteme Le sous-système
+ * \return Son nom, tel qu'il est affiché
+ */
+const char *nomSousSysteme(SousSysteme sousSysteme){
+    return nomsSousSystemes[sousSysteme];
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Rend l'anneau d'un fil qui se termine, pour qu'un autre fil le reprenne */
+static void rendreAnneau(void *anneau){
+    pthread_mutex_lock(&verrouTrace);
+    ((AnneauTrace *)anneau)->suivantLibre = anneauxLibres;
+    anneauxLibres = (AnneauTrace *)anneau;
+    pthread_mutex_unlock(&verrouTrace);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Crée la clé qui rend l'anneau d'un fil à sa fin */
+static void creerCleAnneau(void){
+    pthread_key_create(&cleAnneau, rendreAnneau);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Numéro du fil courant dans la trace, donné à son premier événement */
+static int numeroFilCourant(void){
+    if (numeroFil == 0) {
+        numeroFil = __atomic_add_fetch(&nbFils, 1, __ATOMIC_RELAXED);
+    }
+    return numeroFil;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Donne un anneau au fil courant : un anneau rendu s'il y en a, sinon un nouveau */
+static AnneauTrace *prendreAnneau(void){
+    pthread_once(&cleCreee, creerCleAnneau);
+
+    pthread_mutex_lock(&verrouTrace);
+    AnneauTrace *anneau = anneauxLibres;
+    if (anneau != NULL) {
+        anneauxLibres = anneau->suivantLibre;
+    } else {
+        anneau = (AnneauTrace *)malloc(sizeof(AnneauTrace));
+        if (anneau == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        anneau->nbEcrits = 0;
+        anneau->suivant = anneaux;
+        anneaux = anneau;
+    }
+    pthread_mutex_unlock(&verrouTrace);
+
+    pthread_setspecific(cleAnneau, anneau);
+    return anneau;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Démarre l'enregistrement d'une trace
+ *
+ * Les événements sont gardés en mémoire, dans un anneau par fil
+ * d'exécution, et ne sont écrits qu'à la fin de la trace : la trace ne
+ * fausse pas les durées qu'elle mesure.
+ *
+ * \param[in] chemin Le fichier JSON à écrire à la fin, ou NULL pour ne rien tracer
+ */
+void demarrerTrace(const char *chemin){
+    if (chemin == NULL || chemin[0] == '\0' || traceActive) return;
+
+    cheminTrace = strdup(chemin);
+    if (cheminTrace == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    filPrincipal = numeroFilCourant();
+    origineTrace = horlogeMesure();
+    __atomic_store_n(&traceActive, 1, __ATOMIC_RELEASE);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Enregistre un événement dans l'anneau du fil courant
+ *
+ * Ne fait rien si aucune trace n'est en cours.
+ *
+ * \param[in] nom Le nom de l'événement, valide jusqu'à la fin de la trace
+ * \param[in] debut Le début de l'événement, donné par \c horlogeMesure
+ * \param[in] fin La fin de l'événement, donnée par \c horlogeMesure
+ */
+void tracerEvenement(const char *nom, long long debut, long long fin){
+    if (!__atomic_load_n(&traceActive, __ATOMIC_ACQUIRE)) return;
+
+    if (anneauFil == NULL) {
+        anneauFil = prendreAnneau();
+    }
+    EvenementTrace *evenement = &anneauFil->evenements[anneauFil->nbEcrits % TAILLE_ANNEAU_TRACE];
+    evenement->nom = nom;
+    evenement->debut = debut;
+    evenement->duree = fin - debut;
+    evenement->fil = numeroFilCourant();
+    anneauFil->nbEcrits++;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Termine la trace en cours et l'écrit au format Chrome trace-event
+ *
+ * Le fichier s'ouvre dans chrome://tracing ou ui.perfetto.dev. Les fils
+ * qui enregistrent encore doivent être arrêtés avant l'appel. Les anneaux
+ * sont vidés et gardés pour la trace suivante.
+ *
+ * \return Le nombre d'événements écrits, -1 si aucune trace n'était en cours
+ * ou si le fichier n'a pas pu être écrit
+ */
+long terminerTrace(void){
+    long nbEvenements = 0, nbEcrases = 0;
+
+    if (!traceActive) return -1;
+    __atomic_store_n(&traceActive, 0, __ATOMIC_RELEASE);
+
+    FILE *fichier = fopen(cheminTrace, "w");
+    if (fichier == NULL) {
+        perror("Impossible d'écrire la trace");
+        nbEvenements = -1;
+    } else {
+        // Un nom par fil, puis les événements encore dans les anneaux, en microsecondes depuis le début de la trace
+        fprintf(fichier, "{\"traceEvents\":[\n");
+        for (int fil = 1; fil <= nbFils; fil++) {
+            fprintf(fichier, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+                    (fil > 1) ? ",\n" : "", fil, (fil == filPrincipal) ? "principal" : "fil", fil);
+        }
+        pthread_mutex_lock(&verrouTrace);
+        for (AnneauTrace *anneau = anneaux; anneau != NULL; anneau = anneau->suivant) {
+            long premier = (anneau->nbEcrits > TAILLE_ANNEAU_TRACE) ? anneau->nbEcrits - TAILLE_ANNEAU_TRACE : 0;
+            for (long i = premier; i < anneau->nbEcrits; i++) {
+                EvenementTrace *evenement = &anneau->evenements[i % TAILLE_ANNEAU_TRACE];
+                fprintf(fichier, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                        evenement->nom, evenement->fil, (evenement->debut - origineTrace) / 1e3, evenement->duree / 1e3);
+            }
+            nbEvenements += anneau->nbEcrits - premier;
+            nbEcrases += premier;
+        }
+        pthread_mutex_unlock(&verrouTrace);
+        fprintf(fichier, "\n],\"displayTimeUnit\":\"ns\"}\n");
+        fclose(fichier);
+
+        if (nbEcrases > 0) {
+            fprintf(stderr, "Trace : %ld événement(s) parmi les plus anciens écrasé(s)\n", nbEcrases);
+        }
+    }
+
+    pthread_mutex_lock(&verrouTrace);
+    for (AnneauTrace *anneau = anneaux; anneau != NULL; anneau = anneau->suivant) {
+        anneau->nbEcrits = 0;
+    }
+    pthread_mutex_unlock(&verrouTrace);
+    free(cheminTrace);
+    cheminTrace = NULL;
+    return nbEvenements;
+}
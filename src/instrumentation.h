@@ -0,0 +1,424 @@
+/**
+ * \file instrumentation.h
+ * \brief En-tête pour le fichier instrumentation.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+    #include <stdio.h>
+    #include <stdlib.h>
+
+    /**
+     * \enum PointMesure
+     * \brief Chemins critiques mesurés.
+     */
+    typedef enum {
+        MESURE_CHARGEMENT = 0,   // Lecture d'un fichier des scores
+        MESURE_SAUVEGARDE,       // Écriture d'un fichier des scores
+        MESURE_TRI,              // Tri d'un tableau de chevaliers
+        MESURE_CLASSEMENT,       // Tri des entrées d'un classement
+        MESURE_RECHERCHE,        // Recherche d'un joueur (dichotomie, index des pseudos)
+        MESURE_VAGUES,           // Construction des vagues depuis un fichier de monstres
+        MESURE_MANCHE,           // Résolution d'une manche, choix du joueur exclu
+        MESURE_PARTIE,           // Partie complète, choix du joueur compris
+        MESURE_REQUETE_CLASSEMENT, // Affichage d'un classement demandé au menu (liste, page, préfixe)
+        MESURE_REQUETE_STATS,    // Statistiques d'un joueur ou rang d'un score demandés au menu
+        NB_POINTS_MESURE
+    } PointMesure;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct StatistiquesMesure
+     * \brief Compteurs d'un point de mesure.
+     */
+    typedef struct {
+        long nb;
+        long long totalNs;
+        long long maxNs;
+    } StatistiquesMesure;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def BITS_SOUS_CASES
+     * \brief Précision des histogrammes : chaque intervalle [2^k, 2^(k+1)[ est coupé en 2^BITS_SOUS_CASES cases égales.
+     *
+     * Avec 5 bits, une durée est connue à 1/32 près (3 %) quelle que soit
+     * son ordre de grandeur ; les durées de moins de 32 ns sont exactes.
+     */
+    #define BITS_SOUS_CASES 5
+
+    /**
+     * \def BITS_DUREE_MAX
+     * \brief Les durées de 2^BITS_DUREE_MAX ns (18 minutes) et plus sont comptées dans la dernière case.
+     */
+    #define BITS_DUREE_MAX 40
+
+    /**
+     * \def NB_CASES_HISTOGRAMME
+     * \brief Nombre de cases d'un histogramme de durées.
+     */
+    #define NB_CASES_HISTOGRAMME ((BITS_DUREE_MAX - BITS_SOUS_CASES + 1) << BITS_SOUS_CASES)
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct HistogrammeLatences
+     * \brief Histogramme log-linéaire des durées d'un point de mesure.
+     *
+     * Deux histogrammes se fusionnent en additionnant leurs cases : chaque
+     * fil remplit les siens sans partage, la lecture les fusionne.
+     */
+    typedef struct {
+        long nb;
+        long long totalNs;
+        long long maxNs;
+        long cases[NB_CASES_HISTOGRAMME];   // Voir debutCaseHistogramme pour les bornes
+    } HistogrammeLatences;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \enum SousSysteme
+     * \brief Parties du programme dont la mémoire est comptée séparément.
+     */
+    typedef enum {
+        MEMOIRE_REGISTRE = 0,    // Tableaux de chevaliers, classements publiés, registre partagé entre fils (fragments, vues)
+        MEMOIRE_SCORES,          // Historiques, maillons et blocs de scores
+        MEMOIRE_VAGUES,          // Monstres et maillons des vagues
+        MEMOIRE_NOMS,            // Chaînes internées et index des pseudos
+        MEMOIRE_TAMPONS,         // Tampons d'entrée-sortie (fichiers, chemins, affichage) et tampons temporaires des tris
+        NB_SOUS_SYSTEMES
+    } SousSysteme;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct StatistiquesMemoire
+     * \brief Compteurs de mémoire d'un sous-système.
+     *
+     * Les octets sont ceux réellement réservés par malloc, arrondi compris.
+     */
+    typedef struct {
+        long nbAllocations;
+        long nbReallocations;
+        long nbLiberations;
+        long long octetsVivants;
+        long long picOctets;
+    } StatistiquesMemoire;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def TAILLE_ANNEAU_TRACE
+     * \brief Nombre d'événements gardés par fil d'exécution pendant une trace.
+     *
+     * Au-delà, les événements les plus anciens du fil sont écrasés.
+     */
+    #define TAILLE_ANNEAU_TRACE 16384
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def DEBUT_MESURE
+     * \brief Démarre la mesure d'un point dans le bloc courant.
+     *
+     * Les macros de mesure ne font rien si le programme est compilé sans
+     * \c INSTRUMENTATION (make INSTRUMENTATION=0) : elles ne coûtent alors
+     * rien.
+     */
+
+    /**
+     * \def FIN_MESURE
+     * \brief Termine la mesure démarrée par \c DEBUT_MESURE dans le même bloc.
+     *
+     * Pendant une trace, la mesure devient aussi un événement de la trace.
+     */
+
+    /**
+     * \def DEBUT_TRACE
+     * \brief Démarre un événement de trace sans compteur, identifié par \c id dans le bloc courant.
+     */
+
+    /**
+     * \def FIN_TRACE
+     * \brief Termine l'événement \c id démarré par \c DEBUT_TRACE et lui donne son nom.
+     *
+     * Le nom doit rester valide jusqu'à la fin de la trace (chaîne littérale).
+     */
+    #ifdef INSTRUMENTATION
+        #define DEBUT_MESURE(point) long long debutMesure_##point = horlogeMesure()
+        #define FIN_MESURE(point) enregistrerMesure(point, debutMesure_##point, horlogeMesure())
+        #define DEBUT_TRACE(id) long long debutTrace_##id = horlogeMesure()
+        #define FIN_TRACE(id, nom) tracerEvenement(nom, debutTrace_##id, horlogeMesure())
+    #else
+        #define DEBUT_MESURE(point) ((void)0)
+        #define FIN_MESURE(point) ((void)0)
+        #define DEBUT_TRACE(id) ((void)0)
+        #define FIN_TRACE(id, nom) ((void)0)
+    #endif
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Lit l'horloge monotone
+     *
+     * \return Le temps en nanosecondes depuis une origine fixe
+     */
+    long long horlogeMesure(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Ajoute une durée aux compteurs et à l'histogramme d'un point de mesure
+     *
+     * Utilisable par plusieurs threads en même temps : chaque fil écrit dans
+     * ses propres compteurs, sans verrou ni opération atomique. Pendant une
+     * trace, la durée est aussi enregistrée comme événement.
+     *
+     * \param[in] point Le point de mesure
+     * \param[in] debut Le début de la mesure, donné par \c horlogeMesure
+     * \param[in] fin La fin de la mesure, donnée par \c horlogeMesure
+     */
+    void enregistrerMesure(PointMesure point, long long debut, long long fin);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Lit les compteurs d'un point de mesure
+     *
+     * \param[in] point Le point de mesure
+     * \param[out] stats Les compteurs du point, tous fils confondus
+     */
+    void lireMesure(PointMesure point, StatistiquesMesure *stats);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Lit l'histogramme d'un point de mesure
+     *
+     * \param[in] point Le point de mesure
+     * \param[out] histogramme L'histogramme du point, fusion de ceux de tous les fils
+     */
+    void lireHistogramme(PointMesure point, HistogrammeLatences *histogramme);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Ajoute un histogramme à un autre
+     *
+     * \param[in,out] cible L'histogramme qui reçoit les durées
+     * \param[in] source L'histogramme ajouté
+     */
+    void fusionnerHistogrammes(HistogrammeLatences *cible, const HistogrammeLatences *source);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne la première durée d'une case d'histogramme
+     *
+     * La case \c i compte les durées de \c debutCaseHistogramme(i) à
+     * \c debutCaseHistogramme(i + 1) - 1.
+     *
+     * \param[in] indice L'indice de la case, de 0 à NB_CASES_HISTOGRAMME
+     * \return La durée en nanosecondes
+     */
+    long long debutCaseHistogramme(int indice);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne un centile d'un histogramme
+     *
+     * \param[in] histogramme L'histogramme
+     * \param[in] centile Le centile voulu, entre 0 et 100 (99.9 par exemple)
+     * \return La plus grande durée de la case qui contient le centile, bornée
+     * par le maximum (à 3 % près), en nanosecondes ; 0 si l'histogramme est vide
+     */
+    long long centileHistogramme(const HistogrammeLatences *histogramme, double centile);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Écrit les histogrammes de tous les points de mesure au format texte
+     *
+     * Pour chaque point mesuré au moins une fois :
+     * \verbatim
+       histogramme <nom> nb=<n> total_ns=<t> max_ns=<m>
+       centiles p50=<ns> p90=<ns> p99=<ns> p99.9=<ns> max=<ns>
+       <debut_ns> <fin_ns> <nombre>     (une ligne par case non vide)
+       fin
+       \endverbatim
+     *
+     * \param[in] fichier Le fichier où écrire
+     */
+    void ecrireHistogrammes(FILE *fichier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le nom d'un point de mesure
+     *
+     * \param[in] point Le point de mesure
+     * \return Son nom, tel qu'il est affiché
+     */
+    const char *nomMesure(PointMesure point);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Affiche les compteurs et les centiles de tous les points de mesure et les compteurs de tous les sous-systèmes
+     *
+     * \param[in] fichier Le fichier où écrire (stdout, stderr...)
+     */
+    void afficherMesures(FILE *fichier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Écrit les mesures dans la destination donnée par la variable d'environnement \c SAE_MESURES
+     *
+     * "-" désigne la sortie d'erreur, toute autre valeur un fichier. Sans la
+     * variable, rien n'est écrit. Les histogrammes suivent le tableau des
+     * mesures, au format de \c ecrireHistogrammes.
+     */
+    void ecrireMesuresSortie(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Remet à zéro les compteurs et les histogrammes de tous les points de mesure
+     *
+     * À appeler quand aucun autre fil ne mesure : une durée enregistrée
+     * pendant la remise à zéro peut survivre en partie.
+     *
+     * Pour la mémoire, seuls les nombres d'opérations repartent de zéro ; le
+     * pic repart des octets vivants, qui ne changent pas.
+     */
+    void reinitialiserMesures(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Alloue de la mémoire comptée pour un sous-système
+     *
+     * Comme malloc. Sans \c INSTRUMENTATION, rien n'est compté.
+     *
+     * \param[in] sousSysteme Le sous-système qui alloue
+     * \param[in] taille Le nombre d'octets
+     * \return La mémoire allouée, à rendre avec \c libererMemoire, ou NULL
+     */
+    void *allouerMemoire(SousSysteme sousSysteme, size_t taille);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Alloue de la mémoire mise à zéro, comptée pour un sous-système
+     *
+     * Comme calloc.
+     *
+     * \param[in] sousSysteme Le sous-système qui alloue
+     * \param[in] nb Le nombre d'éléments
+     * \param[in] taille La taille d'un élément
+     * \return La mémoire allouée, à rendre avec \c libererMemoire, ou NULL
+     */
+    void *allouerMemoireZero(SousSysteme sousSysteme, size_t nb, size_t taille);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Change la taille d'une mémoire comptée pour un sous-système
+     *
+     * Comme realloc : NULL alloue une nouvelle mémoire.
+     *
+     * \param[in] sousSysteme Le sous-système qui a alloué la mémoire
+     * \param[in] objet La mémoire à agrandir ou réduire, ou NULL
+     * \param[in] taille La nouvelle taille
+     * \return La mémoire réallouée, ou NULL (l'ancienne reste alors valide)
+     */
+    void *reallouerMemoire(SousSysteme sousSysteme, void *objet, size_t taille);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère une mémoire comptée pour un sous-système
+     *
+     * \param[in] sousSysteme Le sous-système qui a alloué la mémoire
+     * \param[in] objet La mémoire à libérer (NULL est ignoré)
+     */
+    void libererMemoire(SousSysteme sousSysteme, void *objet);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compte un objet pris ou rendu ailleurs que par malloc (pools)
+     *
+     * \param[in] sousSysteme Le sous-système de l'objet
+     * \param[in] octets La taille de l'objet, positive s'il est pris, négative s'il est rendu
+     */
+    void compterMemoire(SousSysteme sousSysteme, long octets);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Lit les compteurs de mémoire d'un sous-système
+     *
+     * \param[in] sousSysteme Le sous-système
+     * \param[out] stats Ses compteurs
+     */
+    void lireMemoire(SousSysteme sousSysteme, StatistiquesMemoire *stats);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le nom d'un sous-système
+     *
+     * \param[in] sousSysteme Le sous-système
+     * \return Son nom, tel qu'il est affiché
+     */
+    const char *nomSousSysteme(SousSysteme sousSysteme);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Démarre l'enregistrement d'une trace
+     *
+     * Les événements sont gardés en mémoire, dans un anneau par fil
+     * d'exécution, et ne sont écrits qu'à la fin de la trace : la trace ne
+     * fausse pas les durées qu'elle mesure.
+     *
+     * \param[in] chemin Le fichier JSON à écrire à la fin, ou NULL pour ne rien tracer
+     */
+    void demarrerTrace(const char *chemin);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Enregistre un événement dans l'anneau du fil courant
+     *
+     * Ne fait rien si aucune trace n'est en cours.
+     *
+     * \param[in] nom Le nom de l'événement, valide jusqu'à la fin de la trace
+     * \param[in] debut Le début de l'événement, donné par \c horlogeMesure
+     * \param[in] fin La fin de l'événement, donnée par \c horlogeMesure
+     */
+    void tracerEvenement(const char *nom, long long debut, long long fin);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Termine la trace en cours et l'écrit au format Chrome trace-event
+     *
+     * Le fichier s'ouvre dans chrome://tracing ou ui.perfetto.dev. Les fils
+     * qui enregistrent encore doivent être arrêtés avant l'appel.
+     *
+     * \return Le nombre d'événements écrits, -1 si aucune trace n'était en cours
+     * ou si le fichier n'a pas pu être écrit
+     */
+    long terminerTrace(void);
+
+#endif
@@ -6,6 +6,7 @@
  */
 
 #include "jeu.h"
+#include "instrumentation.h"
 
 
 /**
@@ -19,7 +20,7 @@
  * \param[in] monstre La pile de monstres actuelle
  * \return Le score mis à jour en fonction des points gagnés
  */
-int calculPointsVague1(Chevalier *chevalier, int score, Monstre *monstre){
+int calculPointsVague1(Combattant *chevalier, int score, Monstre *monstre){
     return score += SCORE_VICTOIRE_V1 * monstre->niveau;
 }
 
@@ -33,14 +34,15 @@ int calculPointsVague1(Chevalier *chevalier, int score, Monstre *monstre){
  * \param[in] chevalier Le chevalier qui joue
  * \param[in] monstre La pile de monstres actuelle
  */
-void afficheintro(Chevalier *chevalier, Monstre *monstre){
+void afficheintro(Combattant *chevalier, Monstre *monstre){
     if (chevalier == NULL) {
         printf("Erreur : Chevalier introuvable.\n");
         return;
     }
+    if (chevalier->muet) return;
 
     printf("%sLe monstre %s(%dptV, %dAtt) accoure et se prépare à t'attaquer %s(%dptV, %dAtt)%s%s\n", 
-        BLEU,monstre->nom, monstre->pv, monstre->dmg, chevalier->pseudo, chevalier->pv, chevalier->dmg,BLEU, RESET);
+        BLEU,texteChaine(monstre->nom), monstre->pv, monstre->dmg, chevalier->pseudo, chevalier->pv, chevalier->dmg,BLEU, RESET);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -56,9 +58,10 @@ void afficheintro(Chevalier *chevalier, Monstre *monstre){
  * \param[in] score Le score actuel du chevalier
  * \param[in] monstre La pile de monstres actuelle
  */
-void afficheoutrovictoire(Chevalier *chevalier, int score, Monstre *monstre){
+void afficheoutrovictoire(Combattant *chevalier, int score, Monstre *monstre){
+    if (chevalier->muet) return;
     printf("%s%s(%dptV) gagne l'attaque contre %s(%dptV) + %dpts %s meurt sous le coup de l'attaque + %dpts %s%s\n",
-        VERT,chevalier->pseudo, chevalier->pv, monstre->nom, monstre->pv, SCORE_VICTOIRE_ATTAQUE, monstre->nom, SCORE_VICTOIRE_V1 * monstre->niveau,VERT,RESET);
+        VERT,chevalier->pseudo, chevalier->pv, texteChaine(monstre->nom), monstre->pv, SCORE_VICTOIRE_ATTAQUE, texteChaine(monstre->nom), SCORE_VICTOIRE_V1 * monstre->niveau,VERT,RESET);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -74,9 +77,10 @@ void afficheoutrovictoire(Chevalier *chevalier, int score, Monstre *monstre){
  * \param[in] score Le score actuel du chevalier
  * \param[in] monstre La pile de monstres actuelle
  */
-void afficheoutrodefaite(Chevalier *chevalier, int score, Monstre *monstre){
+void afficheoutrodefaite(Combattant *chevalier, int score, Monstre *monstre){
+    if (chevalier->muet) return;
     printf("%s%s(%dptV) perd l'attaque contre %s(%dptV) \nPERDU... nombre de pts acquis : %d %s%s\n",
-        ROUGE,chevalier->pseudo, chevalier->pv,monstre->nom, monstre->pv, score,ROUGE,RESET);
+        ROUGE,chevalier->pseudo, chevalier->pv,texteChaine(monstre->nom), monstre->pv, score,ROUGE,RESET);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -86,16 +90,20 @@ void afficheoutrodefaite(Chevalier *chevalier, int score, Monstre *monstre){
  * 
  * Fait choisir son arme au joueur en demandant une entrée de type char
  * parmi les options P, F et C. Fait une boucle jusqu'à ce que le joueur
- * fasse un choix correct.
+ * fasse un choix correct. À la fin de l'entrée, l'arme est tirée au hasard
+ * pour que la partie se termine.
  * 
  * \return Un entier représentant l'arme choisie : 0 pour Pierre, 1 pour Feuille, 2 pour Ciseaux
  */
-int choixArme(Chevalier *c) {
+int choixArme(Combattant *c) {
     char choix[2];  // Taille 2 pour pouvoir stocker le caractère + le '\0'
     
     while (1) {
         printf("%s (%dpts), choisis ton arme parmi P, F, C : ", c->pseudo, c->pv);
-        scanf("%s%*c", choix);  // Lecture de la chaîne de caractères
+        // Un seul caractère est gardé, le reste de la ligne est ignoré
+        if (scanf("%1s%*[^\n]", choix) == EOF) {
+            return rand() % 3;
+        }
 
         // Vérification de la validité du choix
         if (choix[0] == 'P' || choix[0] == 'F' || choix[0] == 'C') {
@@ -120,6 +128,38 @@ int choixArme(Chevalier *c) {
 
 
 
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Choisit une arme au hasard
+ *
+ * Fonction de choix d'arme d'un \c Combattant qui joue sans entrée.
+ *
+ * \param[in,out] etat La graine de rand_r (un unsigned int), avancée à chaque tirage
+ * \return Un entier représentant l'arme choisie : 0 pour Pierre, 1 pour Feuille, 2 pour Ciseaux
+ */
+int armeAleatoire(void *etat){
+    return rand_r((unsigned int *)etat) % 3;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Arme du combattant : choisie par sa fonction s'il en a une, sinon au clavier */
+static int choixArmeCombattant(Combattant *c){
+    return (c->choisirArme != NULL) ? c->choisirArme(c->etatArme) : choixArme(c);
+}
+
+/* Arme du monstre qui affronte le combattant : tirée avec la graine du combattant s'il en a une, puis montrée au combattant */
+static int choixArmeAdversaire(Combattant *c, Monstre *monstre){
+    int arme = (c->graineMonstres != NULL) ? tirerArmeMonstre(monstre, c->graineMonstres) : choixArmeMonstre(monstre);
+    if (c->observerArme != NULL) {
+        c->observerArme(c->etatArme, arme);
+    }
+    return arme;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
 char TradArme(int choix){
     switch (choix)
     {
@@ -195,16 +235,17 @@ Combat comparaison(int choixarmeM, int choixarmeJ){
  * \param[in] resultat Le résultat de l'attaque, qui peut être \c victoire,
  * \c defaite, ou \c egalite
  */
-void afficherResultatAttaque(Chevalier *chevalier, Monstre *monstre, Combat resultat) {
+void afficherResultatAttaque(Combattant *chevalier, Monstre *monstre, Combat resultat) {
+    if (chevalier->muet) return;
     if (resultat == victoire) {
         printf("%s%s(%dptV) gagne l'attaque contre %s(%dptV) + %dpts%s%s\n",
-               VERT,chevalier->pseudo, chevalier->pv, monstre->nom, monstre->pv, SCORE_VICTOIRE_ATTAQUE,VERT,RESET);
+               VERT,chevalier->pseudo, chevalier->pv, texteChaine(monstre->nom), monstre->pv, SCORE_VICTOIRE_ATTAQUE,VERT,RESET);
     } else if (resultat == defaite) {
         printf("%s%s(%dptV) perd l'attaque contre %s(%dptV)%s%s\n", 
-                ROUGE,chevalier->pseudo, chevalier->pv, monstre->nom, monstre->pv,ROUGE,RESET);
+                ROUGE,chevalier->pseudo, chevalier->pv, texteChaine(monstre->nom), monstre->pv,ROUGE,RESET);
     } else if (resultat == egalite){
         printf("%sAucun de %s(%dptV) et %s(%dptV) ne gagne l'attaque%s%s\n",
-               ORANGE,chevalier->pseudo, chevalier->pv, monstre->nom, monstre->pv,ORANGE,RESET);
+               ORANGE,chevalier->pseudo, chevalier->pv, texteChaine(monstre->nom), monstre->pv,ORANGE,RESET);
     } else {
         perror("Resultat inconnu");
         exit(EXIT_FAILURE);
@@ -236,20 +277,22 @@ void afficherResultatAttaque(Chevalier *chevalier, Monstre *monstre, Combat resu
  * joueur a gagné, \c defaite si le joueur a perdu, ou \c egalite si
  * les deux joueurs ont fait une égalité.
  */
-Combat vague1(Chevalier *chevalier, int *score, PileMonstre pmonstre){
+Combat vague1(Combattant *chevalier, int *score, PileMonstre pmonstre){
     int choixarmeJ;
     int choixarmeM;
     char choixJ, choixM;
     int result;
     while(pmonstre != NULL){
-        choixarmeJ = choixArme(chevalier);
-        choixarmeM = choixArmeMonstre(pmonstre->monstre);
+        choixarmeJ = choixArmeCombattant(chevalier);
+        // La manche est mesurée après le choix du joueur : l'attente du clavier n'est pas comptée
+        DEBUT_MESURE(MESURE_MANCHE);
+        choixarmeM = choixArmeAdversaire(chevalier, pmonstre->monstre);
         
-        choixJ = TradArme(choixarmeJ);
-        choixM = TradArme(choixarmeM);
-
-        
-        printf("%s (%c) attaque %s (%c)\n", chevalier->pseudo, choixJ, pmonstre->monstre->nom, choixM);
+        if (!chevalier->muet) {
+            choixJ = TradArme(choixarmeJ);
+            choixM = TradArme(choixarmeM);
+            printf("%s (%c) attaque %s (%c)\n", chevalier->pseudo, choixJ, texteChaine(pmonstre->monstre->nom), choixM);
+        }
 
         result = comparaison(choixarmeM, choixarmeJ);
 
@@ -257,7 +300,7 @@ Combat vague1(Chevalier *chevalier, int *score, PileMonstre pmonstre){
 
         if(result == victoire){
             pmonstre->monstre->pv -= chevalier->dmg;
-            score += SCORE_VICTOIRE_ATTAQUE;
+            *score += SCORE_VICTOIRE_ATTAQUE;
             if(pmonstre->monstre->pv > 0){
                 *score = calculPointsVague1(chevalier, *score, pmonstre->monstre);
                 afficheoutrovictoire(chevalier, *score, pmonstre->monstre);
@@ -271,10 +314,11 @@ Combat vague1(Chevalier *chevalier, int *score, PileMonstre pmonstre){
             if(chevalier->pv <= 0){
                 afficheoutrodefaite(chevalier, *score, pmonstre->monstre);
                 clearPile(pmonstre);
+                FIN_MESURE(MESURE_MANCHE);
                 return defaite;
             }
         }
-            
+        FIN_MESURE(MESURE_MANCHE);
     }
     return victoire;
     
@@ -295,28 +339,39 @@ Combat vague1(Chevalier *chevalier, int *score, PileMonstre pmonstre){
  * Si le chevalier perd, il perd des points de vie. Si tous les monstres sont vaincus,
  * la fonction retourne la victoire. Si le chevalier est vaincu, la fonction retourne
  * la défaite.
+ *
+ * La file est parcourue en boucle et libérée au fur et à mesure : à la fin de la
+ * vague, il ne reste rien à libérer.
  * 
  * \param[in,out] chevalier Le chevalier qui joue
  * \param[in,out] vague2 La file de monstres de la vague 2
  * \return Un type \c combat indiquant le résultat final : \c victoire si le joueur
  * a vaincu tous les monstres, ou \c defaite si le joueur a été vaincu.
  */
-Combat vague2(Chevalier *chevalier, int *score,FileMonstre vague2) {
+Combat vague2(Combattant *chevalier, int *score,FileMonstre vague2) {
     int resultat;
     int choixArmeJ = 0, choixArmeM = 0;
 
-    printf("Tous les monstres sont morts... \n");
-    printf("\n");
-    printf("Vous arrivez au bout du corridor, une plaine herbeuse apparaît. \n");
-    printf("Malheureusement des monstres sortent de partout pour tous vous attaquer en même temps ou presque...\n"); //contexte
+    if (!chevalier->muet) {
+        printf("Tous les monstres sont morts... \n");
+        printf("\n");
+        printf("Vous arrivez au bout du corridor, une plaine herbeuse apparaît. \n");
+        printf("Malheureusement des monstres sortent de partout pour tous vous attaquer en même temps ou presque...\n"); //contexte
+    }
+
+    // La file est refermée en anneau : les survivants reviennent jusqu'à la mort d'un des deux camps
+    if (vague2.queue != NULL) {
+        vague2.queue->suiv = vague2.tete;
+    }
 
     while (vague2.tete != NULL) {
         MaillonMonstre *monstreCourant = vague2.tete;
         
         afficheintro(chevalier, monstreCourant->monstre);
 
-        choixArmeJ = choixArme(chevalier);
-        choixArmeM = choixArmeMonstre(monstreCourant->monstre);
+        choixArmeJ = choixArmeCombattant(chevalier);
+        DEBUT_MESURE(MESURE_MANCHE);
+        choixArmeM = choixArmeAdversaire(chevalier, monstreCourant->monstre);
 
         resultat = comparaison(choixArmeM, choixArmeJ);
 
@@ -333,30 +388,34 @@ Combat vague2(Chevalier *chevalier, int *score,FileMonstre vague2) {
         afficherResultatAttaque(chevalier, monstreCourant->monstre, resultat);
 
         if (monstreCourant->monstre->pv <= 0) {
-            printf("%s meurt sous le coup de l'attaque + %dpts !\n", monstreCourant->monstre->nom, SCORE_VICTOIRE_ATTAQUE*monstreCourant->monstre->niveau);
+            if (!chevalier->muet) printf("%s meurt sous le coup de l'attaque + %dpts !\n", texteChaine(monstreCourant->monstre->nom), SCORE_VICTOIRE_ATTAQUE*monstreCourant->monstre->niveau);
 
             if (vague2.tete == vague2.queue) {
-                libererMonstre(vague2.tete->monstre);
                 vague2.tete = NULL;
                 vague2.queue = NULL;
             } else {
-                Monstre *tmp = vague2.tete->monstre;
                 vague2.tete = (vague2.tete)->suiv;
                 (vague2.queue)->suiv = vague2.tete;
-                libererMonstre(tmp);
             }
+            // Le maillon est libéré avec son monstre, plus rien ne pointe vers lui
+            monstreCourant->suiv = NULL;
+            libererVague2((FileMonstre){monstreCourant, monstreCourant});
         } else {
             vague2.queue = vague2.tete;
             vague2.tete = (vague2.tete)->suiv;
         }
+        FIN_MESURE(MESURE_MANCHE);
 
         if (chevalier->pv <= 0) {
             afficheoutrodefaite(chevalier, *score, monstreCourant->monstre);
+            // Les survivants sont libérés : l'anneau est rouvert avant
+            vague2.queue->suiv = NULL;
+            libererVague2(vague2);
             return defaite;
         }
     }
 
-    if (chevalier->pv > 0) {
+    if (chevalier->pv > 0 && !chevalier->muet) {
         printf("\nBravo %s, vous avez vaincu tous les monstres !\n", chevalier->pseudo);
     }
     return victoire;
@@ -370,28 +429,26 @@ Combat vague2(Chevalier *chevalier, int *score,FileMonstre vague2) {
  * \c vague1 et \c vague2. Si le joueur perd contre la vague 1, il perd
  * la partie et le programme s'arrête. Si le joueur gagne, il affiche
  * un message de victoire et le score.
+ *
+ * Les deux vagues sont libérées pendant la partie : elles ne doivent plus
+ * être utilisées ensuite.
  * 
  * \param[in,out] tableauJ Le tableau des joueurs
  * \param[in,out] joueur Le joueur qui joue
  * \param[in,out] v1Monstre La pile de monstres de la vague 1
  * \param[in,out] v2Monstre La file de monstres de la vague 2
  */
-int jouerPartie(Chevalier *joueur, PileMonstre v1Monstre, FileMonstre v2Monstre){
+int jouerPartie(Combattant *joueur, PileMonstre v1Monstre, FileMonstre v2Monstre){
     Combat result;
     int score=0;
+    DEBUT_MESURE(MESURE_PARTIE);
+    // Les vagues affichent elles-mêmes la fin de partie et libèrent leurs monstres
     result = vague1(joueur, &score, v1Monstre);
     if (result == defaite) {
-        afficheoutrodefaite(joueur, score, v1Monstre->monstre);
-        return score;
-    }
-
-    result = vague2(joueur, &score, v2Monstre);
-    if (result == victoire) {
-        afficheoutrovictoire(joueur, score, v2Monstre.tete->monstre);
-    }else{
-        afficheoutrodefaite(joueur, score, v2Monstre.tete->monstre);
-        return score;
+        libererVague2(v2Monstre);
+    } else {
+        vague2(joueur, &score, v2Monstre);
     }
-
+    FIN_MESURE(MESURE_PARTIE);
     return score;
 }
\ No newline at end of file
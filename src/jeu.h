@@ -77,7 +77,7 @@
      * \param[in] monstre La pile de monstres actuelle
      * \return Le score mis à jour en fonction des points gagnés
      */
-    int calculPointsVague1(Chevalier *chevalier, int score, Monstre *monstre);
+    int calculPointsVague1(Combattant *chevalier, int score, Monstre *monstre);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -89,7 +89,7 @@
      * \param[in] chevalier Le chevalier qui joue
      * \param[in] monstre La pile de monstres actuelle
      */
-    void afficheintro(Chevalier *chevalier, Monstre *monstre);
+    void afficheintro(Combattant *chevalier, Monstre *monstre);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -104,7 +104,7 @@
      * \param[in] score Le score actuel du chevalier
      * \param[in] monstre La pile de monstres actuelle
      */
-    void afficheoutrovictoire(Chevalier *chevalier, int score, Monstre *monstre);
+    void afficheoutrovictoire(Combattant *chevalier, int score, Monstre *monstre);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -119,7 +119,7 @@
      * \param[in] score Le score actuel du chevalier
      * \param[in] monstre La pile de monstres actuelle
      */
-    void afficheoutrodefaite(Chevalier *chevalier, int score, Monstre *monstre);
+    void afficheoutrodefaite(Combattant *chevalier, int score, Monstre *monstre);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -128,11 +128,25 @@
      * 
      * Fait choisir son arme au joueur en demandant une entrée de type char
      * parmi les options P, F et C. Fait une boucle jusqu'à ce que le joueur
-     * fasse un choix correct.
+     * fasse un choix correct. À la fin de l'entrée, l'arme est tirée au hasard
+     * pour que la partie se termine.
      * 
      * \return Un entier représentant l'arme choisie : 0 pour Pierre, 1 pour Feuille, 2 pour Ciseaux
      */
-    int choixArme(Chevalier *c);
+    int choixArme(Combattant *c);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Choisit une arme au hasard
+     *
+     * Fonction de choix d'arme d'un \c Combattant qui joue sans entrée :
+     * avec la même graine, le joueur choisit les mêmes armes.
+     *
+     * \param[in,out] etat La graine de rand_r (un unsigned int), avancée à chaque tirage
+     * \return Un entier représentant l'arme choisie : 0 pour Pierre, 1 pour Feuille, 2 pour Ciseaux
+     */
+    int armeAleatoire(void *etat);
 
     char TradArme(int choix);
 
@@ -173,7 +187,7 @@
      * \param[in] resultat Le résultat de l'attaque, qui peut être \c victoire,
      * \c defaite, ou \c egalite
      */
-    void afficherResultatAttaque(Chevalier *chevalier, Monstre *monstre, Combat resultat);
+    void afficherResultatAttaque(Combattant *chevalier, Monstre *monstre, Combat resultat);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -200,7 +214,7 @@
      * joueur a gagné, \c defaite si le joueur a perdu, ou \c egalite si
      * les deux joueurs ont fait une égalité.
      */
-    Combat vague1(Chevalier *chevalier, int *score, PileMonstre pmonstre);
+    Combat vague1(Combattant *chevalier, int *score, PileMonstre pmonstre);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -223,7 +237,7 @@
      * \return Un type \c combat indiquant le résultat final : \c victoire si le joueur
      * a vaincu tous les monstres, ou \c defaite si le joueur a été vaincu.
      */
-    Combat vague2(Chevalier *chevalier, int *score,FileMonstre vague2);
+    Combat vague2(Combattant *chevalier, int *score,FileMonstre vague2);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -240,7 +254,7 @@
      * \param[in,out] v1Monstre La pile de monstres de la vague 1
      * \param[in,out] v2Monstre La file de monstres de la vague 2
      */
-    int jouerPartie(Chevalier *joueur, PileMonstre v1Monstre, FileMonstre v2Monstre);
+    int jouerPartie(Combattant *joueur, PileMonstre v1Monstre, FileMonstre v2Monstre);
 
 
 #endif
\ No newline at end of file
@@ -7,6 +7,12 @@
 
 #include "menu.h"
 
+#ifdef INSTRUMENTATION
+/* Noms des actions du menu dans une trace, par numéro de choix */
+static const char *const nomsActions[] = {"choix incorrect", "partie predefinie", "partie personnalisee", "liste par nom",
+                                          "liste par score", "statistiques", "page du classement", "recherche par prefixe",
+                                          "rang d'un score", "quitter", "mesures"};
+#endif
 
 /**
  * \brief Affiche le menu principal
@@ -17,7 +23,11 @@
  * - 3. Afficher la liste des joueurs triée par nom
  * - 4. Afficher la liste des joueurs triée par meilleur score
  * - 5. Afficher les statistiques d'un joueur
+ * - 6. Afficher le classement page par page
+ * - 7. Rechercher des joueurs par début de pseudo
+ * - 8. Afficher le rang d'un score
  * - 9. Quitter
+ * - 10. Afficher les mesures de performance
  * 
  * \param[out] void
  */
@@ -28,104 +38,258 @@ printf("    2. Jouer une partie personnalisee\n");
 printf("    3. Afficher la liste des joueurs triée par nom\n"); 
 printf("    4. Afficher la liste des joueurs triée par meilleur score\n"); 
 printf("    5. Afficher les statistiques d'un joueur\n");
+printf("    6. Afficher le classement page par page\n");
+printf("    7. Rechercher des joueurs par début de pseudo\n");
+printf("    8. Afficher le rang d'un score\n");
 printf("    9. Quitter \n");
+printf("    10. Afficher les mesures de performance\n");
 printf("--------------------------------\n"); 
 printf("Votre choix : ");
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * \brief Enregistre le score d'une partie et sauvegarde le tableau
+ *
+ * Un joueur inconnu est ajouté au tableau et à l'index avec son premier score.
+ * Les scores du joueur sont ensuite recompressés.
+ *
+ * \param[in,out] tableau Le tableau de chevaliers
+ * \param[in,out] pseudos L'index des pseudos du tableau
+ * \param[in] pseudo Le pseudo du joueur qui vient de jouer
+ * \param[in] score Le score de la partie
+ */
+static void enregistrerPartie(TableauChevaliers *tableau, IndexPseudos *pseudos, const char *pseudo, int score){
+    int index = chercherPseudo(pseudos, pseudo);
+    if(index == -1){
+        Chevalier chevalier = creerChevalier(pseudo);
+        ajouterScore(&chevalier, score);
+        ajouterChevalier(tableau, chevalier);
+        indexerPseudo(pseudos, texteChaine(chevalier.pseudo), tableau->nbChevaliers - 1);
+    }else{
+        ajouterScore(&tableau->chevaliers[index], score);
+    }
+    sauvegarderTableauChevaliers(tableau);
+
+    // Le joueur redevient froid jusqu'à sa prochaine partie
+    compresserChevalier(&tableau->chevaliers[(index == -1) ? tableau->nbChevaliers - 1 : index]);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Commence une lecture du classement publié
+ *
+ * Le classement n'est reconstruit qu'à la première lecture qui suit une
+ * partie : plusieurs parties d'affilée ne coûtent aucun tri.
+ *
+ * \param[in,out] publication La publication du classement
+ * \param[in] lecteur Le numéro du lecteur inscrit
+ * \param[in] tableau Le tableau de chevaliers
+ * \param[in,out] perime true si une partie a été jouée depuis la dernière publication, remis à false
+ * \return Le classement à lire, jusqu'à l'appel de finLecture
+ */
+static const Classement *lireClassement(PublicationClassement *publication, int lecteur, TableauChevaliers *tableau, Bool *perime){
+    if (*perime) {
+        publierClassement(publication, construireClassement(tableau));
+        *perime = false;
+    }
+    return debutLecture(publication, lecteur);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Lit un entier ; une entrée qui n'est pas un entier est sautée jusqu'à la fin de la ligne */
+static Bool lireEntier(int *valeur){
+    int lu = scanf("%d", valeur);
+    if (lu == 0) scanf("%*[^\n]");
+    return lu == 1;
+}
+
+/* Lit un mot de 39 caractères au plus, la taille des tampons du menu */
+static Bool lireMot(char *mot){
+    return scanf("%39s", mot) == 1;
+}
+
+/* Crée le joueur d'une partie : au clavier sans graine, sinon avec des armes tirées de la graine */
+static Combattant creerJoueur(const char *pseudo, unsigned int *graineArmes){
+    Combattant joueur = creerCombattant(pseudo);
+    if (graineArmes != NULL) {
+        joueur.choisirArme = armeAleatoire;
+        joueur.etatArme = graineArmes;
+    }
+    return joueur;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
 /**
  * \brief Fonction principale qui execute le jeu
  *
  * Fonction qui contient la boucle principale du jeu. Elle affiche le menu,
  * lit le choix du joueur, et execute la fonction correspondante.
- * Si le joueur quitte, une sauvegarde du tableau de joueurs est effectuée.
+ * Si le joueur quitte, une sauvegarde du tableau de joueurs est effectuée
+ * et les mesures de performance sont écrites là où l'indique \c SAE_MESURES.
+ * Si \c SAE_TRACE donne un fichier, la session y est tracée (format Chrome
+ * trace-event), une action du menu par événement.
+ * Si \c SAE_ARMES donne une graine, les armes du joueur et des monstres en
+ * sont tirées : une session écrite d'avance se joue sans entrée pendant les
+ * parties et se rejoue à l'identique. La fin de l'entrée termine le jeu.
+ * Si \c SAE_METRIQUES donne une adresse ("unix:<chemin>" ou un port TCP
+ * local), les métriques du jeu y sont servies pendant toute la session.
  * 
  * \param[out] void
  */
 void global(void){
-    int choix=0, nbChevaliers=0, score=0, index;
+    int choix=0, nbChevaliers=0, score=0, index, nbParPage, page;
     char pseudo[40];
     char nomFichier[40];
-    Chevalier joueur;
+    Combattant joueur;
+    unsigned int graineArmes = 0;
+    Bool armesAleatoires = getenv("SAE_ARMES") != NULL;
 
-    // Variable de bon déroulement du jeu
-    int exist=0;
+    if (armesAleatoires) {
+        graineArmes = (unsigned int)strtoul(getenv("SAE_ARMES"), NULL, 10);
+        fixerGraineMonstres(graineArmes);
+    }
 
     // Création de la Pile de monstres
     PileMonstre v1Monstre=creerPile();
     // Création de la File de monstres
     FileMonstre v2Monstre=creerFileMonstre();
 
+    demarrerTrace(getenv("SAE_TRACE"));
+
     // Chargement du Tableau de chevaliers
     TableauChevaliers *tableau = chargerTableauChevaliers(&nbChevaliers);
+    compresserTableau(tableau);
+    // Index des pseudos : le tableau n'est plus réordonné pour chercher un joueur
+    IndexPseudos *pseudos = indexerTableau(tableau);
+    fixerNombreChevaliers(tableau->nbChevaliers);
+    demarrerMetriques(getenv("SAE_METRIQUES"));
+
+    // Classement figé lu par les options 3, 4 et 6, reconstruit à la première lecture après une partie
+    PublicationClassement publication;
+    const Classement *classement;
+    Bool classementPerime = true;
+    initialiserPublication(&publication);
+    int lecteur = inscrireLecteur(&publication);
     
 
     do{
         afficherMenu();
-        scanf("%d", &choix);
+        if (!lireEntier(&choix)) {
+            choix = feof(stdin) ? 9 : 0;
+        }
+        DEBUT_TRACE(action);
         switch(choix){
             case 1:
                 printf ("Entrez le nom du fichier correspondant à la partie :  ");
-                scanf("%s", nomFichier);
+                if (!lireMot(nomFichier)) break;
                 lireMonstres(nomFichier, &v1Monstre, &v2Monstre);
                 printf("Entrez votre pseudo de chevalier (40 caractère max) : ");
-                scanf("%s", pseudo);
-                joueur = creerChevalier(pseudo);
+                if (!lireMot(pseudo)) break;
+                joueur = creerJoueur(pseudo, armesAleatoires ? &graineArmes : NULL);
                 score = jouerPartie(&joueur, v1Monstre, v2Monstre);
-                exist = chevalierExiste(tableau, &joueur);
-                if(exist == 0){
-                    ajouterChevalier(tableau, joueur);
-                    sauvegarderTableauChevaliers(tableau);
-                }else{
-                    triBulleTableauChevaliers(tableau);
-                    index = rechDichotomiqueJoueur(tableau, joueur.pseudo, &exist);
-                    ajouterScore(tableau[index].chevaliers, score);
-                    sauvegarderTableauChevaliers(tableau);
-                }
+                v1Monstre = creerPile();
+                v2Monstre = creerFileMonstre();
+                enregistrerPartie(tableau, pseudos, joueur.pseudo, score);
+                classementPerime = true;
+                compterPartie(nomFichier, joueur.pv > 0);
+                fixerNombreChevaliers(tableau->nbChevaliers);
                 break;
 
             case 2:
                 printf("Entrez votre pseudo de chevalier (40 caractère max) : ");
-                scanf("%s", pseudo);
-                joueur = creerChevalier(pseudo);
+                if (!lireMot(pseudo)) break;
+                joueur = creerJoueur(pseudo, armesAleatoires ? &graineArmes : NULL);
                 ajouterMonstresPersonnalise(&v1Monstre, &v2Monstre);
                 score = jouerPartie(&joueur, v1Monstre, v2Monstre);
-                exist = chevalierExiste(tableau, &joueur);
-                if(exist == 0){
-                    ajouterChevalier(tableau, joueur);
-                    sauvegarderTableauChevaliers(tableau);
-                }else{
-                    triBulleTableauChevaliers(tableau);
-                    index = rechDichotomiqueJoueur(tableau, joueur.pseudo, &exist);
-                    ajouterScore(tableau[index].chevaliers, score);
-                    sauvegarderTableauChevaliers(tableau);
-                }
+                v1Monstre = creerPile();
+                v2Monstre = creerFileMonstre();
+                enregistrerPartie(tableau, pseudos, joueur.pseudo, score);
+                classementPerime = true;
+                compterPartie("personnalisee", joueur.pv > 0);
+                fixerNombreChevaliers(tableau->nbChevaliers);
                 break;
 
-            case 3:
-                triBulleTableauChevaliers(tableau);
-                afficherTableauChevaliers(*tableau);
+            // Les requêtes sont mesurées une fois leurs paramètres saisis
+            case 3: {
+                DEBUT_MESURE(MESURE_REQUETE_CLASSEMENT);
+                classement = lireClassement(&publication, lecteur, tableau, &classementPerime);
+                afficherClassementScores(classement, false, tableau);
+                finLecture(&publication, lecteur);
+                FIN_MESURE(MESURE_REQUETE_CLASSEMENT);
                 break;
+            }
 
-            case 4:
-                triRapideChevaliers(tableau->chevaliers, 0, tableau->nbChevaliers - 1);
-                afficherTableauChevaliers(*tableau); 
+            case 4: {
+                DEBUT_MESURE(MESURE_REQUETE_CLASSEMENT);
+                classement = lireClassement(&publication, lecteur, tableau, &classementPerime);
+                afficherClassementScores(classement, true, tableau);
+                finLecture(&publication, lecteur);
+                FIN_MESURE(MESURE_REQUETE_CLASSEMENT);
                 break;
+            }
 
-            case 5:
+            case 5: {
                 printf("Entrez votre pseudo de chevalier (40 caractère max) : ");
-                scanf("%s", pseudo);
-                triBulleTableauChevaliers(tableau);
-                index = rechDichotomiqueJoueur(tableau, pseudo, &exist);
-                if(exist == 0){
+                if (!lireMot(pseudo)) break;
+                DEBUT_MESURE(MESURE_REQUETE_STATS);
+                index = chercherPseudo(pseudos, pseudo);
+                if(index == -1){
                     printf("Le joueur n'existe pas\n");
-                }else if (exist == 1) {
-                    afficherStatistiques(tableau[index].chevaliers);
+                }else{
+                    afficherStatistiques(&tableau->chevaliers[index]);
+                    afficherRangChevalier(&tableau->chevaliers[index]);
                 }
+                FIN_MESURE(MESURE_REQUETE_STATS);
                 break;
+            }
             
+            case 6: {
+                printf("Nombre de joueurs par page : ");
+                if (!lireEntier(&nbParPage)) break;
+                printf("Numéro de la page (à partir de 1) : ");
+                if (!lireEntier(&page)) break;
+                DEBUT_MESURE(MESURE_REQUETE_CLASSEMENT);
+                classement = lireClassement(&publication, lecteur, tableau, &classementPerime);
+                afficherPageClassement(classement, true, nbParPage, page - 1);
+                finLecture(&publication, lecteur);
+                FIN_MESURE(MESURE_REQUETE_CLASSEMENT);
+                break;
+            }
+
+            case 7: {
+                printf("Entrez le début du pseudo : ");
+                if (!lireMot(pseudo)) break;
+                printf("Nombre de joueurs par page : ");
+                if (!lireEntier(&nbParPage)) break;
+                printf("Numéro de la page (à partir de 1) : ");
+                if (!lireEntier(&page)) break;
+                DEBUT_MESURE(MESURE_REQUETE_CLASSEMENT);
+                afficherRecherchePrefixe(pseudos, tableau, pseudo, nbParPage, page - 1);
+                FIN_MESURE(MESURE_REQUETE_CLASSEMENT);
+                break;
+            }
+
+            case 8: {
+                printf("Entrez un score : ");
+                if (!lireEntier(&score)) break;
+                DEBUT_MESURE(MESURE_REQUETE_STATS);
+                printf("Rang du score %d : %d sur %d scores (%d score(s) supérieur(s) ou égal(aux))\n",
+                       score, rangScore(score), nombreScores(), compterScoresSuperieurs(score));
+                printf("Médiane : %d - 90e centile : %d - 99e centile : %d\n\n", scoreCentile(50), scoreCentile(90), scoreCentile(99));
+                FIN_MESURE(MESURE_REQUETE_STATS);
+                break;
+            }
+
+            case 10:
+                afficherMesures(stdout);
+                printf("\n");
+                break;
+
             default:
                 if(choix != 9){
                     printf("Choix incorrect, veuillez recommencer\n");
@@ -133,5 +297,13 @@ void global(void){
                 printf("Au revoir...\n");
                 break;
         }
-    }while(choix != 9);
+        FIN_TRACE(action, nomsActions[(choix >= 1 && choix <= 10) ? choix : 0]);
+    }while(choix != 9 && !feof(stdin));
+
+    arreterMetriques();
+    desinscrireLecteur(&publication, lecteur);
+    libererPublication(&publication);
+    libererIndexPseudos(pseudos);
+    ecrireMesuresSortie();
+    terminerTrace();
 }
\ No newline at end of file
@@ -9,6 +9,10 @@
 #define MENU_H
 
     #include "jeu.h"
+    #include "classement.h"
+    #include "recherche.h"
+    #include "instrumentation.h"
+    #include "metriques.h"
 
     /**
      * \brief Affiche le menu principal
@@ -19,7 +23,11 @@
      * - 3. Afficher la liste des joueurs triée par nom
      * - 4. Afficher la liste des joueurs triée par meilleur score
      * - 5. Afficher les statistiques d'un joueur
+     * - 6. Afficher le classement page par page
+     * - 7. Rechercher des joueurs par début de pseudo
+     * - 8. Afficher le rang d'un score
      * - 9. Quitter
+     * - 10. Afficher les mesures de performance
      * 
      * \param[out] void
      */
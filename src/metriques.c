@@ -0,0 +1,348 @@
+/**
+ * \file metriques.c
+ * \brief Métriques du jeu servies au format texte de Prometheus par un fil dédié
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "metriques.h"
+
+#include <pthread.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+/**
+ * \def PREMIER_EXPOSANT_METRIQUES
+ * \brief Borne de la première classe des histogrammes exportés : 2^10 ns (1 µs).
+ *
+ * Les bornes suivantes sont multipliées par 4 jusqu'à 2^34 ns (17 s) : ce
+ * sont des débuts de cases des histogrammes de durées, les comptes sont
+ * donc exacts.
+ */
+#define PREMIER_EXPOSANT_METRIQUES 10
+
+/**
+ * \def DERNIER_EXPOSANT_METRIQUES
+ * \brief Borne de la dernière classe finie des histogrammes exportés : 2^34 ns.
+ */
+#define DERNIER_EXPOSANT_METRIQUES 34
+
+/* Parties d'un fichier de monstres : le nom est écrit une fois, avant que la case soit marquée prête */
+typedef struct {
+    int etat;                 // 0 : libre, 1 : nom en cours d'écriture, 2 : prête
+    char fichier[40];
+    long victoires;
+    long defaites;
+} PartiesFichier;
+
+/* Compteurs lus par le fil des métriques sans verrou, écrits par des opérations atomiques */
+static long nbParties = 0;
+static long nbChevaliersMetriques = 0;
+static PartiesFichier partiesFichiers[NB_FICHIERS_METRIQUES];
+static PartiesFichier partiesAutres = {2, "autres", 0, 0};
+
+/* Fil qui sert les métriques et son adresse */
+static int serveurActif = 0;
+static int socketEcoute = -1;
+static pthread_t filMetriques;
+static char cheminSocket[sizeof(((struct sockaddr_un *)0)->sun_path)] = "";
+
+/* Donne la case d'un fichier de monstres, prise à sa première partie */
+static PartiesFichier *casePartiesFichier(const char *fichier){
+    for (int i = 0; i < NB_FICHIERS_METRIQUES; i++) {
+        PartiesFichier *parties = &partiesFichiers[i];
+        int etat = __atomic_load_n(&parties->etat, __ATOMIC_ACQUIRE);
+        if (etat == 2 && strncmp(parties->fichier, fichier, sizeof(parties->fichier) - 1) == 0) return parties;
+
+        int libre = 0;
+        if (etat == 0 && __atomic_compare_exchange_n(&parties->etat, &libre, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            snprintf(parties->fichier, sizeof(parties->fichier), "%s", fichier);
+            __atomic_store_n(&parties->etat, 2, __ATOMIC_RELEASE);
+            return parties;
+        }
+    }
+    return &partiesAutres;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compte une partie terminée
+ *
+ * \param[in] fichier Le fichier de monstres de la partie
+ * \param[in] victoire true si le joueur a vaincu les deux vagues
+ */
+void compterPartie(const char *fichier, Bool victoire){
+    PartiesFichier *parties = casePartiesFichier(fichier);
+    __atomic_add_fetch(victoire ? &parties->victoires : &parties->defaites, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&nbParties, 1, __ATOMIC_RELAXED);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le nombre de chevaliers du tableau des scores
+ *
+ * \param[in] nbChevaliers Le nombre de chevaliers
+ */
+void fixerNombreChevaliers(long nbChevaliers){
+    __atomic_store_n(&nbChevaliersMetriques, nbChevaliers, __ATOMIC_RELAXED);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Écrit une valeur d'étiquette entre guillemets, avec les échappements du format */
+static void ecrireEtiquette(FILE *fichier, const char *valeur){
+    fputc('"', fichier);
+    for (const char *c = valeur; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') fputc('\\', fichier);
+        if (*c == '\n') {
+            fputs("\\n", fichier);
+        } else {
+            fputc(*c, fichier);
+        }
+    }
+    fputc('"', fichier);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Écrit les parties d'un fichier de monstres, une ligne par résultat */
+static void ecrirePartiesFichier(FILE *fichier, PartiesFichier *parties){
+    fprintf(fichier, "sae_parties_fichier_total{fichier=");
+    ecrireEtiquette(fichier, parties->fichier);
+    fprintf(fichier, ",resultat=\"victoire\"} %ld\n", __atomic_load_n(&parties->victoires, __ATOMIC_RELAXED));
+    fprintf(fichier, "sae_parties_fichier_total{fichier=");
+    ecrireEtiquette(fichier, parties->fichier);
+    fprintf(fichier, ",resultat=\"defaite\"} %ld\n", __atomic_load_n(&parties->defaites, __ATOMIC_RELAXED));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Écrit l'histogramme d'un point de mesure, en secondes, aux bornes 2^10, 2^12... 2^34 ns */
+static void ecrireHistogrammeMetriques(FILE *fichier, PointMesure point){
+    HistogrammeLatences histogramme;
+    lireHistogramme(point, &histogramme);
+
+    long cumul = 0;
+    int indice = 0;
+    for (int exposant = PREMIER_EXPOSANT_METRIQUES; exposant <= DERNIER_EXPOSANT_METRIQUES; exposant += 2) {
+        long long borne = 1LL << exposant;
+        while (indice < NB_CASES_HISTOGRAMME && debutCaseHistogramme(indice + 1) <= borne) {
+            cumul += histogramme.cases[indice++];
+        }
+        fprintf(fichier, "sae_duree_secondes_bucket{mesure=\"%s\",le=\"%.9g\"} %ld\n", nomMesure(point), borne / 1e9, cumul);
+    }
+    fprintf(fichier, "sae_duree_secondes_bucket{mesure=\"%s\",le=\"+Inf\"} %ld\n", nomMesure(point), histogramme.nb);
+    fprintf(fichier, "sae_duree_secondes_sum{mesure=\"%s\"} %.9f\n", nomMesure(point), histogramme.totalNs / 1e9);
+    fprintf(fichier, "sae_duree_secondes_count{mesure=\"%s\"} %ld\n", nomMesure(point), histogramme.nb);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Écrit toutes les métriques au format texte de Prometheus
+ *
+ * Les compteurs sont lus par des lectures atomiques : les fils qui jouent
+ * ou mesurent ne sont jamais bloqués (la liste des histogrammes n'est
+ * verrouillée par un fil qu'à sa première mesure).
+ *
+ * \param[in] fichier Le fichier où écrire
+ */
+void ecrireMetriques(FILE *fichier){
+    StatistiquesMemoire memoire;
+
+    fprintf(fichier, "# HELP sae_parties_total Parties jouées depuis le lancement.\n");
+    fprintf(fichier, "# TYPE sae_parties_total counter\n");
+    fprintf(fichier, "sae_parties_total %ld\n", __atomic_load_n(&nbParties, __ATOMIC_RELAXED));
+
+    fprintf(fichier, "# HELP sae_parties_fichier_total Parties jouées par fichier de monstres et par résultat.\n");
+    fprintf(fichier, "# TYPE sae_parties_fichier_total counter\n");
+    for (int i = 0; i < NB_FICHIERS_METRIQUES; i++) {
+        if (__atomic_load_n(&partiesFichiers[i].etat, __ATOMIC_ACQUIRE) == 2) {
+            ecrirePartiesFichier(fichier, &partiesFichiers[i]);
+        }
+    }
+    if (__atomic_load_n(&partiesAutres.victoires, __ATOMIC_RELAXED) + __atomic_load_n(&partiesAutres.defaites, __ATOMIC_RELAXED) > 0) {
+        ecrirePartiesFichier(fichier, &partiesAutres);
+    }
+
+    fprintf(fichier, "# HELP sae_chevaliers Chevaliers du tableau des scores.\n");
+    fprintf(fichier, "# TYPE sae_chevaliers gauge\n");
+    fprintf(fichier, "sae_chevaliers %ld\n", __atomic_load_n(&nbChevaliersMetriques, __ATOMIC_RELAXED));
+
+    fprintf(fichier, "# HELP sae_scores Scores en mémoire.\n");
+    fprintf(fichier, "# TYPE sae_scores gauge\n");
+    fprintf(fichier, "sae_scores %d\n", nombreScores());
+
+    fprintf(fichier, "# HELP sae_maillons_scores Maillons de scores en mémoire (chevaliers chauds).\n");
+    fprintf(fichier, "# TYPE sae_maillons_scores gauge\n");
+    fprintf(fichier, "sae_maillons_scores %ld\n", nombreMaillonsScores());
+
+    fprintf(fichier, "# HELP sae_memoire_octets Octets vivants par sous-système.\n");
+    fprintf(fichier, "# TYPE sae_memoire_octets gauge\n");
+    for (int i = 0; i < NB_SOUS_SYSTEMES; i++) {
+        lireMemoire(i, &memoire);
+        fprintf(fichier, "sae_memoire_octets{sous_systeme=\"%s\"} %lld\n", nomSousSysteme(i), memoire.octetsVivants);
+    }
+
+    fprintf(fichier, "# HELP sae_memoire_pic_octets Pic des octets vivants par sous-système.\n");
+    fprintf(fichier, "# TYPE sae_memoire_pic_octets gauge\n");
+    for (int i = 0; i < NB_SOUS_SYSTEMES; i++) {
+        lireMemoire(i, &memoire);
+        fprintf(fichier, "sae_memoire_pic_octets{sous_systeme=\"%s\"} %lld\n", nomSousSysteme(i), memoire.picOctets);
+    }
+
+    fprintf(fichier, "# HELP sae_duree_secondes Durées des points de mesure (chargement, sauvegarde, requêtes, parties...).\n");
+    fprintf(fichier, "# TYPE sae_duree_secondes histogram\n");
+    for (int i = 0; i < NB_POINTS_MESURE; i++) {
+        ecrireHistogrammeMetriques(fichier, i);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Écrit tout un tampon sur une connexion, même en plusieurs fois */
+static void envoyerTout(int connexion, const char *tampon, size_t taille){
+    while (taille > 0) {
+        ssize_t envoyes = send(connexion, tampon, taille, MSG_NOSIGNAL);
+        if (envoyes <= 0) return;
+        tampon += envoyes;
+        taille -= envoyes;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Répond à une connexion : la requête est lue puis ignorée, la réponse contient toujours toutes les métriques */
+static void repondre(int connexion){
+    char requete[4096];
+    struct timeval attente = {1, 0};
+    setsockopt(connexion, SOL_SOCKET, SO_RCVTIMEO, &attente, sizeof(attente));
+    if (recv(connexion, requete, sizeof(requete), 0) < 0) return;
+
+    char *corps = NULL;
+    size_t taille = 0;
+    FILE *fichier = open_memstream(&corps, &taille);
+    if (fichier == NULL) return;
+    ecrireMetriques(fichier);
+    fclose(fichier);
+
+    char entete[160];
+    int tailleEntete = snprintf(entete, sizeof(entete), "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                "Content-Length: %zu\r\nConnection: close\r\n\r\n", taille);
+    envoyerTout(connexion, entete, tailleEntete);
+    envoyerTout(connexion, corps, taille);
+    free(corps);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Boucle du fil des métriques : une connexion à la fois, jusqu'à la fermeture du socket d'écoute */
+static void *servirMetriques(void *arg){
+    while (__atomic_load_n(&serveurActif, __ATOMIC_ACQUIRE)) {
+        int connexion = accept(socketEcoute, NULL, NULL);
+        if (connexion == -1) continue;
+        repondre(connexion);
+        close(connexion);
+    }
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Ouvre le socket d'écoute d'une adresse "unix:<chemin>" ou d'un port TCP local ; -1 en cas d'erreur */
+static int ouvrirEcoute(const char *adresse){
+    int ecoute;
+    if (strncmp(adresse, "unix:", 5) == 0) {
+        struct sockaddr_un unixAdresse;
+        memset(&unixAdresse, 0, sizeof(unixAdresse));
+        unixAdresse.sun_family = AF_UNIX;
+        if (strlen(adresse + 5) >= sizeof(unixAdresse.sun_path)) {
+            fprintf(stderr, "Chemin du socket des métriques trop long : %s\n", adresse + 5);
+            return -1;
+        }
+        strcpy(unixAdresse.sun_path, adresse + 5);
+        ecoute = socket(AF_UNIX, SOCK_STREAM, 0);
+        unlink(unixAdresse.sun_path);
+        if (ecoute == -1 || bind(ecoute, (struct sockaddr *)&unixAdresse, sizeof(unixAdresse)) == -1) {
+            perror("Impossible d'ouvrir le socket des métriques");
+            if (ecoute != -1) close(ecoute);
+            return -1;
+        }
+        strcpy(cheminSocket, unixAdresse.sun_path);
+    } else {
+        char *fin;
+        long port = strtol(adresse, &fin, 10);
+        if (*fin != '\0' || port <= 0 || port > 65535) {
+            fprintf(stderr, "Adresse des métriques incorrecte : %s (unix:<chemin> ou port TCP)\n", adresse);
+            return -1;
+        }
+        struct sockaddr_in tcpAdresse;
+        memset(&tcpAdresse, 0, sizeof(tcpAdresse));
+        tcpAdresse.sin_family = AF_INET;
+        tcpAdresse.sin_port = htons((unsigned short)port);
+        tcpAdresse.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        int reutiliser = 1;
+        ecoute = socket(AF_INET, SOCK_STREAM, 0);
+        if (ecoute != -1) setsockopt(ecoute, SOL_SOCKET, SO_REUSEADDR, &reutiliser, sizeof(reutiliser));
+        if (ecoute == -1 || bind(ecoute, (struct sockaddr *)&tcpAdresse, sizeof(tcpAdresse)) == -1) {
+            perror("Impossible d'ouvrir le port des métriques");
+            if (ecoute != -1) close(ecoute);
+            return -1;
+        }
+    }
+    if (listen(ecoute, 16) == -1) {
+        perror("Impossible d'écouter l'adresse des métriques");
+        close(ecoute);
+        return -1;
+    }
+    return ecoute;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Démarre le fil qui sert les métriques
+ *
+ * \param[in] adresse "unix:<chemin>", un port TCP sur 127.0.0.1, ou NULL
+ * \return 0 si le fil est démarré ou si rien n'était demandé, -1 sinon
+ */
+int demarrerMetriques(const char *adresse){
+    if (adresse == NULL || adresse[0] == '\0' || serveurActif) return 0;
+
+    socketEcoute = ouvrirEcoute(adresse);
+    if (socketEcoute == -1) return -1;
+    __atomic_store_n(&serveurActif, 1, __ATOMIC_RELEASE);
+    if (pthread_create(&filMetriques, NULL, servirMetriques, NULL) != 0) {
+        perror("Impossible de démarrer le fil des métriques");
+        __atomic_store_n(&serveurActif, 0, __ATOMIC_RELEASE);
+        close(socketEcoute);
+        socketEcoute = -1;
+        return -1;
+    }
+    return 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Arrête le fil des métriques et ferme son adresse
+ *
+ * Le socket d'écoute est coupé pour débloquer le fil, qui est attendu.
+ */
+void arreterMetriques(void){
+    if (!serveurActif) return;
+
+    __atomic_store_n(&serveurActif, 0, __ATOMIC_RELEASE);
+    shutdown(socketEcoute, SHUT_RDWR);
+    pthread_join(filMetriques, NULL);
+    close(socketEcoute);
+    socketEcoute = -1;
+    if (cheminSocket[0] != '\0') {
+        unlink(cheminSocket);
+        cheminSocket[0] = '\0';
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * \file metriques.h
+ * \brief En-tête pour le fichier metriques.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef METRIQUES_H
+#define METRIQUES_H
+
+    #include "chevalier.h"
+    #include "instrumentation.h"
+
+    /**
+     * \def NB_FICHIERS_METRIQUES
+     * \brief Nombre de fichiers de monstres dont les parties sont comptées séparément.
+     *
+     * Au-delà, les parties des nouveaux fichiers sont comptées ensemble
+     * sous le nom "autres".
+     */
+    #define NB_FICHIERS_METRIQUES 64
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Démarre le fil qui sert les métriques
+     *
+     * Le fil répond à chaque connexion par une réponse HTTP qui contient les
+     * métriques au format texte de Prometheus (voir \c ecrireMetriques) :
+     * \c curl \c http://127.0.0.1:9100/metrics ou
+     * \c curl \c --unix-socket \c /tmp/sae.sock \c http://sae/metrics.
+     *
+     * \param[in] adresse "unix:<chemin>" pour un socket Unix, sinon un port TCP
+     * écouté sur 127.0.0.1 seulement ; NULL pour ne rien démarrer
+     * \return 0 si le fil est démarré ou si rien n'était demandé, -1 si
+     * l'adresse ne peut pas être écoutée (le jeu continue sans métriques)
+     */
+    int demarrerMetriques(const char *adresse);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Arrête le fil des métriques et ferme son adresse
+     *
+     * Ne fait rien si le fil n'est pas démarré.
+     */
+    void arreterMetriques(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compte une partie terminée
+     *
+     * \param[in] fichier Le fichier de monstres de la partie ("personnalisee" pour une partie personnalisée)
+     * \param[in] victoire true si le joueur a vaincu les deux vagues
+     */
+    void compterPartie(const char *fichier, Bool victoire);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le nombre de chevaliers du tableau des scores
+     *
+     * \param[in] nbChevaliers Le nombre de chevaliers
+     */
+    void fixerNombreChevaliers(long nbChevaliers);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Écrit toutes les métriques au format texte de Prometheus
+     *
+     * Parties jouées (en tout, et par fichier de monstres et résultat),
+     * chevaliers, scores et maillons de scores en mémoire, octets vivants
+     * par sous-système et histogramme des durées de chaque point de mesure.
+     * Les octets et les durées restent à zéro sans \c INSTRUMENTATION.
+     *
+     * \param[in] fichier Le fichier où écrire
+     */
+    void ecrireMetriques(FILE *fichier);
+
+#endif
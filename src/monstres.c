@@ -5,11 +5,31 @@
  * \date 02/01/2025
  */
 #include "monstres.h"
+#include "chevalier.h"
+#include "pool.h"
+#include "instrumentation.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+static Monstre *creerMonstreNomme(IdChaine nom, int niveau);
+
+/* Vrai dès que la graine des armes des monstres est fixée, voir fixerGraineMonstres */
+static int graineFixee = 0;
+
+/* Prend un maillon de monstre dans le pool, compté dans la mémoire des vagues */
+static MaillonMonstre *prendreMaillonMonstre(void){
+    compterMemoire(MEMOIRE_VAGUES, sizeof(MaillonMonstre));
+    return (MaillonMonstre *)allouerDansPool(sizeof(MaillonMonstre));
+}
+
+/* Rend un maillon de monstre au pool */
+static void rendreMaillonMonstre(MaillonMonstre *maillon){
+    compterMemoire(MEMOIRE_VAGUES, -(long)sizeof(MaillonMonstre));
+    libererDansPool(maillon, sizeof(MaillonMonstre));
+}
+
 
 //Partie Pile
 
@@ -28,10 +48,11 @@ PileMonstre creerPile(void){
  * \brief Ajoute un maillon à la pile de monstres
  *
  * Alloue dynamiquement un nouveau maillon contenant un monstre et 
- * l'ajoute au sommet de la pile existante.
+ * l'ajoute au sommet de la pile existante. La pile garde le monstre
+ * lui-même, sans copie : il est libéré quand il quitte la pile.
  *
  * \param[in] p La pile de monstres existante
- * \param[in] x Le maillon monstre à ajouter à la pile
+ * \param[in] x Le monstre à ajouter à la pile
  * \return Un pointeur vers le nouveau sommet de la pile
  *
  * \note Si l'allocation dynamique échoue, le programme termine avec un message d'erreur.
@@ -39,15 +60,9 @@ PileMonstre creerPile(void){
 PileMonstre pushPile(PileMonstre p, Monstre *x){
     MaillonMonstre *m;
 
-	m = malloc(sizeof(*m));
+	m = prendreMaillonMonstre();
 
-	if(m == NULL)
-	{
-		fprintf(stderr, "Probleme allocation dynamique.\n");
-		exit(1);
-	}
-
-	m->monstre = creerMonstre(x->nom, x->niveau);
+	m->monstre = x;
 	m->suiv = p;
 
 
@@ -59,8 +74,8 @@ PileMonstre pushPile(PileMonstre p, Monstre *x){
 /**
  * \brief Supprime le maillon au sommet de la pile de monstres
  *
- * Supprime le maillon au sommet de la pile de monstres et renvoie le maillon
- * qui suit.
+ * Supprime le maillon au sommet de la pile de monstres, avec son monstre,
+ * et renvoie le maillon qui suit.
  *
  * \param[in] p La pile de monstres existante
  * \return Un pointeur vers le maillon qui suit le maillon supprimé
@@ -73,7 +88,8 @@ PileMonstre popPile(PileMonstre p){
 		return NULL;
 
 	m = p->suiv;
-	free(p);
+	libererMonstre(p->monstre);
+	rendreMaillonMonstre(p);
 
 	return m;
 }
@@ -130,11 +146,7 @@ FileMonstre creerFileMonstre(void){
  */
 FileMonstre enfilerMonstre(FileMonstre f, Monstre *x){
     MaillonMonstre *m;
-    m = malloc(sizeof(*m));
-    if (m == NULL) {
-        perror("Erreur d'allocation mémoire");
-        exit(EXIT_FAILURE);
-    }
+    m = prendreMaillonMonstre();
     m->monstre = x;
     m->suiv = NULL;
     if (f.tete == NULL) {
@@ -153,7 +165,7 @@ FileMonstre enfilerMonstre(FileMonstre f, Monstre *x){
 /**
  * \brief Défile un monstre dans une file de monstres
  *
- * Défile le premier monstre de la file de monstres \c f.
+ * Défile le premier monstre de la file de monstres \c f et le libère.
  *
  * \param[in] f La file de monstres
  * \return La file de monstres modifiée
@@ -166,7 +178,8 @@ FileMonstre defilerMonstre(FileMonstre f){
     }
     m = f.tete;
     f.tete = f.tete->suiv;
-    free(m);
+    libererMonstre(m->monstre);
+    rendreMaillonMonstre(m);
     return f;
 }
 
@@ -195,6 +208,7 @@ FileMonstre clearFileMonstre(FileMonstre f){
  * \brief Crée un monstre
  *
  * Crée un monstre en fonction de son nom et de son niveau.
+ * Le nom est interné : il n'est pas copié pour chaque monstre.
  *
  * Si le niveau est incorrect, la fonction renvoie \c NULL.
  * La fonction utilise des valeurs par défaut pour les attributs du monstre
@@ -217,13 +231,20 @@ FileMonstre clearFileMonstre(FileMonstre f){
  * \return Un pointeur vers le monstre créé
  *
  */
-Monstre *creerMonstre(char *nom, int niveau) {
-    Monstre *monstre = malloc(sizeof(Monstre));
+Monstre *creerMonstre(const char *nom, int niveau) {
+    return creerMonstreNomme(internerChaine(nom), niveau);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Crée un monstre dont le nom est déjà interné (copie d'un monstre existant) */
+static Monstre *creerMonstreNomme(IdChaine nom, int niveau) {
+    Monstre *monstre = allouerMemoire(MEMOIRE_VAGUES, sizeof(Monstre));
     if (monstre == NULL) {
         perror("Erreur du malloc\n");
         exit(1);
     }
-    monstre->nom = strdup(nom);
+    monstre->nom = nom;
     monstre->niveau = niveau;
 
     switch (niveau) {
@@ -244,7 +265,7 @@ Monstre *creerMonstre(char *nom, int niveau) {
             break;
         default:
             printf("Niveau %d incorrect, veuillez choisir un niveau entre 1 et 3\n", niveau);
-            free(monstre);
+            libererMemoire(MEMOIRE_VAGUES, monstre);
             return NULL;
     }
     return monstre;
@@ -272,11 +293,16 @@ void ajouterMonstresPersonnalise(PileMonstre *vague1, FileMonstre *vague2) {
     char choix, *nom = NULL;
     int niveau, vague;
 
-    MaillonMonstre m;
+    Monstre *monstre;
 
     while (1) {
         printf("\nEntrez la vague (1 ou 2, 0 pour quitter) : ");
-        scanf("%d", &vague);
+        if (scanf("%d", &vague) != 1) {
+            // À la fin de l'entrée, les vagues restent telles quelles ; une entrée incorrecte est sautée
+            if (feof(stdin)) break;
+            scanf("%*[^\n]");
+            vague = -1;
+        }
 
         if (vague == 0) break;
         if (vague != 1 && vague != 2) {
@@ -291,7 +317,7 @@ void ajouterMonstresPersonnalise(PileMonstre *vague1, FileMonstre *vague2) {
         printf("- D. Petite Pustule\n");
         printf("- E. Dragonus\n");
         printf("Choix : ");
-        scanf(" %c", &choix);
+        if (scanf(" %c", &choix) != 1) break;
 
         switch (choix) {
             case 'A': case 'a':
@@ -315,19 +341,23 @@ void ajouterMonstresPersonnalise(PileMonstre *vague1, FileMonstre *vague2) {
         }
 
         printf("Entrez le niveau (1-3) : ");
-        scanf("%d", &niveau);
+        if (scanf("%d", &niveau) != 1) {
+            if (feof(stdin)) break;
+            scanf("%*[^\n]");
+            niveau = 0;
+        }
 
         if (niveau < 1 || niveau > 3) {
             printf("Niveau invalide. Réessayez.\n");
             continue;
         }
 
-        m.monstre = creerMonstre(nom, niveau);
-        if (m.monstre != NULL) {
+        monstre = creerMonstre(nom, niveau);
+        if (monstre != NULL) {
             if (vague == 1){
-                *vague1 = pushPile(*vague1, m.monstre); 
+                *vague1 = pushPile(*vague1, monstre);
             } else if (vague == 2) {
-                *vague2 = enfilerMonstre(*vague2, m.monstre);
+                *vague2 = enfilerMonstre(*vague2, monstre);
             }
             printf("%s (Niveau %d) ajouté à la Vague %d.\n", nom, niveau, vague);
         } else {
@@ -351,15 +381,32 @@ void ajouterMonstresPersonnalise(PileMonstre *vague1, FileMonstre *vague2) {
  * - Pour chaque monstre, une ligne contenant le nom du monstre
  *   suivi de son niveau.
  *
- * \param[in] nomFichier Le nom du fichier à lire
+ * \param[in] nomFichier Le nom du fichier à lire, dans le dossier des données (voir \c cheminDonnees)
  * \param[in,out] vague1 La pile de monstres pour la vague 1
  * \param[in,out] vague2 La file de monstres pour la vague 2
  *
  */
 void lireMonstres(char *nomFichier, PileMonstre *vague1, FileMonstre *vague2) {
-    char tmpFichier[] = "src/fichier/";
-    strcat(tmpFichier, nomFichier);
-    FILE *fichier = fopen(tmpFichier, "r");
+    char *chemin = cheminDonnees(nomFichier);
+    lireMonstresFichier(chemin, vague1, vague2);
+    libererMemoire(MEMOIRE_TAMPONS, chemin);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Lit les monstres depuis un fichier donné par son chemin
+ *
+ * Même format que \c lireMonstres.
+ *
+ * \param[in] chemin Le chemin du fichier à lire
+ * \param[in,out] vague1 La pile de monstres pour la vague 1
+ * \param[in,out] vague2 La file de monstres pour la vague 2
+ * \note Si le fichier ne peut pas être ouvert, le programme termine avec un message d'erreur.
+ */
+void lireMonstresFichier(const char *chemin, PileMonstre *vague1, FileMonstre *vague2) {
+    DEBUT_MESURE(MESURE_VAGUES);
+    FILE *fichier = fopen(chemin, "r");
     if (fichier == NULL) {
         perror("Erreur lors de l'ouverture du fichier");
         exit(1);
@@ -382,27 +429,103 @@ void lireMonstres(char *nomFichier, PileMonstre *vague1, FileMonstre *vague2) {
         }
 
         if (fscanf(fichier, "%d", &niveau) == 1) {
-            MaillonMonstre *m = malloc(sizeof(*m));
-            if (m == NULL) {
-                perror("Erreur d'allocation mémoire");
-                exit(1);
-            }
-            m->monstre = creerMonstre(nom, niveau);
+            // Les vagues gardent le monstre créé : ni maillon ni copie en plus
+            Monstre *monstre = creerMonstre(nom, niveau);
+            if (monstre == NULL) continue;
 
             if (contexteActuel == 1) {
-                *vague1 = pushPile(*vague1, m->monstre);
+                *vague1 = pushPile(*vague1, monstre);
                 printf("%s (Niveau %d) ajouté à la Vague 1.\n", nom, niveau);
             } else if (contexteActuel == 2) {
-                *vague2 = enfilerMonstre(*vague2, m->monstre);
+                *vague2 = enfilerMonstre(*vague2, monstre);
                 printf("%s (Niveau %d) ajouté à la Vague 2.\n", nom, niveau);
+            } else {
+                libererMonstre(monstre);
             }
         }
     }
 
     fclose(fichier);
-    printf("Lecture des monstres depuis le fichier '%s' terminée.\n", nomFichier);
+    FIN_MESURE(MESURE_VAGUES);
+    printf("Lecture des monstres depuis le fichier '%s' terminée.\n", chemin);
+}
+
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Copie la vague 1 avec des monstres neufs
+ *
+ * Les monstres de la copie ont les mêmes noms et niveaux, dans le même
+ * ordre, et tous leurs points de vie : une vague lue une fois peut être
+ * rejouée autant de fois que voulu sans relire son fichier.
+ *
+ * \param[in] vague1 La pile à copier (elle n'est pas modifiée)
+ * \return La copie, à libérer avec \c libererVague1 ou en jouant la partie
+ */
+PileMonstre copierVague1(PileMonstre vague1){
+    // Les maillons sont ajoutés par le bas pour garder l'ordre de la pile
+    PileMonstre copie = creerPile();
+    MaillonMonstre **fin = &copie;
+    for (MaillonMonstre *maillon = vague1; maillon != NULL; maillon = maillon->suiv) {
+        MaillonMonstre *nouveau = prendreMaillonMonstre();
+        nouveau->monstre = creerMonstreNomme(maillon->monstre->nom, maillon->monstre->niveau);
+        nouveau->suiv = NULL;
+        *fin = nouveau;
+        fin = &nouveau->suiv;
+    }
+    return copie;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Copie la vague 2 avec des monstres neufs
+ *
+ * Comme \c copierVague1, dans l'ordre de la file.
+ *
+ * \param[in] vague2 La file à copier (elle n'est pas modifiée)
+ * \return La copie, à libérer avec \c libererVague2 ou en jouant la partie
+ */
+FileMonstre copierVague2(FileMonstre vague2){
+    FileMonstre copie = creerFileMonstre();
+    for (MaillonMonstre *maillon = vague2.tete; maillon != NULL; maillon = maillon->suiv) {
+        copie = enfilerMonstre(copie, creerMonstreNomme(maillon->monstre->nom, maillon->monstre->niveau));
+    }
+    return copie;
 }
 
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Fixe la graine des armes des monstres
+ *
+ * Sans appel, la graine est tirée de l'heure au premier choix d'arme.
+ *
+ * \param[in] graine La graine donnée à srand
+ */
+void fixerGraineMonstres(unsigned int graine){
+    srand(graine);
+    graineFixee = 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Nombre d'armes entre lesquelles un monstre tire selon son niveau (4, 3 ou 5) */
+static int nombreArmesTirees(Monstre *monstre){
+    switch (monstre->niveau)
+    {
+    case 1:
+        return 4;
+    case 2:
+        return 3;
+    case 3:
+        return 5;
+    default:
+        printf("Le niveau du monstre est incorrect\n");
+        exit(EXIT_FAILURE);
+    }
+}
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -423,33 +546,28 @@ void lireMonstres(char *nomFichier, PileMonstre *vague1, FileMonstre *vague2) {
  * affiche un message d'erreur et termine le programme.
  */
 int choixArmeMonstre(Monstre *monstre){
-    srand(time(NULL)); // Utilise l'heure actuelle comme graine pour la fonction rand
-    int random_number;
-    switch (monstre->niveau)
-    {
-    case 1:
-        // Génération d'un nombre aléatoire entre 0 et 3
-        random_number = rand() % 4;
-        break;
+    // La graine n'est fixée qu'une fois : la refixer à chaque manche rejouait le même tirage pendant une seconde
+    if (!graineFixee) {
+        srand(time(NULL)); // Utilise l'heure actuelle comme graine pour la fonction rand
+        graineFixee = 1;
+    }
+    return rand() % nombreArmesTirees(monstre);
+}
 
-    case 2:
-        // Génération d'un nombre aléatoire entre 0 et 3
-        random_number = rand() % 3;
-        break;
+/*---------------------------------------------------------------------------------------------------------------------------------*/
 
-    case 3:
-        // Génération d'un nombre aléatoire entre 0 et 3
-        random_number = rand() % 5;
-        break;
-    
-    default:
-        if (monstre->niveau > 3 || monstre->niveau < 1){
-            printf("Le niveau du monstre est incorrect\n");
-            exit(EXIT_FAILURE);
-        }
-        break;
-    }
-    return random_number;
+/**
+ * \brief Sélectionne aléatoirement une arme pour un monstre à partir d'une graine
+ *
+ * Mêmes armes possibles que \c choixArmeMonstre, mais tirées avec rand_r :
+ * plusieurs parties peuvent être jouées en même temps, chacune avec sa graine.
+ *
+ * \param[in] monstre Un pointeur vers le monstre pour lequel choisir une arme
+ * \param[in,out] graine La graine de rand_r, avancée à chaque tirage
+ * \return Un entier représentant le choix d'arme aléatoire
+ */
+int tirerArmeMonstre(Monstre *monstre, unsigned int *graine){
+    return rand_r(graine) % nombreArmesTirees(monstre);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -466,7 +584,7 @@ int choixArmeMonstre(Monstre *monstre){
 void afficherMonstre(Monstre *monstre) {
     if (monstre == NULL)
         return;
-    printf("Monstre : %s (Niveau %d)\n", monstre->nom, monstre->niveau);
+    printf("Monstre : %s (Niveau %d)\n", texteChaine(monstre->nom), monstre->niveau);
     printf("- Points de Vie : %d\n", monstre->pv);
     printf("- Points de Dégât : %d\n", monstre->dmg);
     printf("- Nombre d'armes : %d\n", monstre->nbArmes);
@@ -546,8 +664,7 @@ void afficherVague2(FileMonstre vague2) {
  */
 void libererMonstre(Monstre *monstre) {
     if (monstre != NULL) {
-        free(monstre->nom); 
-        free(monstre);
+        libererMemoire(MEMOIRE_VAGUES, monstre);
     } else {
         printf("Erreur de free.\n");
     }
@@ -572,7 +689,7 @@ void libererVague1(PileMonstre vague1) {
         if (current->monstre != NULL) {
             libererMonstre(current->monstre); 
         }
-        free(current); 
+        rendreMaillonMonstre(current);
         current = suivant; 
     }
 }
@@ -596,7 +713,7 @@ void libererVague2(FileMonstre vague2) {
         if (current->monstre != NULL) {
             libererMonstre(current->monstre);
         }
-        free(current);
+        rendreMaillonMonstre(current);
         current = suivant;
     }
 }
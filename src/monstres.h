@@ -9,6 +9,7 @@
 #define MONSTRES_H
 
     #include <time.h>
+    #include "chaines.h"
     #define VIVANT 0
     #define MORT 1
 
@@ -17,14 +18,14 @@
     * \brief Représente un monstre avec ses caractéristiques.
     *
     * La structure `Monstre` contient :
-    * - son nom,
+    * - son nom (interné : tous les monstres du même nom le partagent),
     * - ses points de vie (PV),
     * - ses dégâts,
     * - le nombre d'armes qu'il possède,
     * - son niveau.
     */
     typedef struct Monstre {
-        char *nom;
+        IdChaine nom;   // Texte lu avec texteChaine
         int pv;
         int dmg;
         int nbArmes;
@@ -173,6 +174,7 @@
      * \brief Crée un monstre
      *
      * Crée un monstre en fonction de son nom et de son niveau.
+     * Le nom est interné : il n'est pas copié pour chaque monstre.
      *
      * Si le niveau est incorrect, la fonction renvoie \c NULL.
      * La fonction utilise des valeurs par défaut pour les attributs du monstre
@@ -195,7 +197,7 @@
      * \return Un pointeur vers le monstre créé
      *
      */
-    Monstre *creerMonstre(char *nom, int niveau);
+    Monstre *creerMonstre(const char *nom, int niveau);
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
@@ -232,7 +234,7 @@
      * - Pour chaque monstre, une ligne contenant le nom du monstre
      *   suivi de son niveau.
      *
-     * \param[in] nomFichier Le nom du fichier à lire
+     * \param[in] nomFichier Le nom du fichier à lire, dans le dossier des données (voir \c cheminDonnees)
      * \param[in,out] vague1 La pile de monstres pour la vague 1
      * \param[in,out] vague2 La file de monstres pour la vague 2
      *
@@ -241,6 +243,59 @@
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \brief Lit les monstres depuis un fichier donné par son chemin
+     *
+     * Même format que \c lireMonstres.
+     *
+     * \param[in] chemin Le chemin du fichier à lire
+     * \param[in,out] vague1 La pile de monstres pour la vague 1
+     * \param[in,out] vague2 La file de monstres pour la vague 2
+     * \note Si le fichier ne peut pas être ouvert, le programme termine avec un message d'erreur.
+     */
+    void lireMonstresFichier(const char *chemin, PileMonstre *vague1, FileMonstre *vague2);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Fixe la graine des armes des monstres
+     *
+     * Avec la même graine, les monstres choisissent les mêmes armes : une
+     * partie jouée sans entrée se rejoue à l'identique. Sans appel, la graine
+     * est tirée de l'heure au premier choix d'arme.
+     *
+     * \param[in] graine La graine donnée à srand
+     */
+    void fixerGraineMonstres(unsigned int graine);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Copie la vague 1 avec des monstres neufs
+     *
+     * Les monstres de la copie ont les mêmes noms et niveaux, dans le même
+     * ordre, et tous leurs points de vie : une vague lue une fois peut être
+     * rejouée autant de fois que voulu sans relire son fichier.
+     *
+     * \param[in] vague1 La pile à copier (elle n'est pas modifiée)
+     * \return La copie, à libérer avec \c libererVague1 ou en jouant la partie
+     */
+    PileMonstre copierVague1(PileMonstre vague1);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Copie la vague 2 avec des monstres neufs
+     *
+     * Comme \c copierVague1, dans l'ordre de la file.
+     *
+     * \param[in] vague2 La file à copier (elle n'est pas modifiée)
+     * \return La copie, à libérer avec \c libererVague2 ou en jouant la partie
+     */
+    FileMonstre copierVague2(FileMonstre vague2);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \brief Sélectionne aléatoirement une arme pour un monstre
      *
@@ -261,6 +316,20 @@
 
     /*---------------------------------------------------------------------------------------------------------------------------------*/
 
+    /**
+     * \brief Sélectionne aléatoirement une arme pour un monstre à partir d'une graine
+     *
+     * Mêmes armes possibles que \c choixArmeMonstre, mais tirées avec rand_r :
+     * plusieurs parties peuvent être jouées en même temps, chacune avec sa graine.
+     *
+     * \param[in] monstre Un pointeur vers le monstre pour lequel choisir une arme
+     * \param[in,out] graine La graine de rand_r, avancée à chaque tirage
+     * \return Un entier représentant le choix d'arme aléatoire
+     */
+    int tirerArmeMonstre(Monstre *monstre, unsigned int *graine);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
     /**
      * \brief Affiche les informations d'un monstre
      * 
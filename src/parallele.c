@@ -0,0 +1,608 @@
+/**
+ * \file parallele.c
+ * \brief Pool de fils d'exécution, tri et statistiques en parallèle
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "parallele.h"
+#include "instrumentation.h"
+
+#include <unistd.h>
+
+/* Boucle d'un fil du pool : prend la tâche en tête de file et l'exécute */
+static void *executerFil(void *argument){
+    PoolThreads *pool = (PoolThreads *)argument;
+
+    pthread_mutex_lock(&pool->verrou);
+    while (1) {
+        while (pool->tete == NULL && !pool->arret) {
+            pthread_cond_wait(&pool->nouvelleTache, &pool->verrou);
+        }
+        if (pool->tete == NULL && pool->arret) {
+            break;
+        }
+
+        Tache *tache = pool->tete;
+        pool->tete = tache->suivante;
+        if (pool->tete == NULL) {
+            pool->queue = NULL;
+        }
+        pthread_mutex_unlock(&pool->verrou);
+
+        DEBUT_TRACE(tache);
+        tache->fonction(tache->argument);
+        FIN_TRACE(tache, "tache");
+        free(tache);
+
+        pthread_mutex_lock(&pool->verrou);
+        pool->enCours--;
+        if (pool->enCours == 0) {
+            pthread_cond_broadcast(&pool->tachesFinies);
+        }
+    }
+    pthread_mutex_unlock(&pool->verrou);
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Crée un pool de fils d'exécution
+ *
+ * \param[in] nbFils Le nombre de fils, ou 0 pour un fil par cœur
+ * \return Un pointeur vers le pool créé
+ * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+ */
+PoolThreads *creerPool(int nbFils){
+    if (nbFils <= 0) {
+        nbFils = nombreCoeurs();
+    }
+
+    PoolThreads *pool = (PoolThreads *)malloc(sizeof(PoolThreads));
+    if (pool == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    pool->fils = (pthread_t *)malloc(nbFils * sizeof(pthread_t));
+    if (pool->fils == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    pool->nbFils = nbFils;
+    pool->tete = NULL;
+    pool->queue = NULL;
+    pool->enCours = 0;
+    pool->arret = 0;
+    pthread_mutex_init(&pool->verrou, NULL);
+    pthread_cond_init(&pool->nouvelleTache, NULL);
+    pthread_cond_init(&pool->tachesFinies, NULL);
+
+    for (int i = 0; i < nbFils; i++) {
+        if (pthread_create(&pool->fils[i], NULL, executerFil, pool) != 0) {
+            perror("Impossible de créer un fil d'exécution");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return pool;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Soumet une tâche au pool
+ *
+ * \param[in,out] pool Le pool
+ * \param[in] fonction La fonction à exécuter
+ * \param[in] argument L'argument passé à la fonction
+ */
+void soumettreTache(PoolThreads *pool, FonctionTache fonction, void *argument){
+    Tache *tache = (Tache *)malloc(sizeof(Tache));
+    if (tache == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    tache->fonction = fonction;
+    tache->argument = argument;
+    tache->suivante = NULL;
+
+    pthread_mutex_lock(&pool->verrou);
+    if (pool->queue == NULL) {
+        pool->tete = tache;
+    } else {
+        pool->queue->suivante = tache;
+    }
+    pool->queue = tache;
+    pool->enCours++;
+    pthread_cond_signal(&pool->nouvelleTache);
+    pthread_mutex_unlock(&pool->verrou);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Attend la fin de toutes les tâches soumises
+ *
+ * \param[in,out] pool Le pool
+ */
+void attendreTaches(PoolThreads *pool){
+    pthread_mutex_lock(&pool->verrou);
+    while (pool->enCours > 0) {
+        pthread_cond_wait(&pool->tachesFinies, &pool->verrou);
+    }
+    pthread_mutex_unlock(&pool->verrou);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Arrête les fils du pool et libère sa mémoire
+ *
+ * Les tâches déjà soumises sont exécutées avant l'arrêt.
+ *
+ * \param[in] pool Le pool à détruire
+ */
+void detruirePool(PoolThreads *pool){
+    if (pool == NULL) return;
+
+    pthread_mutex_lock(&pool->verrou);
+    pool->arret = 1;
+    pthread_cond_broadcast(&pool->nouvelleTache);
+    pthread_mutex_unlock(&pool->verrou);
+
+    for (int i = 0; i < pool->nbFils; i++) {
+        pthread_join(pool->fils[i], NULL);
+    }
+
+    pthread_mutex_destroy(&pool->verrou);
+    pthread_cond_destroy(&pool->nouvelleTache);
+    pthread_cond_destroy(&pool->tachesFinies);
+    free(pool->fils);
+    free(pool);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne le nombre de cœurs de la machine
+ *
+ * \return Le nombre de cœurs en ligne, au moins 1
+ */
+int nombreCoeurs(void){
+    int nbCoeurs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    return (nbCoeurs > 0) ? nbCoeurs : 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \struct IntervalleTravaux
+ * \brief Travaux [debut, fin) qu'un fil n'a pas encore commencés.
+ *
+ * Les deux bornes tiennent dans un seul mot (debut sur les 32 bits de
+ * poids fort) changé par compare-et-échange : le fil propriétaire retire
+ * \c fin, les voleurs avancent \c debut. Chaque intervalle a sa ligne de
+ * cache, pour que les fils ne se gênent pas en prenant leurs travaux.
+ */
+typedef struct {
+    unsigned long long bornes;
+} __attribute__((aligned(64))) IntervalleTravaux;
+
+/* Travaux d'un appel à executerTravaux, partagés par ses fils */
+typedef struct {
+    IntervalleTravaux *intervalles;
+    int nbFils;
+    FonctionTravail fonction;
+    void *contexte;
+    long *travauxParFil;
+    long nbVols;
+} Travaux;
+
+/* Argument d'un fil de executerTravaux */
+typedef struct {
+    Travaux *travaux;
+    int fil;
+} FilTravaux;
+
+/* Assemble les bornes d'un intervalle en un mot */
+static unsigned long long bornesTravaux(unsigned long long debut, unsigned long long fin){
+    return (debut << 32) | fin;
+}
+
+/* Retire le dernier travail de l'intervalle ; faux s'il est vide */
+static Bool prendreTravail(IntervalleTravaux *intervalle, long *indice){
+    unsigned long long bornes = __atomic_load_n(&intervalle->bornes, __ATOMIC_ACQUIRE);
+    while (1) {
+        unsigned long long debut = bornes >> 32, fin = bornes & 0xFFFFFFFFULL;
+        if (debut >= fin) {
+            return false;
+        }
+        if (__atomic_compare_exchange_n(&intervalle->bornes, &bornes, bornesTravaux(debut, fin - 1),
+                                        true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *indice = (long)(fin - 1);
+            return true;
+        }
+    }
+}
+
+/* Vole la première moitié de l'intervalle d'un autre fil et en fait l'intervalle du fil ; faux s'il n'y a plus rien à voler */
+static Bool volerTravaux(Travaux *travaux, int fil){
+    for (int i = 1; i < travaux->nbFils; i++) {
+        IntervalleTravaux *victime = &travaux->intervalles[(fil + i) % travaux->nbFils];
+        unsigned long long bornes = __atomic_load_n(&victime->bornes, __ATOMIC_ACQUIRE);
+        while (1) {
+            unsigned long long debut = bornes >> 32, fin = bornes & 0xFFFFFFFFULL;
+            if (debut >= fin) {
+                break;
+            }
+            unsigned long long nbVoles = (fin - debut + 1) / 2;
+            if (__atomic_compare_exchange_n(&victime->bornes, &bornes, bornesTravaux(debut + nbVoles, fin),
+                                            true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                // L'intervalle du fil est vide : aucun voleur ne peut le changer avant ce stockage
+                __atomic_store_n(&travaux->intervalles[fil].bornes, bornesTravaux(debut, debut + nbVoles), __ATOMIC_RELEASE);
+                __atomic_add_fetch(&travaux->nbVols, 1, __ATOMIC_RELAXED);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* Boucle d'un fil de executerTravaux : ses travaux, puis ceux qu'il vole, jusqu'à ce qu'il n'y ait plus rien */
+static void *executerFilTravaux(void *argument){
+    FilTravaux *filTravaux = (FilTravaux *)argument;
+    Travaux *travaux = filTravaux->travaux;
+    int fil = filTravaux->fil;
+    long nbExecutes = 0, indice;
+
+    do {
+        while (prendreTravail(&travaux->intervalles[fil], &indice)) {
+            DEBUT_TRACE(travail);
+            travaux->fonction(indice, fil, travaux->contexte);
+            FIN_TRACE(travail, "travail");
+            nbExecutes++;
+        }
+    } while (volerTravaux(travaux, fil));
+
+    if (travaux->travauxParFil != NULL) {
+        travaux->travauxParFil[fil] = nbExecutes;
+    }
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Exécute des travaux connus d'avance, répartis par vol de travail
+ *
+ * Les travaux 0 à nbTravaux - 1 sont d'abord partagés en un intervalle
+ * contigu par fil. Chaque fil prend ses travaux par la fin de son
+ * intervalle ; quand il n'en a plus, il vole la première moitié de
+ * l'intervalle d'un autre fil. Les intervalles sont des mots atomiques :
+ * aucun verrou n'est pris, et des travaux de durées très différentes
+ * occupent quand même tous les fils jusqu'à la fin.
+ *
+ * \param[in] nbFils Le nombre de fils, ou 0 pour un fil par cœur
+ * \param[in] nbTravaux Le nombre de travaux
+ * \param[in] fonction La fonction exécutée pour chaque travail
+ * \param[in] contexte Le contexte passé à la fonction
+ * \param[out] travauxParFil Le nombre de travaux exécutés par chaque fil (nbFils cases), ou NULL
+ * \return Le nombre de vols réussis
+ */
+long executerTravaux(int nbFils, long nbTravaux, FonctionTravail fonction, void *contexte, long *travauxParFil){
+    if (nbFils <= 0) {
+        nbFils = nombreCoeurs();
+    }
+    if (nbTravaux > 0xFFFFFFFFL) {
+        fprintf(stderr, "Trop de travaux : %ld\n", nbTravaux);
+        exit(EXIT_FAILURE);
+    }
+
+    Travaux travaux = {NULL, nbFils, fonction, contexte, travauxParFil, 0};
+    travaux.intervalles = (IntervalleTravaux *)aligned_alloc(sizeof(IntervalleTravaux), nbFils * sizeof(IntervalleTravaux));
+    pthread_t *fils = (pthread_t *)malloc(nbFils * sizeof(pthread_t));
+    FilTravaux *arguments = (FilTravaux *)malloc(nbFils * sizeof(FilTravaux));
+    if (travaux.intervalles == NULL || fils == NULL || arguments == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nbFils; i++) {
+        travaux.intervalles[i].bornes = bornesTravaux(nbTravaux * i / nbFils, nbTravaux * (i + 1) / nbFils);
+    }
+
+    for (int i = 0; i < nbFils; i++) {
+        arguments[i].travaux = &travaux;
+        arguments[i].fil = i;
+        if (pthread_create(&fils[i], NULL, executerFilTravaux, &arguments[i]) != 0) {
+            perror("Impossible de créer un fil d'exécution");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (int i = 0; i < nbFils; i++) {
+        pthread_join(fils[i], NULL);
+    }
+
+    free(arguments);
+    free(fils);
+    free(travaux.intervalles);
+    return travaux.nbVols;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Morceau de tableau trié par une tâche ; si source n'est pas NULL, les clés de score en sont d'abord extraites */
+typedef struct {
+    CleTri *cles;
+    int debut;
+    int fin;
+    const Chevalier *chevaliers;
+    Chevalier *source;
+} MorceauTri;
+
+/* Tâche : extrait éventuellement puis trie les clés [debut, fin[ */
+static void trierMorceau(void *argument){
+    MorceauTri *morceau = (MorceauTri *)argument;
+
+    if (morceau->source != NULL) {
+        for (int i = morceau->debut; i < morceau->fin; i++) {
+            morceau->cles[i].cle = cleScore(&morceau->source[i]);
+            morceau->cles[i].index = i;
+        }
+    }
+
+    if (morceau->chevaliers == NULL) {
+        triRadixCles(&morceau->cles[morceau->debut], morceau->fin - morceau->debut);
+    } else {
+        triRapideCles(morceau->cles, morceau->debut, morceau->fin - 1, morceau->chevaliers);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Partie d'une fusion de deux suites triées a et b : produit sortie[kDebut, kFin[ */
+typedef struct {
+    const CleTri *a;
+    int na;
+    const CleTri *b;
+    int nb;
+    CleTri *sortie;
+    int kDebut;
+    int kFin;
+    const Chevalier *chevaliers;
+} MorceauFusion;
+
+/* Ordre de fusion : sans chevaliers, seule la clé compte et la fusion stable garde l'ordre du tri par base */
+static int comparerFusion(const CleTri *x, const CleTri *y, const Chevalier *chevaliers){
+    if (chevaliers == NULL) {
+        return (x->cle < y->cle) ? -1 : (x->cle > y->cle);
+    }
+    return comparerCles(x, y, chevaliers);
+}
+
+/* Nombre d'éléments pris dans a parmi les k premiers éléments de la fusion (à égalité, a passe d'abord) */
+static int coRang(const MorceauFusion *f, int k){
+    int bas = (k > f->nb) ? k - f->nb : 0;
+    int haut = (k < f->na) ? k : f->na;
+
+    while (bas < haut) {
+        int i = bas + (haut - bas) / 2;
+        int j = k - i;
+        if (j > 0 && comparerFusion(&f->a[i], &f->b[j - 1], f->chevaliers) <= 0) {
+            bas = i + 1;
+        } else {
+            haut = i;
+        }
+    }
+    return bas;
+}
+
+/* Tâche : fusionne la partie [kDebut, kFin[ de la sortie */
+static void fusionnerMorceau(void *argument){
+    MorceauFusion *f = (MorceauFusion *)argument;
+    int i = coRang(f, f->kDebut), j = f->kDebut - i;
+    int iFin = coRang(f, f->kFin), jFin = f->kFin - iFin;
+    CleTri *sortie = &f->sortie[f->kDebut];
+
+    while (i < iFin && j < jFin) {
+        if (comparerFusion(&f->b[j], &f->a[i], f->chevaliers) < 0) {
+            *sortie++ = f->b[j++];
+        } else {
+            *sortie++ = f->a[i++];
+        }
+    }
+    while (i < iFin) *sortie++ = f->a[i++];
+    while (j < jFin) *sortie++ = f->b[j++];
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Trie en parallèle ; extrait d'abord les clés de score de source si elle est donnée */
+static void trierEnParallele(PoolThreads *pool, CleTri *cles, int n, const Chevalier *chevaliers, Chevalier *source){
+    int nbMorceaux = pool->nbFils;
+    if (nbMorceaux > n) nbMorceaux = (n > 0) ? n : 1;
+
+    int *bornes = (int *)allouerMemoire(MEMOIRE_TAMPONS, (nbMorceaux + 1) * sizeof(int));
+    MorceauTri *morceaux = (MorceauTri *)allouerMemoire(MEMOIRE_TAMPONS, nbMorceaux * sizeof(MorceauTri));
+    if (bornes == NULL || morceaux == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    // 1. Chaque fil trie un morceau
+    for (int m = 0; m <= nbMorceaux; m++) {
+        bornes[m] = (int)((long long)n * m / nbMorceaux);
+    }
+    for (int m = 0; m < nbMorceaux; m++) {
+        morceaux[m] = (MorceauTri){ cles, bornes[m], bornes[m + 1], chevaliers, source };
+        soumettreTache(pool, trierMorceau, &morceaux[m]);
+    }
+    attendreTaches(pool);
+    libererMemoire(MEMOIRE_TAMPONS, morceaux);
+
+    if (nbMorceaux == 1) {
+        libererMemoire(MEMOIRE_TAMPONS, bornes);
+        return;
+    }
+
+    // 2. Fusions deux à deux, chaque fusion étant découpée entre les fils
+    CleTri *tampon = (CleTri *)allouerMemoire(MEMOIRE_TAMPONS, n * sizeof(CleTri));
+    if (tampon == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    CleTri *source2 = cles, *destination = tampon;
+    int nbSuites = nbMorceaux;
+
+    while (nbSuites > 1) {
+        int nbPaires = nbSuites / 2;
+        int parFusion = (2 * pool->nbFils + nbPaires - 1) / nbPaires;
+        MorceauFusion *fusions = (MorceauFusion *)allouerMemoire(MEMOIRE_TAMPONS, (nbPaires * parFusion + 1) * sizeof(MorceauFusion));
+        if (fusions == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        int nbFusions = 0;
+
+        for (int p = 0; p < nbPaires; p++) {
+            int debut = bornes[2 * p], milieu = bornes[2 * p + 1], fin = bornes[2 * p + 2];
+            int total = fin - debut;
+            for (int s = 0; s < parFusion; s++) {
+                MorceauFusion *f = &fusions[nbFusions++];
+                f->a = &source2[debut];
+                f->na = milieu - debut;
+                f->b = &source2[milieu];
+                f->nb = fin - milieu;
+                f->sortie = &destination[debut];
+                f->kDebut = (int)((long long)total * s / parFusion);
+                f->kFin = (int)((long long)total * (s + 1) / parFusion);
+                f->chevaliers = chevaliers;
+                soumettreTache(pool, fusionnerMorceau, f);
+            }
+        }
+        // Une suite sans partenaire est recopiée telle quelle
+        if (nbSuites % 2 == 1) {
+            int debut = bornes[nbSuites - 1], fin = bornes[nbSuites];
+            MorceauFusion *f = &fusions[nbFusions++];
+            *f = (MorceauFusion){ &source2[debut], fin - debut, NULL, 0, &destination[debut], 0, fin - debut, chevaliers };
+            soumettreTache(pool, fusionnerMorceau, f);
+        }
+        attendreTaches(pool);
+        libererMemoire(MEMOIRE_TAMPONS, fusions);
+
+        for (int p = 0; p <= nbPaires; p++) {
+            bornes[p] = bornes[(2 * p < nbSuites) ? 2 * p : nbSuites];
+        }
+        bornes[(nbSuites + 1) / 2] = n;
+        nbSuites = (nbSuites + 1) / 2;
+
+        CleTri *temp = source2;
+        source2 = destination;
+        destination = temp;
+    }
+
+    if (source2 != cles) {
+        memcpy(cles, source2, n * sizeof(CleTri));
+    }
+    libererMemoire(MEMOIRE_TAMPONS, tampon);
+    libererMemoire(MEMOIRE_TAMPONS, bornes);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Trie des clés en parallèle
+ *
+ * Le tableau est découpé en un morceau par fil, chaque morceau est trié
+ * (par base si \c chevaliers vaut NULL, par tri rapide sinon), puis les
+ * morceaux sont fusionnés deux à deux. Chaque fusion est elle-même
+ * découpée entre les fils. Le résultat est identique au tri séquentiel.
+ *
+ * \param[in,out] pool Le pool
+ * \param[in,out] cles Les clés à trier
+ * \param[in] n Le nombre de clés
+ * \param[in] chevaliers Les chevaliers pour départager les clés égales par pseudo, NULL pour départager par indice
+ */
+void triParalleleCles(PoolThreads *pool, CleTri *cles, int n, const Chevalier *chevaliers){
+    if (n < 2) return;
+    trierEnParallele(pool, cles, n, chevaliers, NULL);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Trie des chevaliers par meilleur score décroissant en parallèle
+ *
+ * Même ordre que \c triRadixChevaliers.
+ *
+ * \param[in,out] pool Le pool
+ * \param[in,out] tableau Le tableau de chevaliers à trier
+ */
+void triParalleleChevaliers(PoolThreads *pool, TableauChevaliers *tableau){
+    int n = tableau->nbChevaliers;
+    if (n < 2) return;
+
+    CleTri *cles = (CleTri *)allouerMemoire(MEMOIRE_TAMPONS, n * sizeof(CleTri));
+    if (cles == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    // Les clés sont extraites par les fils, chacun sur son morceau
+    trierEnParallele(pool, cles, n, NULL, tableau->chevaliers);
+    appliquerOrdreCles(tableau->chevaliers, cles, 0, n);
+    libererMemoire(MEMOIRE_TAMPONS, cles);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Morceau de tableau dont une tâche calcule les statistiques */
+typedef struct {
+    Chevalier *chevaliers;
+    StatistiquesChevalier *stats;
+    int debut;
+    int fin;
+} MorceauStatistiques;
+
+/* Tâche : calcule les statistiques des chevaliers [debut, fin[ */
+static void calculerMorceauStatistiques(void *argument){
+    MorceauStatistiques *morceau = (MorceauStatistiques *)argument;
+    for (int i = morceau->debut; i < morceau->fin; i++) {
+        calculerStatistiques(&morceau->chevaliers[i], &morceau->stats[i]);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Calcule les statistiques de tous les chevaliers en parallèle
+ *
+ * \c stats[i] reçoit les statistiques du chevalier \c i, identiques à
+ * celles de \c calculerStatistiques.
+ *
+ * \param[in,out] pool Le pool
+ * \param[in] tableau Le tableau de chevaliers
+ * \param[out] stats Tableau d'au moins \c tableau->nbChevaliers statistiques
+ */
+void calculerStatistiquesParalleles(PoolThreads *pool, TableauChevaliers *tableau, StatistiquesChevalier *stats){
+    // Plus de morceaux que de fils pour équilibrer les joueurs aux longues listes de scores
+    int nbMorceaux = 4 * pool->nbFils;
+    if (nbMorceaux > tableau->nbChevaliers) nbMorceaux = tableau->nbChevaliers;
+    if (nbMorceaux == 0) return;
+
+    MorceauStatistiques *morceaux = (MorceauStatistiques *)allouerMemoire(MEMOIRE_TAMPONS, nbMorceaux * sizeof(MorceauStatistiques));
+    if (morceaux == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int m = 0; m < nbMorceaux; m++) {
+        morceaux[m].chevaliers = tableau->chevaliers;
+        morceaux[m].stats = stats;
+        morceaux[m].debut = (int)((long long)tableau->nbChevaliers * m / nbMorceaux);
+        morceaux[m].fin = (int)((long long)tableau->nbChevaliers * (m + 1) / nbMorceaux);
+        soumettreTache(pool, calculerMorceauStatistiques, &morceaux[m]);
+    }
+    attendreTaches(pool);
+    libererMemoire(MEMOIRE_TAMPONS, morceaux);
+}
@@ -0,0 +1,178 @@
+/**
+ * \file parallele.h
+ * \brief En-tête pour le fichier parallele.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef PARALLELE_H
+#define PARALLELE_H
+
+    #include <pthread.h>
+    #include "chevalier.h"
+
+    /**
+     * \brief Fonction exécutée par une tâche du pool
+     */
+    typedef void (*FonctionTache)(void *argument);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Fonction exécutée pour chaque travail de \c executerTravaux
+     *
+     * Reçoit l'indice du travail, le numéro du fil qui l'exécute (de 0 à
+     * nbFils - 1) et le contexte donné à \c executerTravaux.
+     */
+    typedef void (*FonctionTravail)(long indice, int fil, void *contexte);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct Tache
+     * \brief Maillon de la file des tâches en attente du pool.
+     */
+    typedef struct Tache {
+        FonctionTache fonction;
+        void *argument;
+        struct Tache *suivante;
+    } Tache;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct PoolThreads
+     * \brief Groupe de fils d'exécution qui exécutent des tâches soumises.
+     *
+     * Les tâches sont rangées dans une file protégée par un verrou. Les fils
+     * attendent sur \c nouvelleTache, et \c attendreTaches attend sur
+     * \c tachesFinies que la file soit vide et qu'aucune tâche ne tourne.
+     */
+    typedef struct {
+        pthread_t *fils;
+        int nbFils;
+        pthread_mutex_t verrou;
+        pthread_cond_t nouvelleTache;
+        pthread_cond_t tachesFinies;
+        Tache *tete;
+        Tache *queue;
+        int enCours;   // Tâches en attente ou en cours d'exécution
+        int arret;     // 1 quand le pool doit s'arrêter
+    } PoolThreads;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Crée un pool de fils d'exécution
+     *
+     * \param[in] nbFils Le nombre de fils, ou 0 pour un fil par cœur
+     * \return Un pointeur vers le pool créé
+     * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+     */
+    PoolThreads *creerPool(int nbFils);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Soumet une tâche au pool
+     *
+     * \param[in,out] pool Le pool
+     * \param[in] fonction La fonction à exécuter
+     * \param[in] argument L'argument passé à la fonction
+     */
+    void soumettreTache(PoolThreads *pool, FonctionTache fonction, void *argument);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Attend la fin de toutes les tâches soumises
+     *
+     * \param[in,out] pool Le pool
+     */
+    void attendreTaches(PoolThreads *pool);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Arrête les fils du pool et libère sa mémoire
+     *
+     * Les tâches déjà soumises sont exécutées avant l'arrêt.
+     *
+     * \param[in] pool Le pool à détruire
+     */
+    void detruirePool(PoolThreads *pool);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne le nombre de cœurs de la machine
+     *
+     * \return Le nombre de cœurs en ligne, au moins 1
+     */
+    int nombreCoeurs(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Exécute des travaux connus d'avance, répartis par vol de travail
+     *
+     * Les travaux 0 à nbTravaux - 1 sont d'abord partagés en un intervalle
+     * contigu par fil. Chaque fil prend ses travaux par la fin de son
+     * intervalle ; quand il n'en a plus, il vole la première moitié de
+     * l'intervalle d'un autre fil. Les intervalles sont des mots atomiques :
+     * aucun verrou n'est pris, et des travaux de durées très différentes
+     * occupent quand même tous les fils jusqu'à la fin.
+     *
+     * \param[in] nbFils Le nombre de fils, ou 0 pour un fil par cœur
+     * \param[in] nbTravaux Le nombre de travaux
+     * \param[in] fonction La fonction exécutée pour chaque travail
+     * \param[in] contexte Le contexte passé à la fonction
+     * \param[out] travauxParFil Le nombre de travaux exécutés par chaque fil (nbFils cases), ou NULL
+     * \return Le nombre de vols réussis
+     */
+    long executerTravaux(int nbFils, long nbTravaux, FonctionTravail fonction, void *contexte, long *travauxParFil);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Trie des clés en parallèle
+     *
+     * Le tableau est découpé en un morceau par fil, chaque morceau est trié
+     * (par base si \c chevaliers vaut NULL, par tri rapide sinon), puis les
+     * morceaux sont fusionnés deux à deux. Chaque fusion est elle-même
+     * découpée entre les fils. Le résultat est identique au tri séquentiel.
+     *
+     * \param[in,out] pool Le pool
+     * \param[in,out] cles Les clés à trier
+     * \param[in] n Le nombre de clés
+     * \param[in] chevaliers Les chevaliers pour départager les clés égales par pseudo, NULL pour départager par indice
+     */
+    void triParalleleCles(PoolThreads *pool, CleTri *cles, int n, const Chevalier *chevaliers);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Trie des chevaliers par meilleur score décroissant en parallèle
+     *
+     * Même ordre que \c triRadixChevaliers.
+     *
+     * \param[in,out] pool Le pool
+     * \param[in,out] tableau Le tableau de chevaliers à trier
+     */
+    void triParalleleChevaliers(PoolThreads *pool, TableauChevaliers *tableau);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Calcule les statistiques de tous les chevaliers en parallèle
+     *
+     * \c stats[i] reçoit les statistiques du chevalier \c i, identiques à
+     * celles de \c calculerStatistiques.
+     *
+     * \param[in,out] pool Le pool
+     * \param[in] tableau Le tableau de chevaliers
+     * \param[out] stats Tableau d'au moins \c tableau->nbChevaliers statistiques
+     */
+    void calculerStatistiquesParalleles(PoolThreads *pool, TableauChevaliers *tableau, StatistiquesChevalier *stats);
+
+#endif
@@ -0,0 +1,300 @@
+/**
+ * \file pool.c
+ * \brief Pools de petits objets (maillons) par classe de taille
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "pool.h"
+
+#include <pthread.h>
+
+/* Place réservée en tête de bloc pour garder les objets alignés sur 16 octets */
+#define ENTETE_BLOC_POOL 16
+
+/* Un objet libre sert de maillon dans la liste des objets libres */
+typedef struct ObjetLibre {
+    struct ObjetLibre *suivant;
+} ObjetLibre;
+
+/* En-tête d'un bloc : les blocs forment une liste pour être rendus au système */
+typedef struct BlocPool {
+    struct BlocPool *suivant;
+} BlocPool;
+
+/* Une classe de taille : ses objets libres et ses blocs, protégés par un verrou */
+typedef struct {
+    pthread_mutex_t verrou;
+    ObjetLibre *libres;
+    BlocPool *blocs;
+    long nbBlocs;
+    long nbLibres;
+    long nbSortis;     // Objets hors de la liste des libres : dans un cache ou utilisés
+    long nbUtilises;   // Allocations moins libérations, à jour au dernier passage de chaque fil
+} ClassePool;
+
+/* Objets libres gardés par un fil, sans verrou */
+typedef struct {
+    ObjetLibre *libres[NB_CLASSES_POOL];
+    int nb[NB_CLASSES_POOL];
+    long utilises[NB_CLASSES_POOL];   // Allocations moins libérations du fil, pas encore reportées dans la classe
+    int inscrit;
+} CachePool;
+
+#define CLASSE_POOL_VIDE {PTHREAD_MUTEX_INITIALIZER, NULL, NULL, 0, 0, 0, 0}
+
+static ClassePool classes[NB_CLASSES_POOL] = {CLASSE_POOL_VIDE, CLASSE_POOL_VIDE, CLASSE_POOL_VIDE, CLASSE_POOL_VIDE};
+static __thread CachePool cache;
+static pthread_key_t cleCache;
+static pthread_once_t cleCreee = PTHREAD_ONCE_INIT;
+
+/* Taille des objets d'une classe */
+static size_t tailleClasse(int classe){
+    return (size_t)(classe + 1) * PAS_CLASSES_POOL;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Ajoute un bloc d'objets libres à une classe (verrou de la classe pris) */
+static void ajouterBloc(ClassePool *classe, size_t taille){
+    BlocPool *bloc = (BlocPool *)malloc(ENTETE_BLOC_POOL + OBJETS_PAR_BLOC_POOL * taille);
+    if (bloc == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    bloc->suivant = classe->blocs;
+    classe->blocs = bloc;
+    classe->nbBlocs++;
+
+    // Les objets sont chaînés dans l'ordre du bloc pour être distribués dans cet ordre
+    char *objets = (char *)bloc + ENTETE_BLOC_POOL;
+    for (int i = OBJETS_PAR_BLOC_POOL - 1; i >= 0; i--) {
+        ObjetLibre *objet = (ObjetLibre *)(objets + i * taille);
+        objet->suivant = classe->libres;
+        classe->libres = objet;
+    }
+    classe->nbLibres += OBJETS_PAR_BLOC_POOL;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Reporte dans la classe les allocations du fil (verrou de la classe pris) */
+static void reporterUtilises(ClassePool *classe, CachePool *cachePool, int numero){
+    classe->nbUtilises += cachePool->utilises[numero];
+    cachePool->utilises[numero] = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Rend à sa classe les nb premiers objets du cache d'un fil */
+static void rendreLot(CachePool *cachePool, int numero, int nb){
+    ObjetLibre *premier = NULL, *dernier = NULL;
+
+    // Le lot est détaché du cache sans verrou, puis accroché à la classe d'un coup
+    if (nb > 0) {
+        premier = cachePool->libres[numero];
+        dernier = premier;
+        for (int i = 1; i < nb; i++) {
+            dernier = dernier->suivant;
+        }
+        cachePool->libres[numero] = dernier->suivant;
+        cachePool->nb[numero] -= nb;
+    }
+
+    ClassePool *classe = &classes[numero];
+    pthread_mutex_lock(&classe->verrou);
+    if (nb > 0) {
+        dernier->suivant = classe->libres;
+        classe->libres = premier;
+        classe->nbLibres += nb;
+        classe->nbSortis -= nb;
+    }
+    reporterUtilises(classe, cachePool, numero);
+    pthread_mutex_unlock(&classe->verrou);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Destructeur appelé à la fin d'un fil : ses objets libres reviennent aux classes */
+static void rendreCache(void *valeur){
+    CachePool *cachePool = (CachePool *)valeur;
+    for (int i = 0; i < NB_CLASSES_POOL; i++) {
+        rendreLot(cachePool, i, cachePool->nb[i]);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Crée la clé qui déclenche rendreCache */
+static void creerCleCache(void){
+    pthread_key_create(&cleCache, rendreCache);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Fait rendre le cache du fil courant à la fin du fil */
+static void inscrireCache(void){
+    if (!cache.inscrit) {
+        pthread_once(&cleCreee, creerCleCache);
+        pthread_setspecific(cleCache, &cache);
+        cache.inscrit = 1;
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Remplit le cache du fil avec un lot d'objets de la classe */
+static void remplirCache(int numero){
+    inscrireCache();
+    int lot = TAILLE_CACHE_POOL / 2;
+    ClassePool *classe = &classes[numero];
+    pthread_mutex_lock(&classe->verrou);
+    while (classe->nbLibres < lot) {
+        ajouterBloc(classe, tailleClasse(numero));
+    }
+    for (int i = 0; i < lot; i++) {
+        ObjetLibre *objet = classe->libres;
+        classe->libres = objet->suivant;
+        objet->suivant = cache.libres[numero];
+        cache.libres[numero] = objet;
+    }
+    classe->nbLibres -= lot;
+    classe->nbSortis += lot;
+    reporterUtilises(classe, &cache, numero);
+    pthread_mutex_unlock(&classe->verrou);
+    cache.nb[numero] += lot;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Alloue un petit objet dans le pool de sa classe de taille
+ *
+ * Utilisable par plusieurs fils en même temps.
+ *
+ * \param[in] taille La taille de l'objet en octets
+ * \return Un objet non initialisé, à rendre avec \c libererDansPool et la même taille
+ * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+ */
+void *allouerDansPool(size_t taille){
+    if (taille > tailleClasse(NB_CLASSES_POOL - 1)) {
+        void *objet = malloc(taille);
+        if (objet == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        return objet;
+    }
+
+    int numero = (taille == 0) ? 0 : (int)((taille - 1) / PAS_CLASSES_POOL);
+    if (cache.libres[numero] == NULL) {
+        remplirCache(numero);
+    }
+    ObjetLibre *objet = cache.libres[numero];
+    cache.libres[numero] = objet->suivant;
+    cache.nb[numero]--;
+    cache.utilises[numero]++;
+    return objet;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Rend un objet à son pool
+ *
+ * \param[in] objet L'objet rendu par \c allouerDansPool (NULL est ignoré)
+ * \param[in] taille La taille donnée à son allocation
+ */
+void libererDansPool(void *objet, size_t taille){
+    if (objet == NULL) return;
+    if (taille > tailleClasse(NB_CLASSES_POOL - 1)) {
+        free(objet);
+        return;
+    }
+
+    // Inscrit dès le premier objet gardé : le cache est rendu à la fin du fil même s'il ne se remplit jamais
+    inscrireCache();
+    int numero = (taille == 0) ? 0 : (int)((taille - 1) / PAS_CLASSES_POOL);
+    ObjetLibre *libre = (ObjetLibre *)objet;
+    libre->suivant = cache.libres[numero];
+    cache.libres[numero] = libre;
+    cache.nb[numero]++;
+    cache.utilises[numero]--;
+
+    // Un fil qui libère plus qu'il n'alloue rend la moitié de son cache
+    if (cache.nb[numero] >= TAILLE_CACHE_POOL) {
+        rendreLot(&cache, numero, TAILLE_CACHE_POOL / 2);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne l'occupation d'une classe de taille
+ *
+ * Les allocations du fil appelant sont comptées exactement ; celles des
+ * autres fils le sont à un lot près, jusqu'à leur prochain échange avec
+ * la classe.
+ *
+ * \param[in] classe La classe, de 0 à \c NB_CLASSES_POOL - 1
+ * \param[out] stats L'occupation de la classe
+ */
+void statistiquesPool(int classe, StatistiquesPool *stats){
+    ClassePool *c = &classes[classe];
+
+    pthread_mutex_lock(&c->verrou);
+    reporterUtilises(c, &cache, classe);
+    stats->tailleObjet = tailleClasse(classe);
+    stats->nbBlocs = c->nbBlocs;
+    stats->nbObjets = c->nbBlocs * OBJETS_PAR_BLOC_POOL;
+    stats->nbLibres = c->nbLibres;
+    stats->nbUtilises = c->nbUtilises;
+    stats->nbEnCache = c->nbSortis - c->nbUtilises;
+    pthread_mutex_unlock(&c->verrou);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Affiche l'occupation de toutes les classes de taille
+ */
+void afficherStatistiquesPools(void){
+    StatistiquesPool stats;
+
+    printf("Pools de petits objets :\n");
+    for (int i = 0; i < NB_CLASSES_POOL; i++) {
+        statistiquesPool(i, &stats);
+        if (stats.nbBlocs == 0) continue;
+        printf("- %zu octets : %ld bloc(s), %ld utilisé(s) sur %ld (%.1f %%), %ld libre(s), %ld en cache\n", stats.tailleObjet,
+               stats.nbBlocs, stats.nbUtilises, stats.nbObjets, 100.0 * stats.nbUtilises / stats.nbObjets, stats.nbLibres, stats.nbEnCache);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Rend au système tous les blocs des pools
+ *
+ * Aucun objet ne doit plus être utilisé et les autres fils doivent être
+ * terminés.
+ */
+void viderPools(void){
+    for (int i = 0; i < NB_CLASSES_POOL; i++) {
+        ClassePool *classe = &classes[i];
+        pthread_mutex_lock(&classe->verrou);
+        while (classe->blocs != NULL) {
+            BlocPool *suivant = classe->blocs->suivant;
+            free(classe->blocs);
+            classe->blocs = suivant;
+        }
+        classe->libres = NULL;
+        classe->nbBlocs = 0;
+        classe->nbLibres = 0;
+        classe->nbSortis = 0;
+        classe->nbUtilises = 0;
+        pthread_mutex_unlock(&classe->verrou);
+
+        cache.libres[i] = NULL;
+        cache.nb[i] = 0;
+        cache.utilises[i] = 0;
+    }
+}
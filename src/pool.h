@@ -0,0 +1,118 @@
+/**
+ * \file pool.h
+ * \brief En-tête pour le fichier pool.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+    #include <stdio.h>
+    #include <stdlib.h>
+
+    /**
+     * \def PAS_CLASSES_POOL
+     * \brief Écart en octets entre deux classes de taille des pools.
+     */
+    #define PAS_CLASSES_POOL 16
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def NB_CLASSES_POOL
+     * \brief Nombre de classes de taille : les objets de 16, 32, 48 et 64 octets.
+     *
+     * Les objets plus grands sont alloués directement avec malloc.
+     */
+    #define NB_CLASSES_POOL 4
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def OBJETS_PAR_BLOC_POOL
+     * \brief Nombre d'objets alloués d'un coup quand une classe n'a plus d'objet libre.
+     */
+    #define OBJETS_PAR_BLOC_POOL 4096
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \def TAILLE_CACHE_POOL
+     * \brief Nombre maximum d'objets libres gardés par chaque fil pour une classe.
+     *
+     * Un fil échange ses objets avec la classe par lots de la moitié de
+     * cette taille : le verrou de la classe n'est pris qu'une fois par lot.
+     */
+    #define TAILLE_CACHE_POOL 256
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct StatistiquesPool
+     * \brief Occupation d'une classe de taille.
+     */
+    typedef struct {
+        size_t tailleObjet;
+        long nbBlocs;      // Blocs alloués avec malloc
+        long nbObjets;     // Objets contenus dans ces blocs
+        long nbLibres;     // Objets libres dans la classe
+        long nbEnCache;    // Objets libres gardés par les fils
+        long nbUtilises;   // Objets rendus par allouerDansPool et pas encore libérés
+    } StatistiquesPool;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Alloue un petit objet dans le pool de sa classe de taille
+     *
+     * Utilisable par plusieurs fils en même temps.
+     *
+     * \param[in] taille La taille de l'objet en octets
+     * \return Un objet non initialisé, à rendre avec \c libererDansPool et la même taille
+     * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+     */
+    void *allouerDansPool(size_t taille);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Rend un objet à son pool
+     *
+     * \param[in] objet L'objet rendu par \c allouerDansPool (NULL est ignoré)
+     * \param[in] taille La taille donnée à son allocation
+     */
+    void libererDansPool(void *objet, size_t taille);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne l'occupation d'une classe de taille
+     *
+     * Les allocations du fil appelant sont comptées exactement ; celles des
+     * autres fils le sont à un lot près, jusqu'à leur prochain échange avec
+     * la classe.
+     *
+     * \param[in] classe La classe, de 0 à \c NB_CLASSES_POOL - 1
+     * \param[out] stats L'occupation de la classe
+     */
+    void statistiquesPool(int classe, StatistiquesPool *stats);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Affiche l'occupation de toutes les classes de taille
+     */
+    void afficherStatistiquesPools(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Rend au système tous les blocs des pools
+     *
+     * Aucun objet ne doit plus être utilisé et les autres fils doivent être
+     * terminés.
+     */
+    void viderPools(void);
+
+#endif
@@ -0,0 +1,287 @@
+/**
+ * \file recherche.c
+ * \brief Index des pseudos pour la recherche exacte et par préfixe
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "recherche.h"
+#include "instrumentation.h"
+
+/* Ajoute un nœud vide à l'index et renvoie son indice */
+static int nouveauNoeud(IndexPseudos *index, unsigned char lettre){
+    if (index->nbNoeuds == index->capacite) {
+        int capacite = (index->capacite == 0) ? 64 : 2 * index->capacite;
+        NoeudPseudo *noeuds = (NoeudPseudo *)reallouerMemoire(MEMOIRE_NOMS, index->noeuds, capacite * sizeof(NoeudPseudo));
+        if (noeuds == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        index->noeuds = noeuds;
+        index->capacite = capacite;
+    }
+
+    NoeudPseudo *noeud = &index->noeuds[index->nbNoeuds];
+    noeud->lettre = lettre;
+    noeud->premierFils = -1;
+    noeud->frere = -1;
+    noeud->chevalier = -1;
+    noeud->nbPseudos = 0;
+    return index->nbNoeuds++;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Cherche le fils d'un nœud portant une lettre, -1 s'il n'existe pas */
+static int chercherFils(const IndexPseudos *index, int noeud, unsigned char lettre){
+    int fils = index->noeuds[noeud].premierFils;
+    while (fils != -1 && index->noeuds[fils].lettre < lettre) {
+        fils = index->noeuds[fils].frere;
+    }
+    if (fils != -1 && index->noeuds[fils].lettre == lettre) {
+        return fils;
+    }
+    return -1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Cherche le nœud où se termine un préfixe, -1 si aucun pseudo ne commence ainsi */
+static int chercherNoeud(const IndexPseudos *index, const char *prefixe){
+    int noeud = 0;
+    while (*prefixe != '\0' && noeud != -1) {
+        noeud = chercherFils(index, noeud, (unsigned char)*prefixe++);
+    }
+    return noeud;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Renvoie le fils portant une lettre, en le créant à sa place dans la liste des fils si besoin */
+static int obtenirFils(IndexPseudos *index, int noeud, unsigned char lettre){
+    int precedent = -1;
+    int fils = index->noeuds[noeud].premierFils;
+    while (fils != -1 && index->noeuds[fils].lettre < lettre) {
+        precedent = fils;
+        fils = index->noeuds[fils].frere;
+    }
+    if (fils != -1 && index->noeuds[fils].lettre == lettre) {
+        return fils;
+    }
+
+    // nouveauNoeud peut déplacer le tableau : on ne garde que des indices
+    int nouveau = nouveauNoeud(index, lettre);
+    index->noeuds[nouveau].frere = fils;
+    if (precedent == -1) {
+        index->noeuds[noeud].premierFils = nouveau;
+    } else {
+        index->noeuds[precedent].frere = nouveau;
+    }
+    return nouveau;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Crée un index de pseudos vide
+ *
+ * \return Un pointeur vers l'index créé
+ * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+ */
+IndexPseudos *creerIndexPseudos(void){
+    IndexPseudos *index = (IndexPseudos *)allouerMemoire(MEMOIRE_NOMS, sizeof(IndexPseudos));
+    if (index == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    index->noeuds = NULL;
+    index->nbNoeuds = 0;
+    index->capacite = 0;
+    nouveauNoeud(index, '\0');
+    return index;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Crée l'index des pseudos d'un tableau de chevaliers
+ *
+ * Les indices enregistrés sont ceux du tableau : il ne doit plus être
+ * réordonné tant que l'index est utilisé.
+ *
+ * \param[in] tableau Le tableau de chevaliers
+ * \return Un pointeur vers l'index créé
+ */
+IndexPseudos *indexerTableau(TableauChevaliers *tableau){
+    IndexPseudos *index = creerIndexPseudos();
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        indexerPseudo(index, texteChaine(tableau->chevaliers[i].pseudo), i);
+    }
+    return index;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Ajoute un pseudo à l'index
+ *
+ * Si le pseudo est déjà présent, son indice est remplacé.
+ *
+ * \param[in,out] index L'index des pseudos
+ * \param[in] pseudo Le pseudo à ajouter
+ * \param[in] chevalier L'indice du chevalier dans le tableau
+ */
+void indexerPseudo(IndexPseudos *index, const char *pseudo, int chevalier){
+    int noeud = chercherNoeud(index, pseudo);
+    if (noeud != -1 && index->noeuds[noeud].chevalier != -1) {
+        index->noeuds[noeud].chevalier = chevalier;
+        return;
+    }
+
+    // Nouveau pseudo : chaque nœud du chemin gagne un pseudo dans son sous-arbre
+    noeud = 0;
+    index->noeuds[0].nbPseudos++;
+    while (*pseudo != '\0') {
+        noeud = obtenirFils(index, noeud, (unsigned char)*pseudo++);
+        index->noeuds[noeud].nbPseudos++;
+    }
+    index->noeuds[noeud].chevalier = chevalier;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Cherche un pseudo exact dans l'index
+ *
+ * Le coût ne dépend que de la longueur du pseudo.
+ *
+ * \param[in] index L'index des pseudos
+ * \param[in] pseudo Le pseudo à chercher
+ * \return L'indice du chevalier, -1 si le pseudo n'existe pas
+ */
+int chercherPseudo(const IndexPseudos *index, const char *pseudo){
+    DEBUT_MESURE(MESURE_RECHERCHE);
+    int noeud = chercherNoeud(index, pseudo);
+    int chevalier = (noeud == -1) ? -1 : index->noeuds[noeud].chevalier;
+    FIN_MESURE(MESURE_RECHERCHE);
+    return chevalier;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compte les pseudos qui commencent par un préfixe
+ *
+ * \param[in] index L'index des pseudos
+ * \param[in] prefixe Le début des pseudos cherchés
+ * \return Le nombre de pseudos trouvés
+ */
+int compterPrefixe(const IndexPseudos *index, const char *prefixe){
+    int noeud = chercherNoeud(index, prefixe);
+    return (noeud == -1) ? 0 : index->noeuds[noeud].nbPseudos;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Parcours en profondeur qui saute les sous-arbres entièrement avant la page */
+static void parcourirPage(const IndexPseudos *index, int noeud, int *decalage, int nb, int *resultats, int *nbResultats){
+    const NoeudPseudo *courant = &index->noeuds[noeud];
+    if (courant->nbPseudos <= *decalage) {
+        *decalage -= courant->nbPseudos;
+        return;
+    }
+
+    // Un pseudo est rangé avant tous ceux qui le prolongent
+    if (courant->chevalier != -1) {
+        if (*decalage > 0) {
+            (*decalage)--;
+        } else {
+            resultats[(*nbResultats)++] = courant->chevalier;
+        }
+    }
+
+    for (int fils = courant->premierFils; fils != -1 && *nbResultats < nb; fils = index->noeuds[fils].frere) {
+        parcourirPage(index, fils, decalage, nb, resultats, nbResultats);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Cherche une page de pseudos qui commencent par un préfixe
+ *
+ * Les résultats sont donnés par ordre alphabétique. Le coût dépend de la
+ * longueur du préfixe et de la taille de la page, pas du nombre de chevaliers.
+ *
+ * \param[in] index L'index des pseudos
+ * \param[in] prefixe Le début des pseudos cherchés
+ * \param[in] nb Le nombre maximum de résultats
+ * \param[in] decalage Le nombre de résultats à sauter
+ * \param[out] resultats Tableau d'au moins \c nb indices de chevaliers
+ * \return Le nombre d'indices écrits dans \c resultats
+ */
+int chercherPrefixe(const IndexPseudos *index, const char *prefixe, int nb, int decalage, int *resultats){
+    DEBUT_MESURE(MESURE_RECHERCHE);
+    int noeud = chercherNoeud(index, prefixe);
+    int nbResultats = 0;
+
+    if (noeud != -1 && nb > 0 && decalage >= 0) {
+        parcourirPage(index, noeud, &decalage, nb, resultats, &nbResultats);
+    }
+    FIN_MESURE(MESURE_RECHERCHE);
+    return nbResultats;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Affiche une page des chevaliers dont le pseudo commence par un préfixe
+ *
+ * \param[in] index L'index des pseudos du tableau
+ * \param[in] tableau Le tableau de chevaliers
+ * \param[in] prefixe Le début des pseudos cherchés
+ * \param[in] nbParPage Le nombre de lignes par page
+ * \param[in] page Le numéro de la page, à partir de 0
+ */
+void afficherRecherchePrefixe(const IndexPseudos *index, TableauChevaliers *tableau, const char *prefixe, int nbParPage, int page){
+    int total = compterPrefixe(index, prefixe);
+    if (total == 0) {
+        printf("Aucun joueur ne commence par \"%s\".\n", prefixe);
+        return;
+    }
+    if (nbParPage <= 0 || page < 0 || (long)nbParPage * page >= total) {
+        printf("Page vide.\n");
+        return;
+    }
+
+    int *resultats = (int *)allouerMemoire(MEMOIRE_TAMPONS, nbParPage * sizeof(int));
+    if (resultats == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    int nb = chercherPrefixe(index, prefixe, nbParPage, nbParPage * page, resultats);
+    printf("%d joueur(s) commence(nt) par \"%s\" :\n", total, prefixe);
+    for (int i = 0; i < nb; i++) {
+        Chevalier *chevalier = &tableau->chevaliers[resultats[i]];
+        printf("%d. %s - %d partie(s) - meilleur score : %d\n", nbParPage * page + i + 1, texteChaine(chevalier->pseudo), chevalier->nbParties,
+               meilleurScoreChevalier(chevalier));
+    }
+    printf("\n");
+
+    libererMemoire(MEMOIRE_TAMPONS, resultats);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère la mémoire de l'index
+ *
+ * \param[in] index L'index à libérer
+ */
+void libererIndexPseudos(IndexPseudos *index){
+    if (index == NULL) return;
+
+    libererMemoire(MEMOIRE_NOMS, index->noeuds);
+    libererMemoire(MEMOIRE_NOMS, index);
+}
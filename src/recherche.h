@@ -0,0 +1,144 @@
+/**
+ * \file recherche.h
+ * \brief En-tête pour le fichier recherche.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef RECHERCHE_H
+#define RECHERCHE_H
+
+    #include "chevalier.h"
+
+    /**
+     * \struct NoeudPseudo
+     * \brief Nœud de l'arbre préfixe des pseudos.
+     *
+     * Les fils d'un nœud forment une liste chaînée (par indices) rangée par
+     * ordre croissant de lettre, ce qui donne les pseudos dans l'ordre de
+     * \c strcmp lors d'un parcours en profondeur.
+     */
+    typedef struct {
+        unsigned char lettre;
+        int premierFils;   // Indice du premier fils, -1 si aucun
+        int frere;         // Indice du frère suivant, -1 si aucun
+        int chevalier;     // Indice du chevalier dont le pseudo finit ici, -1 si aucun
+        int nbPseudos;     // Nombre de pseudos dans le sous-arbre
+    } NoeudPseudo;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct IndexPseudos
+     * \brief Arbre préfixe qui associe chaque pseudo à l'indice de son chevalier.
+     *
+     * Les nœuds sont rangés dans un seul tableau, le nœud 0 est la racine.
+     * Chaque nœud connaît le nombre de pseudos de son sous-arbre : une page de
+     * résultats saute les sous-arbres entiers sans les parcourir.
+     */
+    typedef struct {
+        NoeudPseudo *noeuds;
+        int nbNoeuds;
+        int capacite;
+    } IndexPseudos;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Crée un index de pseudos vide
+     *
+     * \return Un pointeur vers l'index créé
+     * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+     */
+    IndexPseudos *creerIndexPseudos(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Crée l'index des pseudos d'un tableau de chevaliers
+     *
+     * Les indices enregistrés sont ceux du tableau : il ne doit plus être
+     * réordonné tant que l'index est utilisé.
+     *
+     * \param[in] tableau Le tableau de chevaliers
+     * \return Un pointeur vers l'index créé
+     */
+    IndexPseudos *indexerTableau(TableauChevaliers *tableau);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Ajoute un pseudo à l'index
+     *
+     * Si le pseudo est déjà présent, son indice est remplacé.
+     *
+     * \param[in,out] index L'index des pseudos
+     * \param[in] pseudo Le pseudo à ajouter
+     * \param[in] chevalier L'indice du chevalier dans le tableau
+     */
+    void indexerPseudo(IndexPseudos *index, const char *pseudo, int chevalier);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Cherche un pseudo exact dans l'index
+     *
+     * Le coût ne dépend que de la longueur du pseudo.
+     *
+     * \param[in] index L'index des pseudos
+     * \param[in] pseudo Le pseudo à chercher
+     * \return L'indice du chevalier, -1 si le pseudo n'existe pas
+     */
+    int chercherPseudo(const IndexPseudos *index, const char *pseudo);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compte les pseudos qui commencent par un préfixe
+     *
+     * \param[in] index L'index des pseudos
+     * \param[in] prefixe Le début des pseudos cherchés
+     * \return Le nombre de pseudos trouvés
+     */
+    int compterPrefixe(const IndexPseudos *index, const char *prefixe);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Cherche une page de pseudos qui commencent par un préfixe
+     *
+     * Les résultats sont donnés par ordre alphabétique. Le coût dépend de la
+     * longueur du préfixe et de la taille de la page, pas du nombre de chevaliers.
+     *
+     * \param[in] index L'index des pseudos
+     * \param[in] prefixe Le début des pseudos cherchés
+     * \param[in] nb Le nombre maximum de résultats
+     * \param[in] decalage Le nombre de résultats à sauter
+     * \param[out] resultats Tableau d'au moins \c nb indices de chevaliers
+     * \return Le nombre d'indices écrits dans \c resultats
+     */
+    int chercherPrefixe(const IndexPseudos *index, const char *prefixe, int nb, int decalage, int *resultats);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Affiche une page des chevaliers dont le pseudo commence par un préfixe
+     *
+     * \param[in] index L'index des pseudos du tableau
+     * \param[in] tableau Le tableau de chevaliers
+     * \param[in] prefixe Le début des pseudos cherchés
+     * \param[in] nbParPage Le nombre de lignes par page
+     * \param[in] page Le numéro de la page, à partir de 0
+     */
+    void afficherRecherchePrefixe(const IndexPseudos *index, TableauChevaliers *tableau, const char *prefixe, int nbParPage, int page);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère la mémoire de l'index
+     *
+     * \param[in] index L'index à libérer
+     */
+    void libererIndexPseudos(IndexPseudos *index);
+
+#endif
@@ -0,0 +1,280 @@
+/**
+ * \file registre.c
+ * \brief Registre des chevaliers fragmenté et protégé par des verrous
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "registre.h"
+#include "instrumentation.h"
+
+/**
+ * \brief Calcule le hachage d'un pseudo
+ *
+ * Utilise l'algorithme FNV-1a sur 32 bits.
+ *
+ * \param[in] pseudo Le pseudo à hacher
+ * \return La valeur de hachage du pseudo
+ */
+unsigned int hacherPseudo(const char *pseudo){
+    return hacherChaine(pseudo);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Les bits de poids fort choisissent le fragment, ceux de poids faible l'alvéole */
+static FragmentRegistre *fragmentDuPseudo(RegistreChevaliers *registre, unsigned int h){
+    return &registre->fragments[(h >> 24) % NB_FRAGMENTS];
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Cherche l'indice d'un pseudo interné dans un fragment, -1 s'il n'y est pas (verrou déjà pris) */
+static int chercherDansFragment(FragmentRegistre *fragment, IdChaine pseudo, unsigned int h){
+    if (fragment->nbAlveoles == 0) {
+        return -1;
+    }
+
+    int masque = fragment->nbAlveoles - 1;
+    int i = h & masque;
+    while (fragment->alveoles[i] != 0) {
+        int index = fragment->alveoles[i] - 1;
+        if (fragment->tableau.chevaliers[index].pseudo == pseudo) {
+            return index;
+        }
+        i = (i + 1) & masque;
+    }
+    return -1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Place l'indice d'un chevalier dans la table de hachage du fragment */
+static void placerDansAlveoles(FragmentRegistre *fragment, int index){
+    int masque = fragment->nbAlveoles - 1;
+    int i = hachageChaine(fragment->tableau.chevaliers[index].pseudo) & masque;
+    while (fragment->alveoles[i] != 0) {
+        i = (i + 1) & masque;
+    }
+    fragment->alveoles[i] = index + 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Ajoute un chevalier au fragment en gardant la table à moitié vide au plus */
+static int ajouterDansFragment(FragmentRegistre *fragment, Chevalier chevalier){
+    ajouterChevalier(&fragment->tableau, chevalier);
+
+    if (2 * fragment->tableau.nbChevaliers > fragment->nbAlveoles) {
+        int nbAlveoles = (fragment->nbAlveoles == 0) ? 16 : 2 * fragment->nbAlveoles;
+        int *alveoles = (int *)allouerMemoireZero(MEMOIRE_REGISTRE, nbAlveoles, sizeof(int));
+        if (alveoles == NULL) {
+            perror("Erreur d'allocation mémoire");
+            exit(EXIT_FAILURE);
+        }
+        libererMemoire(MEMOIRE_REGISTRE, fragment->alveoles);
+        fragment->alveoles = alveoles;
+        fragment->nbAlveoles = nbAlveoles;
+        for (int i = 0; i < fragment->tableau.nbChevaliers; i++) {
+            placerDansAlveoles(fragment, i);
+        }
+    } else {
+        placerDansAlveoles(fragment, fragment->tableau.nbChevaliers - 1);
+    }
+
+    return fragment->tableau.nbChevaliers - 1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Crée un registre de chevaliers vide
+ *
+ * \return Un pointeur vers le registre créé
+ * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+ */
+RegistreChevaliers *creerRegistre(void){
+    RegistreChevaliers *registre = (RegistreChevaliers *)allouerMemoire(MEMOIRE_REGISTRE, sizeof(RegistreChevaliers));
+    if (registre == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        FragmentRegistre *fragment = &registre->fragments[i];
+        pthread_rwlock_init(&fragment->verrou, NULL);
+        fragment->tableau.chevaliers = NULL;
+        fragment->tableau.nbChevaliers = 0;
+        fragment->tableau.capacite = 0;
+        fragment->alveoles = NULL;
+        fragment->nbAlveoles = 0;
+    }
+
+    return registre;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Transfère les chevaliers d'un tableau dans le registre
+ *
+ * Les listes de scores sont données au registre : après l'appel, le
+ * tableau est vide et ne doit plus libérer les scores transférés.
+ *
+ * \param[in,out] registre Le registre à remplir
+ * \param[in,out] tableau Le tableau de chevaliers à transférer
+ */
+void remplirRegistre(RegistreChevaliers *registre, TableauChevaliers *tableau){
+    for (int i = 0; i < tableau->nbChevaliers; i++) {
+        unsigned int h = hachageChaine(tableau->chevaliers[i].pseudo);
+        FragmentRegistre *fragment = fragmentDuPseudo(registre, h);
+
+        pthread_rwlock_wrlock(&fragment->verrou);
+        ajouterDansFragment(fragment, tableau->chevaliers[i]);
+        pthread_rwlock_unlock(&fragment->verrou);
+    }
+
+    libererMemoire(MEMOIRE_REGISTRE, tableau->chevaliers);
+    tableau->chevaliers = NULL;
+    tableau->nbChevaliers = 0;
+    tableau->capacite = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Enregistre le score d'une partie dans le registre
+ *
+ * Si le pseudo n'existe pas encore, le chevalier est créé dans le
+ * fragment correspondant. Le score est ensuite ajouté à sa liste.
+ * Seul le fragment du pseudo est verrouillé en écriture.
+ *
+ * \param[in,out] registre Le registre à modifier
+ * \param[in] pseudo Le pseudo du chevalier
+ * \param[in] score Le score à ajouter
+ */
+void enregistrerScore(RegistreChevaliers *registre, char *pseudo, int score){
+    Chevalier nouveau = creerChevalier(pseudo);
+    unsigned int h = hachageChaine(nouveau.pseudo);
+    FragmentRegistre *fragment = fragmentDuPseudo(registre, h);
+
+    // Le pseudo est interné avant de prendre le verrou du fragment
+    pthread_rwlock_wrlock(&fragment->verrou);
+    int index = chercherDansFragment(fragment, nouveau.pseudo, h);
+    if (index == -1) {
+        index = ajouterDansFragment(fragment, nouveau);
+    }
+    ajouterScore(&fragment->tableau.chevaliers[index], score);
+    pthread_rwlock_unlock(&fragment->verrou);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Lit les statistiques d'un chevalier du registre
+ *
+ * Le fragment du pseudo est verrouillé en lecture le temps du calcul.
+ *
+ * \param[in] registre Le registre à consulter
+ * \param[in] pseudo Le pseudo du chevalier
+ * \param[out] stats Les statistiques du chevalier
+ * \return true si le chevalier existe, false sinon
+ */
+Bool lireStatistiquesRegistre(RegistreChevaliers *registre, char *pseudo, StatistiquesChevalier *stats){
+    // Un pseudo jamais interné ne peut pas être dans le registre
+    IdChaine id = chercherChaine(pseudo);
+    if (id == CHAINE_INCONNUE) {
+        return false;
+    }
+
+    unsigned int h = hachageChaine(id);
+    FragmentRegistre *fragment = fragmentDuPseudo(registre, h);
+
+    pthread_rwlock_rdlock(&fragment->verrou);
+    int index = chercherDansFragment(fragment, id, h);
+    if (index != -1) {
+        calculerStatistiques(&fragment->tableau.chevaliers[index], stats);
+    }
+    pthread_rwlock_unlock(&fragment->verrou);
+
+    return index != -1;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compte les chevaliers du registre
+ *
+ * \param[in] registre Le registre à consulter
+ * \return Le nombre total de chevaliers
+ */
+int nombreChevaliersRegistre(RegistreChevaliers *registre){
+    int total = 0;
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        pthread_rwlock_rdlock(&registre->fragments[i].verrou);
+        total += registre->fragments[i].tableau.nbChevaliers;
+        pthread_rwlock_unlock(&registre->fragments[i].verrou);
+    }
+    return total;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Sauvegarde le registre dans le fichier des scores
+ *
+ * Tous les fragments sont verrouillés en lecture pendant l'écriture,
+ * ce qui donne une image cohérente du registre.
+ *
+ * \param[in] registre Le registre à sauvegarder
+ */
+void sauvegarderRegistre(RegistreChevaliers *registre){
+    TableauChevaliers vue;
+    int total = 0;
+
+    // Les verrous sont toujours pris dans le même ordre pour éviter les interblocages
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        pthread_rwlock_rdlock(&registre->fragments[i].verrou);
+        total += registre->fragments[i].tableau.nbChevaliers;
+    }
+
+    // Vue à plat des fragments : les listes de scores ne sont pas copiées
+    vue.chevaliers = (Chevalier *)allouerMemoire(MEMOIRE_REGISTRE, (total > 0 ? total : 1) * sizeof(Chevalier));
+    if (vue.chevaliers == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    vue.nbChevaliers = 0;
+    vue.capacite = (total > 0) ? total : 1;
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        TableauChevaliers *tableau = &registre->fragments[i].tableau;
+        if (tableau->nbChevaliers == 0) continue;
+        memcpy(&vue.chevaliers[vue.nbChevaliers], tableau->chevaliers, tableau->nbChevaliers * sizeof(Chevalier));
+        vue.nbChevaliers += tableau->nbChevaliers;
+    }
+
+    sauvegarderTableauChevaliers(&vue);
+
+    for (int i = NB_FRAGMENTS - 1; i >= 0; i--) {
+        pthread_rwlock_unlock(&registre->fragments[i].verrou);
+    }
+    libererMemoire(MEMOIRE_REGISTRE, vue.chevaliers);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère la mémoire allouée pour le registre
+ *
+ * \param[in] registre Le registre à libérer
+ */
+void libererRegistre(RegistreChevaliers *registre){
+    if (registre == NULL) return;
+
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        FragmentRegistre *fragment = &registre->fragments[i];
+        libererTableauChevaliers(&fragment->tableau);
+        libererMemoire(MEMOIRE_REGISTRE, fragment->alveoles);
+        pthread_rwlock_destroy(&fragment->verrou);
+    }
+    libererMemoire(MEMOIRE_REGISTRE, registre);
+}
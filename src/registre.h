@@ -0,0 +1,154 @@
+/**
+ * \file registre.h
+ * \brief En-tête pour le fichier registre.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef REGISTRE_H
+#define REGISTRE_H
+
+    #include <pthread.h>
+    #include "chevalier.h"
+
+    /**
+     * \def NB_FRAGMENTS
+     * \brief Nombre de fragments du registre des chevaliers.
+     *
+     * Chaque fragment possède son propre verrou : deux parties qui se terminent
+     * en même temps ne se bloquent que si leurs pseudos tombent dans le même fragment.
+     */
+    #define NB_FRAGMENTS 16
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct FragmentRegistre
+     * \brief Représente un fragment du registre des chevaliers.
+     *
+     * Un fragment contient un tableau de chevaliers protégé par un verrou
+     * lecteurs/rédacteur, ainsi qu'une table de hachage (adressage ouvert)
+     * qui associe un pseudo à son indice dans le tableau.
+     */
+    typedef struct {
+        pthread_rwlock_t verrou;
+        TableauChevaliers tableau;
+        int *alveoles;   // Indice + 1 du chevalier dans le tableau, 0 si l'alvéole est vide
+        int nbAlveoles;  // Toujours une puissance de 2
+    } FragmentRegistre;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct RegistreChevaliers
+     * \brief Registre des chevaliers partagé entre plusieurs fils d'exécution.
+     *
+     * Les chevaliers sont répartis dans \c NB_FRAGMENTS fragments selon le
+     * hachage de leur pseudo. Un rédacteur ne verrouille que le fragment
+     * concerné, et un lecteur ne voit jamais un tableau en cours de réallocation.
+     *
+     * \note Le menu n'a qu'un seul fil d'exécution et n'utilise pas le
+     * registre : il enregistre les parties dans un TableauChevaliers. Le
+     * registre n'est utilisé que par les tests et par construireClassementRegistre,
+     * en prévision d'un serveur qui terminerait plusieurs parties en même temps.
+     */
+    typedef struct {
+        FragmentRegistre fragments[NB_FRAGMENTS];
+    } RegistreChevaliers;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Calcule le hachage d'un pseudo
+     *
+     * Utilise l'algorithme FNV-1a sur 32 bits.
+     *
+     * \param[in] pseudo Le pseudo à hacher
+     * \return La valeur de hachage du pseudo
+     */
+    unsigned int hacherPseudo(const char *pseudo);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Crée un registre de chevaliers vide
+     *
+     * \return Un pointeur vers le registre créé
+     * \note Si l'allocation échoue, le programme termine avec un message d'erreur.
+     */
+    RegistreChevaliers *creerRegistre(void);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Transfère les chevaliers d'un tableau dans le registre
+     *
+     * Les listes de scores sont données au registre : après l'appel, le
+     * tableau est vide et ne doit plus libérer les scores transférés.
+     *
+     * \param[in,out] registre Le registre à remplir
+     * \param[in,out] tableau Le tableau de chevaliers à transférer
+     */
+    void remplirRegistre(RegistreChevaliers *registre, TableauChevaliers *tableau);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Enregistre le score d'une partie dans le registre
+     *
+     * Si le pseudo n'existe pas encore, le chevalier est créé dans le
+     * fragment correspondant. Le score est ensuite ajouté à sa liste.
+     * Seul le fragment du pseudo est verrouillé en écriture.
+     *
+     * \param[in,out] registre Le registre à modifier
+     * \param[in] pseudo Le pseudo du chevalier
+     * \param[in] score Le score à ajouter
+     */
+    void enregistrerScore(RegistreChevaliers *registre, char *pseudo, int score);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Lit les statistiques d'un chevalier du registre
+     *
+     * Le fragment du pseudo est verrouillé en lecture le temps du calcul.
+     *
+     * \param[in] registre Le registre à consulter
+     * \param[in] pseudo Le pseudo du chevalier
+     * \param[out] stats Les statistiques du chevalier
+     * \return true si le chevalier existe, false sinon
+     */
+    Bool lireStatistiquesRegistre(RegistreChevaliers *registre, char *pseudo, StatistiquesChevalier *stats);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compte les chevaliers du registre
+     *
+     * \param[in] registre Le registre à consulter
+     * \return Le nombre total de chevaliers
+     */
+    int nombreChevaliersRegistre(RegistreChevaliers *registre);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Sauvegarde le registre dans le fichier des scores
+     *
+     * Tous les fragments sont verrouillés en lecture pendant l'écriture,
+     * ce qui donne une image cohérente du registre.
+     *
+     * \param[in] registre Le registre à sauvegarder
+     */
+    void sauvegarderRegistre(RegistreChevaliers *registre);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère la mémoire allouée pour le registre
+     *
+     * \param[in] registre Le registre à libérer
+     */
+    void libererRegistre(RegistreChevaliers *registre);
+
+#endif
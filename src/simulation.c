@@ -0,0 +1,467 @@
+/**
+ * \file simulation.c
+ * \brief Parties simulées en parallèle, arrêtées dès que leurs résultats sont assez précis
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "simulation.h"
+#include "instrumentation.h"
+
+#include <math.h>
+
+/* Stratégies qui jouent toujours la même arme : l'état n'est pas utilisé */
+static int armePierre(void *etat){ return 0; }
+static int armeFeuille(void *etat){ return 1; }
+static int armeCiseaux(void *etat){ return 2; }
+
+/* Retient l'arme d'un monstre dans l'état d'une stratégie */
+static void observerArmeMonstre(void *etat, int armeMonstre){
+    EtatStrategie *strategie = (EtatStrategie *)etat;
+    if (armeMonstre < 0 || armeMonstre > 2) {
+        strategie->derniereArme = -1;
+        return;
+    }
+    strategie->frequences[armeMonstre]++;
+    if (strategie->derniereArme >= 0) {
+        strategie->suites[strategie->derniereArme][armeMonstre]++;
+    }
+    strategie->derniereArme = armeMonstre;
+}
+
+/* Arme qui bat la plus comptée des trois (ex aequo départagés au hasard), -1 si rien n'est compté */
+static int contrerPlusFrequente(const int compteurs[3], unsigned int *graine){
+    int premiere = rand_r(graine) % 3, plusFrequente = -1;
+    for (int i = 0; i < 3; i++) {
+        int arme = (premiere + i) % 3;
+        if (compteurs[arme] > 0 && (plusFrequente < 0 || compteurs[arme] > compteurs[plusFrequente])) {
+            plusFrequente = arme;
+        }
+    }
+    // La Feuille bat la Pierre, les Ciseaux la Feuille, la Pierre les Ciseaux
+    return (plusFrequente < 0) ? -1 : (plusFrequente + 1) % 3;
+}
+
+/* Stratégie "frequence" : contre l'arme la plus jouée par les monstres depuis le début de la partie */
+static int armeFrequence(void *etat){
+    EtatStrategie *strategie = (EtatStrategie *)etat;
+    int arme = contrerPlusFrequente(strategie->frequences, &strategie->graine);
+    return (arme >= 0) ? arme : armeAleatoire(&strategie->graine);
+}
+
+/* Stratégie "motif" : contre l'arme qui a le plus souvent suivi la dernière, sinon comme "frequence" */
+static int armeMotif(void *etat){
+    EtatStrategie *strategie = (EtatStrategie *)etat;
+    if (strategie->derniereArme >= 0) {
+        int arme = contrerPlusFrequente(strategie->suites[strategie->derniereArme], &strategie->graine);
+        if (arme >= 0) {
+            return arme;
+        }
+    }
+    return armeFrequence(etat);
+}
+
+/* Stratégies connues de trouverStrategie */
+static const StrategieSimulation strategies[] = {
+    {"aleatoire", armeAleatoire, NULL},
+    {"frequence", armeFrequence, observerArmeMonstre},
+    {"motif", armeMotif, observerArmeMonstre},
+    {"pierre", armePierre, NULL},
+    {"feuille", armeFeuille, NULL},
+    {"ciseaux", armeCiseaux, NULL}
+};
+#define NB_STRATEGIES 6
+
+/* Incrément de splitmix64 : la graine du générateur avance de ce pas à chaque tirage */
+#define PAS_ALEATOIRE 0x9E3779B97F4A7C15ULL
+
+/**
+ * \struct MorceauLot
+ * \brief Parties [debut, fin) d'un lot, jouées par une tâche du pool.
+ *
+ * Chaque tâche remplit son propre morceau : rien n'est partagé pendant
+ * les parties, les morceaux sont additionnés une fois le lot fini.
+ */
+typedef struct {
+    const ConfigurationSimulation *configs[2];
+    int nbConfigs;
+    unsigned long long graine;
+    long debut;
+    long fin;
+    ResultatSimulation resultats[2];
+    Echantillon ecarts;   // Score de configs[0] moins celui de configs[1]
+} MorceauLot;
+
+/**
+ * \brief Donne les paramètres par défaut d'une simulation
+ *
+ * Lots de 1000 parties, au moins 2000 et au plus 1000000 parties,
+ * taux de victoires à 1 point près et score moyen à 5 points près,
+ * intervalles à 95 %, graine 1, un fil par cœur.
+ *
+ * \param[out] parametres Les paramètres à remplir
+ */
+void parametresSimulationDefaut(ParametresSimulation *parametres){
+    parametres->tailleLot = 1000;
+    parametres->nbPartiesMin = 2000;
+    parametres->nbPartiesMax = 1000000;
+    parametres->precisionVictoires = 0.01;
+    parametres->precisionScore = 5.0;
+    parametres->z = 1.96;
+    parametres->graine = 1;
+    parametres->nbFils = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Cherche une stratégie par son nom
+ *
+ * \param[in] nom "aleatoire", "frequence" (contre l'arme la plus jouée
+ * par les monstres), "motif" (contre l'arme qui a le plus souvent suivi
+ * la dernière), "pierre", "feuille" ou "ciseaux"
+ * \return La stratégie, ou NULL si le nom est inconnu
+ */
+const StrategieSimulation *trouverStrategie(const char *nom){
+    for (int i = 0; i < NB_STRATEGIES; i++) {
+        if (strcmp(strategies[i].nom, nom) == 0) {
+            return &strategies[i];
+        }
+    }
+    return NULL;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Donne toutes les stratégies connues
+ *
+ * \param[out] nbStrategies Le nombre de stratégies
+ * \return Le tableau des stratégies, dans l'ordre de \c trouverStrategie
+ */
+const StrategieSimulation *listeStrategies(int *nbStrategies){
+    *nbStrategies = NB_STRATEGIES;
+    return strategies;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Lit les vagues d'une configuration
+ *
+ * \param[out] config La configuration
+ * \param[in] fichier Le fichier de monstres : un nom du dossier des données
+ * (voir \c cheminDonnees), ou un chemin s'il contient un '/'
+ * \param[in] strategie La stratégie du chevalier
+ */
+void chargerConfiguration(ConfigurationSimulation *config, const char *fichier, const StrategieSimulation *strategie){
+    config->fichier = fichier;
+    config->strategie = strategie;
+    config->vague1 = creerPile();
+    config->vague2 = creerFileMonstre();
+
+    char *chemin = (strchr(fichier, '/') != NULL) ? NULL : cheminDonnees(fichier);
+    lireMonstresFichier((chemin != NULL) ? chemin : fichier, &config->vague1, &config->vague2);
+    if (chemin != NULL) {
+        libererMemoire(MEMOIRE_TAMPONS, chemin);
+    }
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère les vagues d'une configuration
+ *
+ * \param[in,out] config La configuration
+ */
+void libererConfiguration(ConfigurationSimulation *config){
+    libererVague1(config->vague1);
+    libererVague2(config->vague2);
+    config->vague1 = creerPile();
+    config->vague2 = creerFileMonstre();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Joue une partie simulée, sans affichage
+ *
+ * Les graines du joueur et des monstres ne dépendent que de \c graine
+ * et de \c numero : la partie \c numero de deux configurations est
+ * jouée avec les mêmes nombres aléatoires, ce qui réduit la variance
+ * de leur différence.
+ *
+ * \param[in] config La configuration
+ * \param[in] graine La graine de la simulation
+ * \param[in] numero Le numéro de la partie
+ * \param[out] victoire true si le joueur a vaincu les deux vagues
+ * \return Le score de la partie
+ */
+int jouerPartieSimulee(const ConfigurationSimulation *config, unsigned long long graine, long numero, Bool *victoire){
+    // La partie n prend les tirages 2n et 2n + 1 de la suite de la graine : les parties ne partagent aucun tirage
+    Aleatoire aleatoire;
+    initialiserAleatoire(&aleatoire, graine + 2ULL * (unsigned long long)numero * PAS_ALEATOIRE);
+    EtatStrategie etat = {0};
+    etat.graine = (unsigned int)tirerAleatoire(&aleatoire);
+    etat.derniereArme = -1;
+    unsigned int graineMonstres = (unsigned int)tirerAleatoire(&aleatoire);
+
+    Combattant joueur = creerCombattant(config->strategie->nom);
+    joueur.choisirArme = config->strategie->choisirArme;
+    joueur.observerArme = config->strategie->observerArme;
+    joueur.etatArme = &etat;
+    joueur.graineMonstres = &graineMonstres;
+    joueur.muet = true;
+    int score = jouerPartie(&joueur, copierVague1(config->vague1), copierVague2(config->vague2));
+    *victoire = joueur.pv > 0;
+    return score;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Ajoute une valeur à un échantillon
+ *
+ * \param[in,out] echantillon L'échantillon
+ * \param[in] valeur La valeur
+ */
+void ajouterValeur(Echantillon *echantillon, long long valeur){
+    echantillon->nb++;
+    echantillon->somme += valeur;
+    echantillon->sommeCarres += valeur * valeur;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Ajoute un échantillon à un autre
+ *
+ * \param[in,out] total L'échantillon complété
+ * \param[in] partiel L'échantillon ajouté
+ */
+void fusionnerEchantillons(Echantillon *total, const Echantillon *partiel){
+    total->nb += partiel->nb;
+    total->somme += partiel->somme;
+    total->sommeCarres += partiel->sommeCarres;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Moyenne d'un échantillon
+ *
+ * \param[in] echantillon L'échantillon
+ * \return La moyenne, 0 si l'échantillon est vide
+ */
+double moyenneEchantillon(const Echantillon *echantillon){
+    return (echantillon->nb > 0) ? (double)echantillon->somme / echantillon->nb : 0.0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Demi-largeur de l'intervalle de confiance de la moyenne
+ *
+ * Approximation normale : z fois l'écart-type de l'échantillon divisé
+ * par la racine du nombre de valeurs.
+ *
+ * \param[in] echantillon L'échantillon
+ * \param[in] z Le quantile de la loi normale
+ * \return La demi-largeur, infinie avec moins de deux valeurs
+ */
+double demiLargeurMoyenne(const Echantillon *echantillon, double z){
+    if (echantillon->nb < 2) {
+        return HUGE_VAL;
+    }
+    // En long double : la somme des carrés et le carré de la somme sont proches
+    long double n = echantillon->nb;
+    long double somme = echantillon->somme;
+    long double variance = ((long double)echantillon->sommeCarres - somme * somme / n) / (n - 1);
+    if (variance < 0) {
+        variance = 0;
+    }
+    return z * sqrt((double)(variance / n));
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Intervalle de confiance d'un taux de victoires (intervalle de Wilson)
+ *
+ * Contrairement à l'approximation normale, il reste dans [0, 1] et ne
+ * se réduit pas à un point quand toutes les parties sont gagnées ou perdues.
+ *
+ * \param[in] nbVictoires Le nombre de victoires
+ * \param[in] nbParties Le nombre de parties
+ * \param[in] z Le quantile de la loi normale
+ * \param[out] bas La borne basse
+ * \param[out] haut La borne haute
+ */
+void intervalleVictoires(long nbVictoires, long nbParties, double z, double *bas, double *haut){
+    if (nbParties == 0) {
+        *bas = 0.0;
+        *haut = 1.0;
+        return;
+    }
+    double n = nbParties;
+    double p = nbVictoires / n;
+    double z2 = z * z;
+    double diviseur = 1.0 + z2 / n;
+    double centre = (p + z2 / (2.0 * n)) / diviseur;
+    double demiLargeur = z * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / diviseur;
+    *bas = (centre - demiLargeur < 0.0) ? 0.0 : centre - demiLargeur;
+    *haut = (centre + demiLargeur > 1.0) ? 1.0 : centre + demiLargeur;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Tâche du pool : joue les parties d'un morceau de lot et les compte dans le morceau */
+static void jouerMorceau(void *argument){
+    MorceauLot *morceau = (MorceauLot *)argument;
+    // Compté dans des variables locales : les morceaux voisins ne partagent pas de ligne de cache pendant les parties
+    ResultatSimulation resultats[2];
+    Echantillon ecarts = {0};
+    memset(resultats, 0, sizeof(resultats));
+
+    for (long numero = morceau->debut; numero < morceau->fin; numero++) {
+        int scores[2];
+        for (int i = 0; i < morceau->nbConfigs; i++) {
+            Bool victoire;
+            scores[i] = jouerPartieSimulee(morceau->configs[i], morceau->graine, numero, &victoire);
+            ajouterValeur(&resultats[i].scores, scores[i]);
+            resultats[i].nbVictoires += victoire;
+        }
+        if (morceau->nbConfigs == 2) {
+            ajouterValeur(&ecarts, scores[0] - scores[1]);
+        }
+    }
+    morceau->resultats[0] = resultats[0];
+    morceau->resultats[1] = resultats[1];
+    morceau->ecarts = ecarts;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Joue les parties [debut, debut + nbParties) des configurations, un morceau par fil, et ajoute leurs résultats */
+static void jouerLot(PoolThreads *pool, const ConfigurationSimulation *configs[2], int nbConfigs, unsigned long long graine,
+                     long debut, long nbParties, ResultatSimulation resultats[2], Echantillon *ecarts){
+    int nbMorceaux = pool->nbFils;
+    MorceauLot *morceaux = (MorceauLot *)allouerMemoire(MEMOIRE_TAMPONS, nbMorceaux * sizeof(MorceauLot));
+    if (morceaux == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < nbMorceaux; i++) {
+        morceaux[i].configs[0] = configs[0];
+        morceaux[i].configs[1] = configs[1];
+        morceaux[i].nbConfigs = nbConfigs;
+        morceaux[i].graine = graine;
+        morceaux[i].debut = debut + nbParties * i / nbMorceaux;
+        morceaux[i].fin = debut + nbParties * (i + 1) / nbMorceaux;
+        soumettreTache(pool, jouerMorceau, &morceaux[i]);
+    }
+    attendreTaches(pool);
+
+    for (int i = 0; i < nbMorceaux; i++) {
+        for (int c = 0; c < nbConfigs; c++) {
+            fusionnerEchantillons(&resultats[c].scores, &morceaux[i].resultats[c].scores);
+            resultats[c].nbVictoires += morceaux[i].resultats[c].nbVictoires;
+        }
+        fusionnerEchantillons(ecarts, &morceaux[i].ecarts);
+    }
+    libererMemoire(MEMOIRE_TAMPONS, morceaux);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/* Vrai si le taux de victoires et le score moyen sont connus à la précision demandée */
+static Bool assezPrecis(const ResultatSimulation *resultat, const ParametresSimulation *parametres){
+    double bas, haut;
+    intervalleVictoires(resultat->nbVictoires, resultat->scores.nb, parametres->z, &bas, &haut);
+    return (haut - bas) / 2.0 <= parametres->precisionVictoires
+        && demiLargeurMoyenne(&resultat->scores, parametres->z) <= parametres->precisionScore;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Simule une configuration jusqu'à la précision demandée
+ *
+ * Les parties 0, 1, 2... sont jouées par lots en parallèle. Après
+ * chaque lot, la simulation s'arrête dès que le taux de victoires et
+ * le score moyen sont connus à la précision demandée. Le nombre de
+ * parties jouées ne dépend pas du nombre de fils.
+ *
+ * \param[in] config La configuration
+ * \param[in] parametres Les paramètres de la simulation
+ * \param[out] resultat Les scores et victoires des parties jouées
+ */
+void simulerConfiguration(const ConfigurationSimulation *config, const ParametresSimulation *parametres, ResultatSimulation *resultat){
+    const ConfigurationSimulation *configs[2] = {config, NULL};
+    ResultatSimulation resultats[2];
+    Echantillon ecarts = {0};
+    memset(resultats, 0, sizeof(resultats));
+    PoolThreads *pool = creerPool(parametres->nbFils);
+
+    long nbParties = 0;
+    while (nbParties < parametres->nbPartiesMax) {
+        long lot = parametres->nbPartiesMax - nbParties;
+        if (lot > parametres->tailleLot) lot = parametres->tailleLot;
+        jouerLot(pool, configs, 1, parametres->graine, nbParties, lot, resultats, &ecarts);
+        nbParties += lot;
+        if (nbParties >= parametres->nbPartiesMin && assezPrecis(&resultats[0], parametres)) {
+            break;
+        }
+    }
+
+    detruirePool(pool);
+    *resultat = resultats[0];
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Compare deux configurations sur les mêmes parties
+ *
+ * La partie n de \c a et celle de \c b sont jouées avec les mêmes
+ * graines, et c'est l'écart de leurs scores qui est mesuré. Après
+ * chaque lot, la comparaison s'arrête dès que l'intervalle de l'écart
+ * moyen exclut 0 (la différence est montrée) ou est plus étroit que
+ * \c precisionScore (s'il y a une différence, elle est plus petite).
+ *
+ * Les intervalles sont regardés après chaque lot : avec beaucoup de
+ * lots, une différence nulle peut être montrée plus souvent que le
+ * niveau de confiance ne le laisse croire ; un \c z plus grand le compense.
+ *
+ * \param[in] a La première configuration
+ * \param[in] b La seconde configuration
+ * \param[in] parametres Les paramètres de la simulation
+ * \param[out] comparaison Les résultats des deux configurations et leur verdict
+ */
+void comparerConfigurations(const ConfigurationSimulation *a, const ConfigurationSimulation *b, const ParametresSimulation *parametres, ComparaisonSimulation *comparaison){
+    const ConfigurationSimulation *configs[2] = {a, b};
+    ResultatSimulation resultats[2];
+    Echantillon ecarts = {0};
+    memset(resultats, 0, sizeof(resultats));
+    PoolThreads *pool = creerPool(parametres->nbFils);
+
+    long nbParties = 0;
+    double moyenne = 0.0, demiLargeur = HUGE_VAL;
+    while (nbParties < parametres->nbPartiesMax) {
+        long lot = parametres->nbPartiesMax - nbParties;
+        if (lot > parametres->tailleLot) lot = parametres->tailleLot;
+        jouerLot(pool, configs, 2, parametres->graine, nbParties, lot, resultats, &ecarts);
+        nbParties += lot;
+
+        moyenne = moyenneEchantillon(&ecarts);
+        demiLargeur = demiLargeurMoyenne(&ecarts, parametres->z);
+        if (nbParties >= parametres->nbPartiesMin && (fabs(moyenne) > demiLargeur || demiLargeur <= parametres->precisionScore)) {
+            break;
+        }
+    }
+
+    detruirePool(pool);
+    comparaison->a = resultats[0];
+    comparaison->b = resultats[1];
+    comparaison->ecarts = ecarts;
+    comparaison->verdict = (fabs(moyenne) > demiLargeur) ? ((moyenne > 0) ? 1 : -1) : 0;
+}
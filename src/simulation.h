@@ -0,0 +1,297 @@
+/**
+ * \file simulation.h
+ * \brief En-tête pour le fichier simulation.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+    #include "jeu.h"
+    #include "generateur.h"
+    #include "parallele.h"
+
+    /**
+     * \struct EtatStrategie
+     * \brief Ce qu'un chevalier simulé sait de la partie en cours.
+     *
+     * C'est l'\c etatArme du \c Combattant simulé. Seules les armes
+     * Pierre, Feuille et Ciseaux des monstres sont comptées : les deux
+     * autres ne se contrent pas.
+     */
+    typedef struct {
+        unsigned int graine;      // Premier champ : armeAleatoire reçoit l'état comme une graine de rand_r
+        int derniereArme;         // Dernière arme comptée du monstre, -1 s'il n'y en a pas
+        int frequences[3];        // Nombre de fois où les monstres ont joué chaque arme
+        int suites[3][3];         // suites[a][b] : nombre de fois où b a suivi a
+    } EtatStrategie;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct StrategieSimulation
+     * \brief Façon de choisir ses armes d'un chevalier simulé.
+     *
+     * \c choisirArme et \c observerArme reçoivent un \c EtatStrategie
+     * comme \c etatArme d'un \c Combattant ; \c observerArme vaut NULL
+     * pour les stratégies qui ne regardent pas les monstres.
+     */
+    typedef struct {
+        const char *nom;
+        int (*choisirArme)(void *etatArme);
+        void (*observerArme)(void *etatArme, int armeMonstre);
+    } StrategieSimulation;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ConfigurationSimulation
+     * \brief Fichier de monstres et stratégie du chevalier à évaluer.
+     *
+     * Les vagues sont lues une fois et servent de modèles : chaque partie
+     * en joue une copie.
+     */
+    typedef struct {
+        const char *fichier;
+        const StrategieSimulation *strategie;
+        PileMonstre vague1;
+        FileMonstre vague2;
+    } ConfigurationSimulation;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct Echantillon
+     * \brief Valeurs entières résumées par leur nombre, leur somme et la somme de leurs carrés.
+     *
+     * Les sommes sont exactes : des échantillons fusionnés dans n'importe
+     * quel ordre donnent la même moyenne et la même variance.
+     */
+    typedef struct {
+        long nb;
+        long long somme;
+        long long sommeCarres;
+    } Echantillon;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ResultatSimulation
+     * \brief Scores et victoires des parties simulées d'une configuration.
+     */
+    typedef struct {
+        Echantillon scores;
+        long nbVictoires;
+    } ResultatSimulation;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ComparaisonSimulation
+     * \brief Résultat de deux configurations jouées sur les mêmes graines.
+     *
+     * \c ecarts contient, partie par partie, le score de \c a moins celui de \c b.
+     */
+    typedef struct {
+        ResultatSimulation a;
+        ResultatSimulation b;
+        Echantillon ecarts;
+        int verdict;   // 1 : a marque plus, -1 : b marque plus, 0 : pas de différence montrée
+    } ComparaisonSimulation;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ParametresSimulation
+     * \brief Quand arrêter une simulation.
+     *
+     * Les parties sont jouées par lots de \c tailleLot ; après chaque lot
+     * (et au moins \c nbPartiesMin parties), la simulation s'arrête si les
+     * intervalles de confiance sont assez étroits, et au plus tard après
+     * \c nbPartiesMax parties.
+     */
+    typedef struct {
+        int tailleLot;
+        long nbPartiesMin;
+        long nbPartiesMax;
+        double precisionVictoires;   // Demi-largeur voulue pour le taux de victoires (0.01 : à 1 point près)
+        double precisionScore;       // Demi-largeur voulue pour le score moyen, en points
+        double z;                    // Quantile de la loi normale : 1.96 pour des intervalles à 95 %
+        unsigned long long graine;
+        int nbFils;                  // 0 : un fil par cœur
+    } ParametresSimulation;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne les paramètres par défaut d'une simulation
+     *
+     * Lots de 1000 parties, au moins 2000 et au plus 1000000 parties,
+     * taux de victoires à 1 point près et score moyen à 5 points près,
+     * intervalles à 95 %, graine 1, un fil par cœur.
+     *
+     * \param[out] parametres Les paramètres à remplir
+     */
+    void parametresSimulationDefaut(ParametresSimulation *parametres);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Cherche une stratégie par son nom
+     *
+     * \param[in] nom "aleatoire", "frequence" (contre l'arme la plus jouée
+     * par les monstres), "motif" (contre l'arme qui a le plus souvent suivi
+     * la dernière), "pierre", "feuille" ou "ciseaux"
+     * \return La stratégie, ou NULL si le nom est inconnu
+     */
+    const StrategieSimulation *trouverStrategie(const char *nom);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Donne toutes les stratégies connues
+     *
+     * \param[out] nbStrategies Le nombre de stratégies
+     * \return Le tableau des stratégies, dans l'ordre de \c trouverStrategie
+     */
+    const StrategieSimulation *listeStrategies(int *nbStrategies);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Lit les vagues d'une configuration
+     *
+     * \param[out] config La configuration
+     * \param[in] fichier Le fichier de monstres : un nom du dossier des données
+     * (voir \c cheminDonnees), ou un chemin s'il contient un '/'
+     * \param[in] strategie La stratégie du chevalier
+     */
+    void chargerConfiguration(ConfigurationSimulation *config, const char *fichier, const StrategieSimulation *strategie);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère les vagues d'une configuration
+     *
+     * \param[in,out] config La configuration
+     */
+    void libererConfiguration(ConfigurationSimulation *config);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Joue une partie simulée, sans affichage
+     *
+     * Les graines du joueur et des monstres ne dépendent que de \c graine
+     * et de \c numero : la partie \c numero de deux configurations est
+     * jouée avec les mêmes nombres aléatoires, ce qui réduit la variance
+     * de leur différence.
+     *
+     * \param[in] config La configuration
+     * \param[in] graine La graine de la simulation
+     * \param[in] numero Le numéro de la partie
+     * \param[out] victoire true si le joueur a vaincu les deux vagues
+     * \return Le score de la partie
+     */
+    int jouerPartieSimulee(const ConfigurationSimulation *config, unsigned long long graine, long numero, Bool *victoire);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Ajoute une valeur à un échantillon
+     *
+     * \param[in,out] echantillon L'échantillon
+     * \param[in] valeur La valeur
+     */
+    void ajouterValeur(Echantillon *echantillon, long long valeur);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Ajoute un échantillon à un autre
+     *
+     * \param[in,out] total L'échantillon complété
+     * \param[in] partiel L'échantillon ajouté
+     */
+    void fusionnerEchantillons(Echantillon *total, const Echantillon *partiel);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Moyenne d'un échantillon
+     *
+     * \param[in] echantillon L'échantillon
+     * \return La moyenne, 0 si l'échantillon est vide
+     */
+    double moyenneEchantillon(const Echantillon *echantillon);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Demi-largeur de l'intervalle de confiance de la moyenne
+     *
+     * Approximation normale : z fois l'écart-type de l'échantillon divisé
+     * par la racine du nombre de valeurs.
+     *
+     * \param[in] echantillon L'échantillon
+     * \param[in] z Le quantile de la loi normale
+     * \return La demi-largeur, infinie avec moins de deux valeurs
+     */
+    double demiLargeurMoyenne(const Echantillon *echantillon, double z);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Intervalle de confiance d'un taux de victoires (intervalle de Wilson)
+     *
+     * Contrairement à l'approximation normale, il reste dans [0, 1] et ne
+     * se réduit pas à un point quand toutes les parties sont gagnées ou perdues.
+     *
+     * \param[in] nbVictoires Le nombre de victoires
+     * \param[in] nbParties Le nombre de parties
+     * \param[in] z Le quantile de la loi normale
+     * \param[out] bas La borne basse
+     * \param[out] haut La borne haute
+     */
+    void intervalleVictoires(long nbVictoires, long nbParties, double z, double *bas, double *haut);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Simule une configuration jusqu'à la précision demandée
+     *
+     * Les parties 0, 1, 2... sont jouées par lots en parallèle. Après
+     * chaque lot, la simulation s'arrête dès que le taux de victoires et
+     * le score moyen sont connus à la précision demandée. Le nombre de
+     * parties jouées ne dépend pas du nombre de fils.
+     *
+     * \param[in] config La configuration
+     * \param[in] parametres Les paramètres de la simulation
+     * \param[out] resultat Les scores et victoires des parties jouées
+     */
+    void simulerConfiguration(const ConfigurationSimulation *config, const ParametresSimulation *parametres, ResultatSimulation *resultat);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Compare deux configurations sur les mêmes parties
+     *
+     * La partie n de \c a et celle de \c b sont jouées avec les mêmes
+     * graines, et c'est l'écart de leurs scores qui est mesuré. Après
+     * chaque lot, la comparaison s'arrête dès que l'intervalle de l'écart
+     * moyen exclut 0 (la différence est montrée) ou est plus étroit que
+     * \c precisionScore (s'il y a une différence, elle est plus petite).
+     *
+     * Les intervalles sont regardés après chaque lot : avec beaucoup de
+     * lots, une différence nulle peut être montrée plus souvent que le
+     * niveau de confiance ne le laisse croire ; un \c z plus grand le compense.
+     *
+     * \param[in] a La première configuration
+     * \param[in] b La seconde configuration
+     * \param[in] parametres Les paramètres de la simulation
+     * \param[out] comparaison Les résultats des deux configurations et leur verdict
+     */
+    void comparerConfigurations(const ConfigurationSimulation *a, const ConfigurationSimulation *b, const ParametresSimulation *parametres, ComparaisonSimulation *comparaison);
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * \file tournoi.c
+ * \brief Tournoi des stratégies contre les fichiers de monstres, exécuté par vol de travail
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+#include "tournoi.h"
+#include "instrumentation.h"
+
+#include <math.h>
+
+/* Ce que les travaux d'un tournoi partagent : les configurations des cases et une case de résultats par travail */
+typedef struct {
+    const Tournoi *tournoi;
+    ConfigurationSimulation *configs;   // Une par case
+    unsigned long long *graines;        // Une par case : la même pour toutes les stratégies d'un fichier
+    long travauxParCase;
+    ResultatSimulation *resultats;      // Un par travail
+} TravauxTournoi;
+
+/* Travail du tournoi : un morceau des parties d'une case */
+static void jouerTravailTournoi(long indice, int fil, void *contexte){
+    TravauxTournoi *travaux = (TravauxTournoi *)contexte;
+    const Tournoi *tournoi = travaux->tournoi;
+    long numeroCase = indice / travaux->travauxParCase;
+    long debut = (indice % travaux->travauxParCase) * tournoi->partiesParTravail;
+    long fin = debut + tournoi->partiesParTravail;
+    if (fin > tournoi->partiesParCase) fin = tournoi->partiesParCase;
+
+    ResultatSimulation resultat = {{0, 0, 0}, 0};
+    for (long numero = debut; numero < fin; numero++) {
+        Bool victoire;
+        ajouterValeur(&resultat.scores, jouerPartieSimulee(&travaux->configs[numeroCase], travaux->graines[numeroCase], numero, &victoire));
+        resultat.nbVictoires += victoire;
+    }
+    travaux->resultats[indice] = resultat;
+}
+
+/* Ordre du classement : score moyen décroissant */
+static int comparerClassements(const void *a, const void *b){
+    double scoreA = ((const ClassementStrategie *)a)->scoreMoyen;
+    double scoreB = ((const ClassementStrategie *)b)->scoreMoyen;
+    return (scoreA < scoreB) - (scoreA > scoreB);
+}
+
+/**
+ * \brief Prépare un tournoi de toutes les stratégies connues
+ *
+ * \param[out] tournoi Le tournoi
+ * \param[in] vagues Les fichiers de monstres, déjà lus (ils doivent durer autant que le tournoi)
+ * \param[in] nbFichiers Le nombre de fichiers
+ * \param[in] partiesParCase Le nombre de parties de chaque stratégie contre chaque fichier
+ */
+void initialiserTournoi(Tournoi *tournoi, const ConfigurationSimulation *vagues, int nbFichiers, long partiesParCase){
+    tournoi->strategies = listeStrategies(&tournoi->nbStrategies);
+    tournoi->nbFichiers = nbFichiers;
+    tournoi->vagues = vagues;
+    tournoi->partiesParCase = partiesParCase;
+    tournoi->partiesParTravail = 250;
+    tournoi->graine = 1;
+    tournoi->nbFils = 0;
+    tournoi->cases = NULL;
+    tournoi->nbTravaux = 0;
+    tournoi->nbVols = 0;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Joue toutes les parties du tournoi
+ *
+ * Chaque travail compte ses parties dans sa propre case de résultats :
+ * les fils ne partagent rien pendant le tournoi, les cases sont
+ * additionnées à la fin.
+ *
+ * \param[in,out] tournoi Le tournoi
+ * \param[out] travauxParFil Le nombre de travaux exécutés par chaque fil, ou NULL
+ */
+void jouerTournoi(Tournoi *tournoi, long *travauxParFil){
+    int nbCases = tournoi->nbStrategies * tournoi->nbFichiers;
+    TravauxTournoi travaux;
+    travaux.tournoi = tournoi;
+    travaux.travauxParCase = (tournoi->partiesParCase + tournoi->partiesParTravail - 1) / tournoi->partiesParTravail;
+    tournoi->nbTravaux = nbCases * travaux.travauxParCase;
+
+    travaux.configs = (ConfigurationSimulation *)allouerMemoire(MEMOIRE_TAMPONS, nbCases * sizeof(ConfigurationSimulation));
+    travaux.graines = (unsigned long long *)allouerMemoire(MEMOIRE_TAMPONS, nbCases * sizeof(unsigned long long));
+    travaux.resultats = (ResultatSimulation *)allouerMemoire(MEMOIRE_TAMPONS, tournoi->nbTravaux * sizeof(ResultatSimulation));
+    libererMemoire(MEMOIRE_TAMPONS, tournoi->cases);
+    tournoi->cases = (ResultatSimulation *)allouerMemoire(MEMOIRE_TAMPONS, nbCases * sizeof(ResultatSimulation));
+    if (travaux.configs == NULL || travaux.graines == NULL || travaux.resultats == NULL || tournoi->cases == NULL) {
+        perror("Erreur d'allocation mémoire");
+        exit(EXIT_FAILURE);
+    }
+    // Les cases partagent les vagues lues une fois : chaque partie n'en lit que des copies.
+    // Les stratégies jouent les mêmes parties d'un fichier, les fichiers des parties indépendantes
+    Aleatoire aleatoire;
+    initialiserAleatoire(&aleatoire, tournoi->graine);
+    for (int f = 0; f < tournoi->nbFichiers; f++) {
+        unsigned long long graineFichier = tirerAleatoire(&aleatoire);
+        for (int s = 0; s < tournoi->nbStrategies; s++) {
+            travaux.configs[s * tournoi->nbFichiers + f] = tournoi->vagues[f];
+            travaux.configs[s * tournoi->nbFichiers + f].strategie = &tournoi->strategies[s];
+            travaux.graines[s * tournoi->nbFichiers + f] = graineFichier;
+        }
+    }
+
+    tournoi->nbVols = executerTravaux(tournoi->nbFils, tournoi->nbTravaux, jouerTravailTournoi, &travaux, travauxParFil);
+
+    memset(tournoi->cases, 0, nbCases * sizeof(ResultatSimulation));
+    for (long i = 0; i < tournoi->nbTravaux; i++) {
+        ResultatSimulation *resultat = &tournoi->cases[i / travaux.travauxParCase];
+        fusionnerEchantillons(&resultat->scores, &travaux.resultats[i].scores);
+        resultat->nbVictoires += travaux.resultats[i].nbVictoires;
+    }
+    libererMemoire(MEMOIRE_TAMPONS, travaux.resultats);
+    libererMemoire(MEMOIRE_TAMPONS, travaux.graines);
+    libererMemoire(MEMOIRE_TAMPONS, travaux.configs);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Classe les stratégies par score moyen décroissant
+ *
+ * \param[in] tournoi Le tournoi joué
+ * \param[in] z Le quantile de la loi normale des intervalles
+ * \param[out] classement Tableau d'au moins \c nbStrategies cases
+ */
+void classerStrategies(const Tournoi *tournoi, double z, ClassementStrategie *classement){
+    for (int s = 0; s < tournoi->nbStrategies; s++) {
+        ClassementStrategie *ligne = &classement[s];
+        double sommeMoyennes = 0.0, sommeCarresDemiLargeurs = 0.0;
+        ligne->strategie = &tournoi->strategies[s];
+        ligne->nbVictoires = 0;
+        ligne->nbParties = 0;
+        for (int f = 0; f < tournoi->nbFichiers; f++) {
+            const ResultatSimulation *resultat = &tournoi->cases[s * tournoi->nbFichiers + f];
+            double demiLargeur = demiLargeurMoyenne(&resultat->scores, z);
+            sommeMoyennes += moyenneEchantillon(&resultat->scores);
+            sommeCarresDemiLargeurs += demiLargeur * demiLargeur;
+            ligne->nbVictoires += resultat->nbVictoires;
+            ligne->nbParties += resultat->scores.nb;
+        }
+        // Les fichiers sont indépendants : les variances des moyennes par fichier s'additionnent
+        ligne->scoreMoyen = sommeMoyennes / tournoi->nbFichiers;
+        ligne->demiLargeurScore = sqrt(sommeCarresDemiLargeurs) / tournoi->nbFichiers;
+    }
+    qsort(classement, tournoi->nbStrategies, sizeof(ClassementStrategie), comparerClassements);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Libère les résultats d'un tournoi
+ *
+ * \param[in,out] tournoi Le tournoi
+ */
+void libererTournoi(Tournoi *tournoi){
+    libererMemoire(MEMOIRE_TAMPONS, tournoi->cases);
+    tournoi->cases = NULL;
+}
@@ -0,0 +1,100 @@
+/**
+ * \file tournoi.h
+ * \brief En-tête pour le fichier tournoi.c
+ * \author Delinac Inès
+ * \date 18/10/2026
+ */
+
+#ifndef TOURNOI_H
+#define TOURNOI_H
+
+    #include "simulation.h"
+
+    /**
+     * \struct Tournoi
+     * \brief Toutes les stratégies jouées contre tous les fichiers de monstres.
+     *
+     * La case (s, f) contient les \c partiesParCase parties de la stratégie
+     * s contre le fichier f. Les stratégies jouent les parties d'un fichier
+     * avec les mêmes graines (chaque fichier a les siennes, tirées de
+     * \c graine). Chaque case est découpée en travaux de
+     * \c partiesParTravail parties, exécutés par vol de travail.
+     */
+    typedef struct {
+        int nbStrategies;
+        const StrategieSimulation *strategies;
+        int nbFichiers;
+        const ConfigurationSimulation *vagues;   // Une par fichier (sa stratégie n'est pas utilisée)
+        long partiesParCase;
+        long partiesParTravail;
+        unsigned long long graine;
+        int nbFils;                              // 0 : un fil par cœur
+        ResultatSimulation *cases;               // Rempli par jouerTournoi : case (s, f) en s * nbFichiers + f
+        long nbTravaux;
+        long nbVols;
+    } Tournoi;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \struct ClassementStrategie
+     * \brief Résultats d'une stratégie sur tous les fichiers du tournoi.
+     *
+     * Chaque fichier compte autant : le score moyen est la moyenne des
+     * scores moyens par fichier, et son intervalle combine ceux des fichiers.
+     */
+    typedef struct {
+        const StrategieSimulation *strategie;
+        double scoreMoyen;
+        double demiLargeurScore;
+        long nbVictoires;
+        long nbParties;
+    } ClassementStrategie;
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Prépare un tournoi de toutes les stratégies connues
+     *
+     * \param[out] tournoi Le tournoi
+     * \param[in] vagues Les fichiers de monstres, déjà lus (ils doivent durer autant que le tournoi)
+     * \param[in] nbFichiers Le nombre de fichiers
+     * \param[in] partiesParCase Le nombre de parties de chaque stratégie contre chaque fichier
+     */
+    void initialiserTournoi(Tournoi *tournoi, const ConfigurationSimulation *vagues, int nbFichiers, long partiesParCase);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Joue toutes les parties du tournoi
+     *
+     * Chaque travail compte ses parties dans sa propre case de résultats :
+     * les fils ne partagent rien pendant le tournoi, les cases sont
+     * additionnées à la fin.
+     *
+     * \param[in,out] tournoi Le tournoi
+     * \param[out] travauxParFil Le nombre de travaux exécutés par chaque fil, ou NULL
+     */
+    void jouerTournoi(Tournoi *tournoi, long *travauxParFil);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Classe les stratégies par score moyen décroissant
+     *
+     * \param[in] tournoi Le tournoi joué
+     * \param[in] z Le quantile de la loi normale des intervalles
+     * \param[out] classement Tableau d'au moins \c nbStrategies cases
+     */
+    void classerStrategies(const Tournoi *tournoi, double z, ClassementStrategie *classement);
+
+    /*---------------------------------------------------------------------------------------------------------------------------------*/
+
+    /**
+     * \brief Libère les résultats d'un tournoi
+     *
+     * \param[in,out] tournoi Le tournoi
+     */
+    void libererTournoi(Tournoi *tournoi);
+
+#endif